@@ -51,6 +51,7 @@ EXPORT CommandLineInterface::CommandLineInterface()
     m_pLogFile        = 0;
     m_TrapPrintEvents = false;
     m_pAgentSML       = 0 ;
+    m_pSourceOptions  = 0;
     m_VarPrint        = false;
     m_GPMax           = 20000;
     m_XMLResult       = new XMLTrace() ;
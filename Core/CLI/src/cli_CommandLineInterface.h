@@ -32,6 +32,7 @@
 #include <vector>
 
 typedef uint64_t epmem_time_id;
+typedef struct memory_pool_struct memory_pool;
 
 namespace soar_module
 {
@@ -203,6 +204,7 @@ namespace cli
             bool DoIndifferentSelection(const char pOp = 0, const std::string* p1 = 0, const std::string* p2 = 0, const std::string* p3 = 0);
             bool DoLoadLibrary(const std::string& libraryCommand);
             bool DoMatches(const eMatchesMode mode, const eWMEDetail detail = WME_DETAIL_NONE, const std::string* pProduction = 0);
+            bool DoMatchProfile(const std::string* pArgument = 0);
             bool DoMemories(const MemoriesBitset options, int n = 0, const std::string* pProduction = 0);
             bool DoMultiAttributes(const std::string* pAttribute = 0, int n = 0);
             bool DoNumericIndifferentMode(bool query, bool usesAvgNIM);
@@ -212,7 +214,7 @@ namespace cli
             bool DoPWatch(bool query = true, const std::string* pProduction = 0, bool setting = false);
             bool DoRemoveWME(uint64_t timetag);
             bool DoReplayInput(eReplayInputMode mode, std::string* pathname);
-            bool DoReteNet(bool save, std::string filename);
+            bool DoReteNet(eReteNetMode mode, std::string filename);
             bool DoSelect(const std::string* pOp = 0);
             bool DoSource(std::string filename, SourceBitset* pOptions = 0);
             bool DoTime(std::vector<std::string>& argv);
@@ -279,7 +281,7 @@ namespace cli
             void XMLResultToResponse(char const* pCommandName) ;
 
             void GetSystemStats(); // for stats
-            void GetMemoryStats(); // for stats
+            void GetMemoryStats(bool pProcess); // for stats
             void GetMaxStats(); // for stats
             void GetReteStats(); // for stats
             void GetAgentStats(); // for stats
@@ -297,6 +299,7 @@ namespace cli
 
             // stats, allocate
             void GetMemoryPoolStatistics();
+            void PrintMemoryPoolStatistics(const std::vector<memory_pool>& pPools);
 
             void PrintSourceSummary(int sourced, const std::list< std::string >& excised, int ignored);
             bool Source(const char* input, bool printFileStack = false);
@@ -323,6 +326,11 @@ namespace cli
             int                     m_NumTotalProductionsSourced;
             std::list<std::string>  m_TotalExcisedDuringSource;
             int                     m_NumTotalProductionsIgnored;
+            uint64_t                m_BulkStartNodesAdded;        // Kernel bulk-load counters when a "source --bulk" began
+            uint64_t                m_BulkStartNodesShared;
+            uint64_t                m_BulkStartSubtreesMatched;
+            uint64_t                m_BulkStartMatchUsec;
+            uint64_t                m_BulkLoadUsec;               // Wall time of the whole "source --bulk"
             cli::Parser             m_Parser;
             bool                    m_callbacks_were_enabled;
             bool                    m_console_was_enabled;
@@ -127,7 +127,7 @@ namespace cli
             }
             virtual const char* GetSyntax() const
             {
-                return "Syntax: debug [ allocate | internal-symbols | port | time | ? ] [arguments*]";
+                return "Syntax: debug [ allocate | internal-symbols | port | reclaim | time | ? ] [arguments*]";
             }
 
             virtual bool Parse(std::vector< std::string >& argv)
@@ -1575,6 +1575,7 @@ namespace cli
                     {'C', "cycle-csv",  OPTARG_NONE},
                     {'S', "sort",       OPTARG_REQUIRED},
                     {'a', "agent",      OPTARG_NONE},
+                    {'P', "process",    OPTARG_NONE},
                     {0, 0, OPTARG_NONE}
                 };
 
@@ -1638,6 +1639,10 @@ namespace cli
                         case 'a':
                             options.set(cli::STATS_AGENT);
                             break;
+                        case 'P':
+                            options.set(cli::STATS_MEMORY);
+                            options.set(cli::STATS_PROCESS);
+                            break;
                     }
                 }
 
@@ -152,6 +152,12 @@ bool CommandLineInterface::DoDebug(std::vector< std::string >* argv)
             thisAgent->symbolManager->print_internal_symbols();
             return true;
         }
+        else if (sub_command[0] == 'r')
+        {
+            size_t released = thisAgent->memoryManager->trim_memory_pools();
+            m_Result << released << " bytes of free memory pool blocks returned.";
+            return true;
+        }
         else if (sub_command[0] == 'p')
         {
 
@@ -175,6 +181,7 @@ bool CommandLineInterface::DoDebug(std::vector< std::string >* argv)
             PrintCLIMessage_Justify("allocate [pool blocks]", "Allocates extra memory to a memory pool", 70);
             PrintCLIMessage_Justify("internal-symbols", "Prints symbol table", 70);
             PrintCLIMessage_Justify("port", "Prints listening port", 70);
+            PrintCLIMessage_Justify("reclaim", "Returns wholly free memory pool blocks", 70);
             PrintCLIMessage_Justify("time <command> [args]", "Executes command and prints time spent", 70);
     //        PrintCLIMessage_Section("Debug Database Storage", 60);
     //        PrintCLIMessage_Item("database:", l_OutputManager->m_params->database, 60);
@@ -136,6 +136,15 @@ namespace cli
         REPLAY_INPUT_CLOSE,
     };
 
+    enum eReteNetMode
+    {
+        RETE_NET_SAVE,
+        RETE_NET_LOAD,
+        RETE_NET_SHARE,
+        RETE_NET_ATTACH,
+        RETE_NET_UNSHARE,
+    };
+
     enum eRunOptions
     {
         RUN_DECISION,
@@ -165,6 +174,7 @@ namespace cli
         SOURCE_ALL,
         SOURCE_DISABLE,
         SOURCE_VERBOSE,
+        SOURCE_BULK,
         SOURCE_NUM_OPTIONS,    // must be last
     };
     typedef std::bitset<SOURCE_NUM_OPTIONS> SourceBitset;
@@ -183,6 +193,7 @@ namespace cli
         STATS_DECISION,
         STATS_AGENT,
         STATS_EBC,
+        STATS_PROCESS,
         STATS_NUM_OPTIONS, // must be last
     };
     typedef std::bitset<STATS_NUM_OPTIONS> StatsBitset;
@@ -483,6 +483,7 @@ void initdocstrings()
 		"  allocate [pool blocks]         Allocates extra memory to a memory pool\n"
 		"  internal-symbols                                   Prints symbol table\n"
 		"  port                                             Prints listening port\n"
+		"  reclaim                        Returns wholly free memory pool blocks\n"
 		"  time <command> [args]           Executes command and prints time spent\n"
 		"\n"
 		"debug allocate\n"
@@ -505,6 +506,14 @@ void initdocstrings()
 		"Memory pool block size in this context is approximately 32 kilobytes, the exact\n"
 		"size determined during agent initialization.\n"
 		"\n"
+		"debug reclaim\n"
+		"\n"
+		"Memory pools grow as needed during a run but never shrink on their own, so\n"
+		"after a spike in working memory or substates an agent keeps its peak memory.\n"
+		"The reclaim command returns every pool block none of whose items is in use\n"
+		"and prints how many bytes were released. Init-soar does the same, and the\n"
+		"soar pool-trim-interval setting does it periodically during a run.\n"
+		"\n"
 		"debug internal-symbols\n"
 		"\n"
 		"The internal-symbols command prints information about the Soar symbol table.\n"
@@ -1528,11 +1537,12 @@ void initdocstrings()
 		"  load                            [? | help]\n"
 		"  ------------------------------------------------------------\n"
 		"  load file                       [--all --disable] <filename>\n"
-		"  load file                       [--verbose]     ]\n"
+		"  load file                       [--verbose --bulk]\n"
 		"  ------------------------------------------------------------\n"
 		"  load library                    <filename> <args...>\n"
 		"  ------------------------------------------------------------\n"
 		"  load rete-network               --load <filename>\n"
+		"  load rete-network               --attach <name>\n"
 		"  ------------------------------------------------------------\n"
 		"  load percepts                   --open <filename>\n"
 		"  load percepts                   --close\n"
@@ -1551,6 +1561,7 @@ void initdocstrings()
 		"Option        Description\n"
 		"filename      The file of Soar productions and commands to load.\n"
 		"-a, --all     Enable a summary for each file sourced\n"
+		"-b, --bulk    Match new rules against working memory once, at the end\n"
 		"-d, --disable Disable all summaries\n"
 		"-v, --verbose Print excised production names\n"
 		"\n"
@@ -1619,6 +1630,20 @@ void initdocstrings()
 		"Combining the -a and -v flags add excised production names to the output for\n"
 		"each file.\n"
 		"\n"
+		"Bulk Loading\n"
+		"\n"
+		"With the -b flag, rules are added to the Rete without being matched against\n"
+		"working memory.  The new parts of the network are matched together when the\n"
+		"source finishes, or before any command other than sp, gp or source runs.  This\n"
+		"is faster when many rules are loaded into an agent with a large working memory,\n"
+		"but the initial matches may be found in a different order.  The summary reports\n"
+		"how many Rete nodes were added and shared and how long the matching took:\n"
+		"\n"
+		"  agent> source big-agent.soar -b\n"
+		"  Total: 5000 productions sourced.\n"
+		"  Bulk load: 21408 rete nodes added, 3716 shared with existing rules. 612 new\n"
+		"  subtrees matched in 8.4 ms (211.3 ms total).\n"
+		"\n"
 		"load rete-network\n"
 		"\n"
 		"The load rete-network command loads a Rete net previously saved. The Rete net\n"
@@ -1627,6 +1652,8 @@ void initdocstrings()
 		"productions. This command provides a fast method of saving and loading\n"
 		"productions since a special format is used and no parsing is necessary. Rete-\n"
 		"net files are portable across platforms that support Soar.\n"
+		"Each section of a saved file carries a checksum; a truncated or corrupted file\n"
+		"is rejected before any productions are excised from the agent.\n"
 		"If the filename contains a suffix of .Z, then the file is compressed\n"
 		"automatically when it is saved and uncompressed when it is loaded. Compressed\n"
 		"files may not be portable to another platform if that platform does not support\n"
@@ -1635,6 +1662,12 @@ void initdocstrings()
 		"Usage:\n"
 		"\n"
 		"  load rete-network -l <filename>\n"
+		"  load rete-network --attach <name>\n"
+		"\n"
+		"With --attach, the agent's productions are replaced with those of a Rete net\n"
+		"another agent in the same process shared with 'save rete-network --share'.\n"
+		"Nothing is read from disk or parsed, so this is the fastest way to give many\n"
+		"agents the same rules. Each agent still builds its own copy of the net.\n"
 		"\n"
 		"load percepts\n"
 		"\n"
@@ -2216,6 +2249,7 @@ void initdocstrings()
 		"                                [--timetags --wmes]\n"
 		"  production matches            [--names --count  ] [--assertions ]\n"
 		"                                [--timetags --wmes] [--retractions]\n"
+		"  production matches            --profile [on | off | reset | count]\n"
 		"  ------------------------------------------------------------------\n"
 		"  production memory-usage       [options] [max]\n"
 		"  production memory-usage       <production_name>\n"
@@ -2435,6 +2469,7 @@ void initdocstrings()
 		"\n"
 		"  production matches [options] production_name\n"
 		"  production matches [options] -[a|r]\n"
+		"  production matches --profile [on | off | reset | count]\n"
 		"\n"
 		"Options:\n"
 		"\n"
@@ -2451,6 +2486,7 @@ void initdocstrings()
 		"                         the first failing condition.\n"
 		"-a, --assertions         List only productions about to fire.\n"
 		"-r, --retractions        List only productions about to retract.\n"
+		"-p, --profile            Control or print the rete profile (see below).\n"
 		"\n"
 		"Printing the match set\n"
 		"\n"
@@ -2479,6 +2515,18 @@ void initdocstrings()
 		"immediately after the first condition that failed to match -- temporarily\n"
 		"interrupting the printing of the production conditions themselves.\n"
 		"\n"
+		"Profiling the rete\n"
+		"\n"
+		"production matches --profile on starts counting, for every node of the rete,\n"
+		"its left and right activations, its null activations (activations that could\n"
+		"not produce a match because the node's other input was empty), the tokens it\n"
+		"created and the time spent in the node itself. --profile off stops profiling\n"
+		"and discards the figures; --profile reset clears them. While profiling is on,\n"
+		"production matches --profile [count] lists the count (default 20) productions\n"
+		"that account for the most rete time. The time of a node shared by several\n"
+		"productions is split evenly among them; the activation and token counts are\n"
+		"totals over all the nodes a production uses.\n"
+		"\n"
 		"Notes:\n"
 		"\n"
 		"When printing partial match information, some of the matches displayed by this\n"
@@ -2502,6 +2550,13 @@ void initdocstrings()
 		"\n"
 		"  production matches -t my*first*production\n"
 		"\n"
+		"This example profiles 1000 decision cycles and lists the 5 most expensive\n"
+		"productions.\n"
+		"\n"
+		"  production matches --profile on\n"
+		"  run 1000\n"
+		"  production matches --profile 5\n"
+		"\n"
 		"production memory-usage\n"
 		"\n"
 		"Print memory usage for partial matches.\n"
@@ -2972,6 +3027,8 @@ void initdocstrings()
 		"  save percepts                        [--close --flush]\n"
 		"  ------------------------------------------------------\n"
 		"  save rete-network                    --save <filename>\n"
+		"  save rete-network                    --share <name>\n"
+		"  save rete-network                    --unshare <name>\n"
 		"  ------------------------------------------------------\n"
 		"  For a detailed explanation of sub-commands:  help save\n"
 		"\n"
@@ -3004,6 +3061,14 @@ void initdocstrings()
 		"Usage:\n"
 		"\n"
 		"  save rete-network -s <filename>\n"
+		"  save rete-network --share <name>\n"
+		"  save rete-network --unshare <name>\n"
+		"\n"
+		"With --share, the Rete net is kept in memory under the given name instead of\n"
+		"being written to a file, and any agent in the same process can then load it\n"
+		"with 'load rete-network --attach <name>'. Sharing again under the same name\n"
+		"replaces the net; agents that already attached keep their productions.\n"
+		"--unshare frees the shared net.\n"
 		"\n"
 		"save percepts\n"
 		"\n"
@@ -3451,8 +3516,12 @@ void initdocstrings()
 		"  max-goal-depth                                   23    Halt at this goal stack depth\n"
 		"  max-nil-output-cycles                            15    Impasse after this many nil outputs\n"
 		"  max-dc-time                                       0    Interrupt after this much time\n"
-		"  max-memory-usage                          100000000    Threshold for memory warning\n"
+		"  max-memory-usage                                  0    Halt if agent memory exceeds this\n"
+		"  huge-pages          [ OFF | transparent | explicit ]    Back pools with node-local huge pages\n"
 		"  max-gp                                        20000    Max rules gp can generate\n"
+		"  match-threads                                     1    Threads for alpha lookups of large WM batches\n"
+		"  match-batching                         [ on | OFF ]    Add large WM batches grouped by alpha memory\n"
+		"  pool-trim-interval                                0    Return free pool blocks every n decisions\n"
 		"  stop-phase   [input|proposal|decision|APPLY|output]    Phase before which Soar will stop\n"
 		"  tcl                                    [ on | OFF ]    Allow Tcl code in commands\n"
 		"  timers                                 [ ON | off ]    Profile Soar\n"
@@ -3525,9 +3594,13 @@ void initdocstrings()
 		"max-dc-time           >= 0         0\n"
 		"max-elaborations      > 0          100\n"
 		"max-goal-depth        > 0          23\n"
+		"huge-pages            off, transparent, explicit off\n"
 		"max-gp                > 0          20000\n"
-		"max-memory-usage      > 0          100000000\n"
+		"max-memory-usage      >= 0         0\n"
 		"max-nil-output-cycles > 0          15\n"
+		"match-threads         > 0          1\n"
+		"match-batching        on or off    off\n"
+		"pool-trim-interval    >= 0         0\n"
 		"stop-phase                         apply\n"
 		"tcl                   on or off    off\n"
 		"timers                on or off    on\n"
@@ -3590,13 +3663,13 @@ void initdocstrings()
 		"\n"
 		"soar max-memory-usage\n"
 		"\n"
-		"The max-memory-usage setting is used to trigger the memory usage exceeded\n"
-		"event. The initial value of this is 100MB (100,000,000); allowable settings are\n"
-		"any integer greater than 0.\n"
-		"NOTE: The code supporting this event is not enabled by default because the test\n"
-		"can be computationally expensive and is needed only for specific embedded\n"
-		"applications. Users may enable the test and event generation by uncommenting\n"
-		"code in mem.cpp.\n"
+		"The max-memory-usage setting is a hard limit, in bytes, on the memory an agent\n"
+		"allocates for its memory pools, strings and hash tables. It is checked each\n"
+		"time a memory pool grows. Once the limit is exceeded, Soar prints an error,\n"
+		"triggers the memory usage exceeded event and halts the agent at the end of the\n"
+		"current phase, instead of letting the process run out of memory. Use init-soar\n"
+		"(which returns free pool blocks) or raise the limit before running again.\n"
+		"The default of 0 sets no limit.\n"
 		"\n"
 		"soar max-nil-output-cycles\n"
 		"\n"
@@ -3610,6 +3683,41 @@ void initdocstrings()
 		"generate no output allowed when a run --out command is issued. After this limit\n"
 		"has been reached, Soar stops. The default initial setting of n is 15.\n"
 		"\n"
+		"soar match-threads\n"
+		"\n"
+		"match-threads sets the number of threads used to look up the alpha memories\n"
+		"of large batches of working memory additions (256 or more WMEs added in one\n"
+		"phase, as from a big input-link update). The lookups only read the rete, and\n"
+		"all joins and match set changes are still done in the original order on the\n"
+		"agent's own thread, so rule firings are identical for every setting. The\n"
+		"default of 1 does all matching on the agent's thread.\n"
+		"\n"
+		"soar match-batching\n"
+		"\n"
+		"When match-batching is on, batches of 64 or more working memory additions are\n"
+		"added to the rete grouped by alpha memory, so all the joins fed by one alpha\n"
+		"memory run back to back. The same rules match, but the order in which new\n"
+		"instantiations are found (and so the order of firings and timetags within an\n"
+		"elaboration cycle) can differ from the default WME-by-WME order.\n"
+		"\n"
+		"soar pool-trim-interval\n"
+		"\n"
+		"Memory pools never shrink during a run, so an agent keeps the memory of its\n"
+		"largest working memory or deepest substate stack. With pool-trim-interval set\n"
+		"to n, every n decisions Soar returns the pool blocks none of whose items is in\n"
+		"use. Init-soar always does this. The default of 0 only trims on init-soar.\n"
+		"\n"
+		"soar huge-pages\n"
+		"\n"
+		"With huge-pages set to transparent, new memory pool blocks are carved out of\n"
+		"32 MB regions advised for transparent huge pages instead of being allocated one\n"
+		"at a time with malloc, which saves TLB misses in agents with large working\n"
+		"memories. With explicit, the regions come from the huge pages reserved with\n"
+		"vm.nr_hugepages, falling back to transparent ones when none are left. Regions\n"
+		"are mapped by the thread running the agent and, on Linux, bound to its NUMA\n"
+		"node. Blocks returned by pool trimming stay in their region for reuse. Stats\n"
+		"--memory reports how much of the regions is backed by huge pages.\n"
+		"\n"
 		"soar stop-phase\n"
 		"\n"
 		"stop-phase allows the user to control which phase Soar stops in. When running\n"
@@ -3818,6 +3926,7 @@ void initdocstrings()
 		"\n"
 		"Option           Description\n"
 		"-m, --memory     report usage for Soar's memory pools\n"
+		"-P, --process    report memory usage summed over all agents in the process\n"
 		"-l, --learning   report statistics about rules learned via explanation-based\n"
 		"                 chunking\n"
 		"-r, --rete       report statistics about the rete structure\n"
@@ -3874,7 +3983,9 @@ void initdocstrings()
 		"\n"
 		"The stats argument --memory provides information about memory usage and Soar's\n"
 		"memory pools, which are used to allocate space for the various data structures\n"
-		"used in Soar.\n"
+		"used in Soar.  Each agent has its own pools, so it reports only the current\n"
+		"agent's usage; --process instead adds up all agents in the process along with\n"
+		"the pools shared by the kernel's containers, which are kept per thread.\n"
 		"The stats argument --learning provides information about rules learned through\n"
 		"Soar's explanation-based chunking mechanism. This is the same output that chunk\n"
 		"stats provides. For statistics about a specific rule learned, see the explain\n"
@@ -291,6 +291,7 @@ bool CommandLineInterface::ParseSource(std::vector< std::string >& argv)
     OptionsData optionsData[] =
     {
         {'a', "all",            OPTARG_NONE},
+        {'b', "bulk",           OPTARG_NONE},
         {'d', "disable",        OPTARG_NONE},
         {'v', "verbose",        OPTARG_NONE},
         {0, 0, OPTARG_NONE}
@@ -318,6 +319,9 @@ bool CommandLineInterface::ParseSource(std::vector< std::string >& argv)
             case 'a':
                 options.set(cli::SOURCE_ALL);
                 break;
+            case 'b':
+                options.set(cli::SOURCE_BULK);
+                break;
             case 'v':
                 options.set(cli::SOURCE_VERBOSE);
                 break;
@@ -326,7 +330,7 @@ bool CommandLineInterface::ParseSource(std::vector< std::string >& argv)
 
     if (opt.GetNonOptionArguments() < 2)
     {
-        return SetError("Syntax: load file [--all | --disable | --verbose] <filename>");
+        return SetError("Syntax: load file [--all | --bulk | --disable | --verbose] <filename>");
     }
     else if (opt.GetNonOptionArguments() > 3)
     {
@@ -343,11 +347,14 @@ bool CommandLineInterface::ParseReteLoad(std::vector< std::string >& argv)
         {'l', "load",        OPTARG_REQUIRED},
         {'r', "restore",    OPTARG_REQUIRED},
         {'s', "save",        OPTARG_REQUIRED},
+        {'S', "share",       OPTARG_REQUIRED},
+        {'A', "attach",      OPTARG_REQUIRED},
+        {'U', "unshare",     OPTARG_REQUIRED},
         {0, 0, OPTARG_NONE}
     };
 
-    bool save = false;
-    bool load = false;
+    bool has_mode = false;
+    cli::eReteNetMode mode = cli::RETE_NET_LOAD;
     std::string filename;
 
     for (;;)
@@ -366,20 +373,27 @@ bool CommandLineInterface::ParseReteLoad(std::vector< std::string >& argv)
         {
             case 'l':
             case 'r':
-                load = true;
-                save = false;
-                filename = opt.GetOptionArgument();
+                mode = cli::RETE_NET_LOAD;
                 break;
             case 's':
-                save = true;
-                load = false;
-                filename = opt.GetOptionArgument();
+                mode = cli::RETE_NET_SAVE;
+                break;
+            case 'S':
+                mode = cli::RETE_NET_SHARE;
+                break;
+            case 'A':
+                mode = cli::RETE_NET_ATTACH;
+                break;
+            case 'U':
+                mode = cli::RETE_NET_UNSHARE;
                 break;
         }
+        has_mode = true;
+        filename = opt.GetOptionArgument();
     }
 
-    // Must have a save or load operation
-    if (!save && !load)
+    // Must have a save, load or sharing operation
+    if (!has_mode)
     {
         return SetError("Invalid syntax for that command.");
     }
@@ -388,7 +402,7 @@ bool CommandLineInterface::ParseReteLoad(std::vector< std::string >& argv)
         return SetError("Please specify a file name.");
     }
 
-    return DoReteNet(save, filename);
+    return DoReteNet(mode, filename);
 
 
 }
@@ -511,7 +525,7 @@ bool CommandLineInterface::ParseReteSave(std::vector< std::string >& argv)
         return SetError(opt.GetError().c_str());
     }
 
-    return DoReteNet(true, filename);
+    return DoReteNet(cli::RETE_NET_SAVE, filename);
 }
 bool CommandLineInterface::DoReplayInput(eReplayInputMode mode, std::string* pathname)
 {
@@ -602,15 +616,15 @@ bool CommandLineInterface::DoCaptureInput(eCaptureInputMode mode, bool autoflush
     return true;
 }
 
-bool CommandLineInterface::DoReteNet(bool save, std::string filename)
+bool CommandLineInterface::DoReteNet(eReteNetMode mode, std::string filename)
 {
     if (!filename.size())
     {
-        return SetError("Missing file name.");
+        return SetError((mode == cli::RETE_NET_SAVE) || (mode == cli::RETE_NET_LOAD) ? "Missing file name." : "Missing shared rete net name.");
     }
 
     agent* thisAgent = m_pAgentSML->GetSoarAgent();
-    if (save)
+    if (mode == cli::RETE_NET_SAVE)
     {
         FILE* file = fopen(filename.c_str(), "wb");
 
@@ -628,7 +642,7 @@ bool CommandLineInterface::DoReteNet(bool save, std::string filename)
         fclose(file);
 
     }
-    else
+    else if (mode == cli::RETE_NET_LOAD)
     {
         FILE* file = fopen(filename.c_str(), "rb");
 
@@ -645,6 +659,27 @@ bool CommandLineInterface::DoReteNet(bool save, std::string filename)
 
         fclose(file);
     }
+    else if (mode == cli::RETE_NET_SHARE)
+    {
+        if (! share_rete_net(thisAgent, filename.c_str()))
+        {
+            return SetError("Rete share operation failed.");
+        }
+    }
+    else if (mode == cli::RETE_NET_ATTACH)
+    {
+        if (! attach_shared_rete_net(thisAgent, filename.c_str()))
+        {
+            return SetError("Rete attach operation failed.");
+        }
+    }
+    else
+    {
+        if (! unshare_rete_net(thisAgent, filename.c_str()))
+        {
+            return SetError("Rete unshare operation failed.");
+        }
+    }
 
     return true;
 }
@@ -716,6 +751,15 @@ void CommandLineInterface::PrintSourceSummary(int sourced, const std::list< std:
         {
             m_Result << " " << ignored << " production" << ((ignored == 1) ? " " : "s ") << "ignored.";
         }
+        if (m_SourceFileStack.empty() && m_pSourceOptions && m_pSourceOptions->test(SOURCE_BULK))
+        {
+            agent* thisAgent = m_pAgentSML->GetSoarAgent();
+            m_Result << "\nBulk load: " << (thisAgent->num_bulk_nodes_added - m_BulkStartNodesAdded) << " rete nodes added, "
+                     << (thisAgent->num_bulk_nodes_shared - m_BulkStartNodesShared) << " shared with existing rules. "
+                     << (thisAgent->num_bulk_subtrees_matched - m_BulkStartSubtreesMatched) << " new subtrees matched in "
+                     << ((thisAgent->bulk_match_usec - m_BulkStartMatchUsec) / 1000.0) << " ms ("
+                     << (m_BulkLoadUsec / 1000.0) << " ms total).";
+        }
         m_Result << "\n";
     }
 }
@@ -803,6 +847,8 @@ bool CommandLineInterface::DoSource(std::string path, SourceBitset* pOptions)
     // close file
     fclose(pFile);
 
+    soar_timer bulkTimer;
+
     if (m_SourceFileStack.empty())
     {
         m_pSourceOptions = pOptions;
@@ -820,6 +866,17 @@ bool CommandLineInterface::DoSource(std::string path, SourceBitset* pOptions)
         {
             this->RegisterWithKernel(smlEVENT_BEFORE_PRODUCTION_REMOVED);
         }
+
+        if (m_pSourceOptions && m_pSourceOptions->test(SOURCE_BULK))
+        {
+            agent* thisAgent = m_pAgentSML->GetSoarAgent();
+            m_BulkStartNodesAdded = thisAgent->num_bulk_nodes_added;
+            m_BulkStartNodesShared = thisAgent->num_bulk_nodes_shared;
+            m_BulkStartSubtreesMatched = thisAgent->num_bulk_subtrees_matched;
+            m_BulkStartMatchUsec = thisAgent->bulk_match_usec;
+            bulkTimer.start();
+            rete_begin_bulk_load(thisAgent);
+        }
     }
 
     std::string temp;
@@ -871,6 +928,12 @@ bool CommandLineInterface::DoSource(std::string path, SourceBitset* pOptions)
             this->UnregisterWithKernel(smlEVENT_BEFORE_PRODUCTION_REMOVED);
         }
         agent* thisAgent = m_pAgentSML->GetSoarAgent();
+        if (m_pSourceOptions && m_pSourceOptions->test(SOURCE_BULK))
+        {
+            rete_end_bulk_load(thisAgent);
+            bulkTimer.stop();
+            m_BulkLoadUsec = bulkTimer.get_usec();
+        }
         if (m_pSourceOptions && !m_pSourceOptions->test(SOURCE_DISABLE))
         {
             PrintSourceSummary(m_NumTotalProductionsSourced, m_TotalExcisedDuringSource, m_NumTotalProductionsIgnored);
@@ -888,10 +951,54 @@ bool CommandLineInterface::DoSource(std::string path, SourceBitset* pOptions)
     return ret;
 }
 
+namespace
+{
+    // Handler used by "source --bulk".  Sp, gp and nested source commands go
+    // straight to the parser with bulk loading left on.  Any other command
+    // may look at or change the match state, so the deferred matches are
+    // brought up to date first and bulk loading is suspended while it runs.
+    class BulkSourceHandler : public soar::tokenizer_callback
+    {
+        public:
+            BulkSourceHandler(cli::Parser& pParser, agent* pAgent) : parser(pParser), thisAgent(pAgent) {}
+
+            virtual bool handle_command(std::vector<std::string>& argv)
+            {
+                if (!thisAgent || only_adds_productions(argv))
+                {
+                    return parser.handle_command(argv);
+                }
+                rete_end_bulk_load(thisAgent);
+                bool ret = parser.handle_command(argv);
+                rete_begin_bulk_load(thisAgent);
+                return ret;
+            }
+
+        private:
+            static bool only_adds_productions(const std::vector<std::string>& argv)
+            {
+                return (argv[0] == "sp") || (argv[0] == "gp") || (argv[0] == "source") ||
+                       ((argv[0] == "load") && (argv.size() > 1) && (argv[1] == "file"));
+            }
+
+            cli::Parser&    parser;
+            agent*          thisAgent;
+    };
+}
+
 bool CommandLineInterface::Source(const char* buffer, bool printFileStack)
 {
     soar::tokenizer tokenizer;
-    tokenizer.set_handler(&m_Parser);
+    bool bulk = m_pSourceOptions && m_pSourceOptions->test(SOURCE_BULK);
+    BulkSourceHandler bulkHandler(m_Parser, bulk ? m_pAgentSML->GetSoarAgent() : NULL);
+    if (bulk)
+    {
+        tokenizer.set_handler(&bulkHandler);
+    }
+    else
+    {
+        tokenizer.set_handler(&m_Parser);
+    }
     if (tokenizer.evaluate(buffer))
     {
         return true;
@@ -42,7 +42,11 @@ namespace cli
                     {'l', "load",        OPTARG_REQUIRED},
                     {'r', "restore",    OPTARG_REQUIRED},
                     {'s', "save",        OPTARG_REQUIRED},
+                    {'S', "share",       OPTARG_REQUIRED},
+                    {'A', "attach",      OPTARG_REQUIRED},
+                    {'U', "unshare",     OPTARG_REQUIRED},
                     {'a', "all",            OPTARG_NONE},
+                    {'b', "bulk",           OPTARG_NONE},
                     {'d', "disable",        OPTARG_NONE},
                     {'v', "verbose",        OPTARG_NONE},
                     {0, 0, OPTARG_NONE}
@@ -105,6 +109,9 @@ namespace cli
                     {'l', "load",        OPTARG_REQUIRED},
                     {'r', "restore",    OPTARG_REQUIRED},
                     {'s', "save",        OPTARG_REQUIRED},
+                    {'S', "share",       OPTARG_REQUIRED},
+                    {'A', "attach",      OPTARG_REQUIRED},
+                    {'U', "unshare",     OPTARG_REQUIRED},
                     {'a', "all",            OPTARG_NONE},
                     {'d', "disable",        OPTARG_NONE},
                     {'v', "verbose",        OPTARG_NONE},
@@ -47,11 +47,11 @@ bool print_gds(agent* thisAgent)
     thisAgent->outputManager->printa_sf(thisAgent,  "stepping thru all wmes in rete, looking for any that are in a gds...\n");
     for (w = thisAgent->all_wmes_in_rete; w != NIL; w = w->rete_next)
     {
-        if (w->gds)
+        if (wme_cold_fields(w)->gds)
         {
-            if (w->gds->goal)
+            if (wme_cold_fields(w)->gds->goal)
             {
-                thisAgent->outputManager->printa_sf(thisAgent, "  For Goal  %y  ", w->gds->goal);
+                thisAgent->outputManager->printa_sf(thisAgent, "  For Goal  %y  ", wme_cold_fields(w)->gds->goal);
             }
             else
             {
@@ -75,7 +75,7 @@ bool print_gds(agent* thisAgent)
         {
             /* Loop over all the WMEs in the GDS */
             thisAgent->outputManager->printa_sf(thisAgent,  "\n");
-            for (w = goal->id->gds->wmes_in_gds; w != NIL; w = w->gds_next)
+            for (w = goal->id->gds->wmes_in_gds; w != NIL; w = wme_cold_fields(w)->gds_next)
             {
                 thisAgent->outputManager->printa_sf(thisAgent,  "                (%u: ", w->timetag);
                 thisAgent->outputManager->printa_sf(thisAgent, "%y ^%y %y", w->id, w->attr, w->value);
@@ -29,6 +29,7 @@
 #include "production.h"
 #include "reinforcement_learning.h"
 #include "rete.h"
+#include "rete_profiler.h"
 #include "rhs.h"
 #include "run_soar.h"
 #include "symbol_manager.h"
@@ -38,6 +39,8 @@
 
 #include <algorithm>
 #include <assert.h>
+#include <iomanip>
+#include <sstream>
 
 using namespace cli;
 using namespace sml;
@@ -299,6 +302,7 @@ bool CommandLineInterface::ParseMatches(std::vector< std::string >& argv)
         {'a', "assertions",        OPTARG_NONE},
         {'c', "count",            OPTARG_NONE},
         {'n', "names",            OPTARG_NONE},
+        {'p', "profile",        OPTARG_NONE},
         {'r', "retractions",    OPTARG_NONE},
         {'t', "timetags",        OPTARG_NONE},
         {'w', "wmes",            OPTARG_NONE},
@@ -307,6 +311,7 @@ bool CommandLineInterface::ParseMatches(std::vector< std::string >& argv)
 
     cli::eWMEDetail detail = cli::WME_DETAIL_NONE;
     cli::eMatchesMode mode = cli::MATCHES_ASSERTIONS_RETRACTIONS;
+    bool profile = false;
 
     for (;;)
     {
@@ -338,6 +343,9 @@ bool CommandLineInterface::ParseMatches(std::vector< std::string >& argv)
             case 'r':
                 mode = cli::MATCHES_RETRACTIONS;
                 break;
+            case 'p':
+                profile = true;
+                break;
         }
     }
 
@@ -347,6 +355,16 @@ bool CommandLineInterface::ParseMatches(std::vector< std::string >& argv)
         return SetError("Error.");
     }
 
+    // With --profile, the argument is on, off, reset or the number of productions to list
+    if (profile)
+    {
+        if (opt.GetNonOptionArguments() == 2)
+        {
+            return DoMatchProfile(&argv[opt.GetArgument() - opt.GetNonOptionArguments() + 1]);
+        }
+        return DoMatchProfile();
+    }
+
     if (opt.GetNonOptionArguments() == 2)
     {
         if (mode != cli::MATCHES_ASSERTIONS_RETRACTIONS)
@@ -968,6 +986,85 @@ bool CommandLineInterface::DoMatches(const eMatchesMode mode, const eWMEDetail d
     return true;
 }
 
+struct MatchProfileSort
+{
+    bool operator()(const Rete_Profiler::production_profile& a, const Rete_Profiler::production_profile& b) const
+    {
+        return a.usec > b.usec;
+    }
+};
+
+bool CommandLineInterface::DoMatchProfile(const std::string* pArgument)
+{
+    agent* thisAgent = m_pAgentSML->GetSoarAgent();
+    int numberToList = 20;
+
+    if (pArgument)
+    {
+        if (*pArgument == "on")
+        {
+            set_rete_profiling(thisAgent, true);
+            PrintCLIMessage("Rete profiling enabled.");
+            return true;
+        }
+        if (*pArgument == "off")
+        {
+            set_rete_profiling(thisAgent, false);
+            PrintCLIMessage("Rete profiling disabled.");
+            return true;
+        }
+        if (*pArgument == "reset")
+        {
+            if (thisAgent->reteProfiler)
+            {
+                thisAgent->reteProfiler->reset();
+            }
+            PrintCLIMessage("Rete profile cleared.");
+            return true;
+        }
+        if (!from_string(numberToList, *pArgument) || (numberToList <= 0))
+        {
+            return SetError("Expected on, off, reset or a positive number of productions to list.");
+        }
+    }
+
+    if (!thisAgent->reteProfiler)
+    {
+        return SetError("Rete profiling is off.  Use 'production matches --profile on' to start it.");
+    }
+
+    std::vector<Rete_Profiler::production_profile> profiles;
+    thisAgent->reteProfiler->get_production_profiles(thisAgent, profiles);
+    std::sort(profiles.begin(), profiles.end(), MatchProfileSort());
+
+    uint64_t total_usec = thisAgent->reteProfiler->get_total_usec();
+    std::ostringstream out;
+
+    out << "Beta network time: " << total_usec << " usec.  Productions by their share of it\n"
+        << "(a node shared by several productions has its time split evenly):\n\n";
+    out << std::setw(10) << "usec" << std::setw(7) << "%"
+        << std::setw(12) << "right" << std::setw(10) << "(null)"
+        << std::setw(12) << "left" << std::setw(10) << "(null)"
+        << std::setw(10) << "tokens" << std::setw(7) << "nodes" << std::setw(9) << "(shared)"
+        << "  production\n";
+
+    int i = 0;
+    for (std::vector<Rete_Profiler::production_profile>::iterator it = profiles.begin();
+            (it != profiles.end()) && (i < numberToList); ++it, ++i)
+    {
+        double percent = total_usec ? (100.0 * it->usec / total_usec) : 0.0;
+        out << std::setw(10) << static_cast<uint64_t>(it->usec + 0.5)
+            << std::setw(7) << std::fixed << std::setprecision(1) << percent
+            << std::setw(12) << it->right_activations << std::setw(10) << it->null_right_activations
+            << std::setw(12) << it->left_activations << std::setw(10) << it->null_left_activations
+            << std::setw(10) << it->tokens_created
+            << std::setw(7) << it->num_nodes << std::setw(9) << it->num_shared_nodes
+            << "  " << it->prod->name->sc->name << "\n";
+    }
+    PrintCLIMessage(&out);
+    return true;
+}
+
 bool CommandLineInterface::DoMultiAttributes(const std::string* pAttribute, int n)
 {
     agent* thisAgent = m_pAgentSML->GetSoarAgent();
@@ -48,6 +48,7 @@ namespace cli
                     {'o', "never-fired",        OPTARG_NONE},
                     {'q', "nochunks",           OPTARG_NONE},
                     {'p', "print",              OPTARG_NONE},
+                    {'P', "profile",            OPTARG_NONE},
                     {'r', "retractions",        OPTARG_NONE},
                     {'v', "rhs",                OPTARG_NONE},
                     {'r', "rl",                 OPTARG_NONE},
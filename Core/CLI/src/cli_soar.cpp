@@ -26,6 +26,7 @@
 #include "explanation_memory.h"
 #include "output_manager.h"
 #include "print.h"
+#include "rete.h"
 #include "xml.h"
 
 using namespace cli;
@@ -280,12 +281,59 @@ bool CommandLineInterface::DoSoar(const char pOp, const std::string* pArg1, cons
         else if (my_param == thisAgent->Decider->params->max_memory_usage)
         {
             thisAgent->Decider->settings[DECIDER_MAX_MEMORY_USAGE] = thisAgent->Decider->params->max_memory_usage->get_value();
+            thisAgent->memoryManager->set_memory_limit(static_cast<size_t>(thisAgent->Decider->settings[DECIDER_MAX_MEMORY_USAGE]));
             if (thisAgent->Decider->settings[DECIDER_MAX_MEMORY_USAGE] > 0)
             {
-                thisAgent->outputManager->sprint_sf(tempString, "Soar will now interrupt execution if more than %u bytes of memory are used.  (This requires a special build of Soar.  See manual for more information.)", thisAgent->Decider->settings[DECIDER_MAX_MEMORY_USAGE]);
+                thisAgent->outputManager->sprint_sf(tempString, "Soar will now halt if the agent uses more than %u bytes of memory.", thisAgent->Decider->settings[DECIDER_MAX_MEMORY_USAGE]);
                 PrintCLIMessage(tempString.c_str());
             } else {
-                PrintCLIMessage("Soar will not interrupt execution based on memory usage. (default)");
+                PrintCLIMessage("Soar will not halt based on memory usage. (default)");
+            }
+        }
+        else if (my_param == thisAgent->Decider->params->match_threads)
+        {
+            thisAgent->Decider->settings[DECIDER_MATCH_THREADS] = thisAgent->Decider->params->match_threads->get_value();
+            set_rete_match_threads(thisAgent, thisAgent->Decider->settings[DECIDER_MATCH_THREADS]);
+            if (thisAgent->Decider->settings[DECIDER_MATCH_THREADS] > 1)
+            {
+                thisAgent->outputManager->sprint_sf(tempString, "Soar will now use %u threads to find alpha memories for large batches of working memory changes.", thisAgent->Decider->settings[DECIDER_MATCH_THREADS]);
+                PrintCLIMessage(tempString.c_str());
+            } else {
+                PrintCLIMessage("Soar will now match all working memory changes on a single thread. (default)");
+            }
+        }
+        else if (my_param == thisAgent->Decider->params->match_batching)
+        {
+            thisAgent->Decider->settings[DECIDER_MATCH_BATCHING] = thisAgent->Decider->params->match_batching->get_value();
+            thisAgent->outputManager->sprint_sf(tempString, "Soar will now add large batches of working memory changes to the rete %s.", thisAgent->Decider->settings[DECIDER_MATCH_BATCHING] ? "grouped by alpha memory" : "one WME at a time");
+            PrintCLIMessage(tempString.c_str());
+        }
+        else if (my_param == thisAgent->Decider->params->pool_trim_interval)
+        {
+            thisAgent->Decider->settings[DECIDER_POOL_TRIM_INTERVAL] = thisAgent->Decider->params->pool_trim_interval->get_value();
+            if (thisAgent->Decider->settings[DECIDER_POOL_TRIM_INTERVAL] > 0)
+            {
+                thisAgent->outputManager->sprint_sf(tempString, "Soar will now return free memory pool blocks every %u decisions.", thisAgent->Decider->settings[DECIDER_POOL_TRIM_INTERVAL]);
+                PrintCLIMessage(tempString.c_str());
+            } else {
+                PrintCLIMessage("Soar will only return free memory pool blocks on init-soar. (default)");
+            }
+        }
+        else if (my_param == thisAgent->Decider->params->huge_pages)
+        {
+            thisAgent->Decider->settings[DECIDER_HUGE_PAGES] = thisAgent->Decider->params->huge_pages->get_value();
+            thisAgent->memoryManager->set_huge_pages(thisAgent->Decider->params->huge_pages->get_value());
+            if (thisAgent->Decider->settings[DECIDER_HUGE_PAGES] == HUGE_PAGES_EXPLICIT)
+            {
+                PrintCLIMessage("Soar will now take new memory pool blocks from reserved huge pages, or transparent ones if none are reserved.");
+            }
+            else if (thisAgent->Decider->settings[DECIDER_HUGE_PAGES] == HUGE_PAGES_TRANSPARENT)
+            {
+                PrintCLIMessage("Soar will now take new memory pool blocks from regions backed by transparent huge pages.");
+            }
+            else
+            {
+                PrintCLIMessage("Soar will now allocate new memory pool blocks with malloc. (default)");
             }
         }
         else if (my_param == thisAgent->Decider->params->max_nil_output_cycles)
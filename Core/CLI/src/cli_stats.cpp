@@ -79,7 +79,7 @@ bool CommandLineInterface::DoStats(const StatsBitset& options, int sort)
 
     if (options.test(STATS_MEMORY))
     {
-        GetMemoryStats();
+        GetMemoryStats(options.test(STATS_PROCESS));
     }
     if (options.test(STATS_MAX))
     {
@@ -539,29 +539,69 @@ void CommandLineInterface::GetMaxStats()
 
 }
 
-void CommandLineInterface::GetMemoryStats()
+void CommandLineInterface::GetMemoryStats(bool pProcess)
 {
     agent* thisAgent = m_pAgentSML->GetSoarAgent();
+    size_t process_usage[NUM_MEM_USAGE_CODES];
+    std::vector<memory_pool> process_pools;
+    size_t* usage = thisAgent->memoryManager->memory_for_usage;
+
+    if (pProcess)
+    {
+        Memory_Manager::get_process_memory_statistics(process_usage, process_pools);
+        usage = process_usage;
+    }
+
     size_t total = 0;
     for (int i = 0; i < NUM_MEM_USAGE_CODES; i++)
     {
-        total += thisAgent->memoryManager->memory_for_usage[i];
+        total += usage[i];
     }
 
     m_Result << std::setw(8) << total << " bytes total memory allocated\n";
-    m_Result << std::setw(8) << thisAgent->memoryManager->memory_for_usage[STATS_OVERHEAD_MEM_USAGE] << " bytes statistics overhead\n";
-    m_Result << std::setw(8) << thisAgent->memoryManager->memory_for_usage[STRING_MEM_USAGE] << " bytes for strings\n";
-    m_Result << std::setw(8) << thisAgent->memoryManager->memory_for_usage[HASH_TABLE_MEM_USAGE] << " bytes for hash tables\n";
-    m_Result << std::setw(8) << thisAgent->memoryManager->memory_for_usage[POOL_MEM_USAGE] << " bytes for various memory pools\n";
-    m_Result << std::setw(8) << thisAgent->memoryManager->memory_for_usage[MISCELLANEOUS_MEM_USAGE] << " bytes for miscellaneous other things\n";
+    m_Result << std::setw(8) << usage[STATS_OVERHEAD_MEM_USAGE] << " bytes statistics overhead\n";
+    m_Result << std::setw(8) << usage[STRING_MEM_USAGE] << " bytes for strings\n";
+    m_Result << std::setw(8) << usage[HASH_TABLE_MEM_USAGE] << " bytes for hash tables\n";
+    m_Result << std::setw(8) << usage[POOL_MEM_USAGE] << " bytes for various memory pools\n";
+    m_Result << std::setw(8) << usage[MISCELLANEOUS_MEM_USAGE] << " bytes for miscellaneous other things\n";
+
+    if (!pProcess)
+    {
+        size_t arena_bytes, huge_page_bytes;
+        thisAgent->memoryManager->get_huge_page_coverage(arena_bytes, huge_page_bytes);
+        if (arena_bytes || (thisAgent->memoryManager->get_huge_pages() != HUGE_PAGES_OFF))
+        {
+            m_Result << std::setw(8) << arena_bytes << " bytes of pool blocks in huge-page regions ("
+                     << huge_page_bytes << " bytes of the regions on huge pages)\n";
+        }
+    }
 
-    GetMemoryPoolStatistics();
+    if (pProcess)
+    {
+        m_Result << "Memory pool statistics (all agents):\n\n";
+        PrintMemoryPoolStatistics(process_pools);
+    }
+    else
+    {
+        GetMemoryPoolStatistics();
+    }
 }
 
 void CommandLineInterface::GetMemoryPoolStatistics()
 {
     agent* thisAgent = m_pAgentSML->GetSoarAgent();
+    std::vector<memory_pool> pools;
+
+    for (memory_pool* p = thisAgent->memoryManager->memory_pools_in_use; p != NIL; p = p->next)
+    {
+        pools.push_back(*p);
+    }
     m_Result << "Memory pool statistics:\n\n";
+    PrintMemoryPoolStatistics(pools);
+}
+
+void CommandLineInterface::PrintMemoryPoolStatistics(const std::vector<memory_pool>& pPools)
+{
 #ifdef MEMORY_POOL_STATS
     m_Result << "Pool Name        Used Items  Free Items  Item Size  Itm/Blk  Blocks  Total Bytes\n";
     m_Result << "---------------  ----------  ----------  ---------  -------  ------  -----------\n";
@@ -570,7 +610,7 @@ void CommandLineInterface::GetMemoryPoolStatistics()
     m_Result << "---------------  ---------  -------  ------  -----------\n";
 #endif
 
-    for (memory_pool* p = thisAgent->memoryManager->memory_pools_in_use; p != NIL; p = p->next)
+    for (std::vector<memory_pool>::const_iterator p = pPools.begin(); p != pPools.end(); ++p)
     {
         m_Result << std::setw(MAX_POOL_NAME_LENGTH) << p->name;
 #ifdef MEMORY_POOL_STATS
@@ -653,6 +693,47 @@ void CommandLineInterface::GetReteStats()
              << thisAgent->num_null_right_activations << " null), "
              << thisAgent->num_left_activations << " left ("
              << thisAgent->num_null_left_activations << " null)\n";
+    if (thisAgent->num_parallel_match_batches)
+    {
+        m_Result << "Parallel alpha lookups: " << thisAgent->num_parallel_match_wmes << " wmes in "
+                 << thisAgent->num_parallel_match_batches << " batches\n";
+    }
+    if (thisAgent->num_grouped_match_batches)
+    {
+        m_Result << "Alpha memory grouped additions: " << thisAgent->num_grouped_match_wmes << " wmes in "
+                 << thisAgent->num_grouped_match_batches << " batches\n";
+    }
+    if (thisAgent->num_const_filter_programs)
+    {
+        m_Result << "Constant test programs: " << thisAgent->num_const_filter_programs << " ("
+                 << thisAgent->num_const_filter_rebuilds << " builds, "
+                 << thisAgent->num_const_filter_skipped_activations << " right activations skipped)\n";
+    }
+    if (thisAgent->num_double_unlinks)
+    {
+        m_Result << "Doubly unlinked join nodes: " << thisAgent->num_double_unlinks << " ("
+                 << thisAgent->num_null_activations_avoided_by_double_unlinking << " null right activations avoided)\n";
+    }
+
+    /* --- print memory hash table statistics --- */
+    rete_hash_table_stats ht_stats[2];
+    const char* ht_names[2] = { "left (tokens)", "right (alpha mems)" };
+    get_rete_hash_table_stats(thisAgent, &ht_stats[0], &ht_stats[1]);
+
+    m_Result << "\n  Memory Hash Table       Items   Buckets  Non-empty  Mean Len  Max Len  Resizes\n";
+    m_Result << "---------------------  --------  --------  ---------  --------  -------  -------\n";
+    for (i = 0; i < 2; i++)
+    {
+        m_Result << std::setw(21) << ht_names[i] << "  "
+                 << std::setw(8) << ht_stats[i].count << "  "
+                 << std::setw(8) << ht_stats[i].size << "  "
+                 << std::setw(9) << ht_stats[i].nonempty_buckets << "  "
+                 << std::setw(8) << std::fixed << std::setprecision(2)
+                 << (ht_stats[i].nonempty_buckets ? static_cast<double>(ht_stats[i].count) / ht_stats[i].nonempty_buckets : 0.0) << "  "
+                 << std::setw(7) << ht_stats[i].max_bucket_length << "  "
+                 << std::setw(7) << ht_stats[i].num_resizes
+                 << (ht_stats[i].rehash_in_progress ? "  (rehashing)" : "") << "\n";
+    }
 }
 
 
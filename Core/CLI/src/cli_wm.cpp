@@ -532,9 +532,9 @@ bool CommandLineInterface::DoRemoveWME(uint64_t timetag)
         }
 
         /* REW: begin 09.15.96 */
-        if (pWme->gds)
+        if (wme_cold_fields(pWme)->gds)
         {
-            if (pWme->gds->goal != 0)
+            if (wme_cold_fields(pWme)->gds->goal != 0)
             {
                 gds_invalid_so_remove_goal(thisAgent, pWme);
                 /* NOTE: the call to remove_wme_from_wm will take care of checking if
@@ -1048,9 +1048,9 @@ int RemoveWme(agent* thisAgent, wme* pWme)
 #endif // USE_CAPTURE_REPLAY
 
     /* REW: begin 09.15.96 */
-    if (pWme->gds)
+    if (wme_cold_fields(pWme)->gds)
     {
-        if (pWme->gds->goal != NIL)
+        if (wme_cold_fields(pWme)->gds->goal != NIL)
         {
             gds_invalid_so_remove_goal(thisAgent, pWme);
             /* NOTE: the call to remove_wme_from_wm will take care of checking if
@@ -1230,7 +1230,6 @@ bool AgentSML::RemoveInputWME(char const* pClientTimeTag)
 void AgentSML::AddWmeToWmeMap(int64_t clientTimeTag, wme* w)
 {
     uint64_t timetag = w->timetag ;
-    m_KernelTimeTagToWmeMap[timetag] = w ;
 
     // Keep track of which client timetags correspond to which kernel timetags
     this->RecordTime(clientTimeTag, timetag) ;
@@ -1239,7 +1238,6 @@ void AgentSML::AddWmeToWmeMap(int64_t clientTimeTag, wme* w)
 void AgentSML::RemoveWmeFromWmeMap(wme* w)
 {
     int64_t timetag = w->timetag ;
-    m_KernelTimeTagToWmeMap.erase(timetag) ;
 
     // Keep track of which client timetags correspond to which kernel timetags
     this->RemoveKernelTime(timetag) ;
@@ -1247,12 +1245,8 @@ void AgentSML::RemoveWmeFromWmeMap(wme* w)
 
 wme* AgentSML::FindWmeFromKernelTimetag(uint64_t timetag)
 {
-    WmeMapIter wi = m_KernelTimeTagToWmeMap.find(timetag);
-    if (wi == m_KernelTimeTagToWmeMap.end())
-    {
-        return NULL;
-    }
-    return wi->second;
+    // The kernel indexes its input wmes by timetag
+    return find_input_wme_by_timetag(m_agent, timetag);
 }
 
 void AgentSML::InputWmeGarbageCollectedHandler(agent* /*pSoarAgent*/, int eventID, void* pData, void* pCallData)
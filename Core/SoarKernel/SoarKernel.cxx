@@ -41,6 +41,7 @@
 #include <lexer.cpp>
 #include <mem.cpp>
 #include <memory_manager.cpp>
+#include <page_arena.cpp>
 #include <output_errors.cpp>
 #include <output_manager.cpp>
 #include <output_print.cpp>
@@ -53,6 +54,9 @@
 #include <production.cpp>
 #include <reinforcement_learning.cpp>
 #include <rete.cpp>
+#include <rete_worker_pool.cpp>
+#include <rete_const_filter.cpp>
+#include <rete_profiler.cpp>
 #include <rhs_functions_math.cpp>
 #include <rhs_functions.cpp>
 #include <rhs.cpp>
@@ -1891,8 +1891,9 @@ Symbol* create_new_impasse(agent* thisAgent, bool isa_goal, Symbol* object, Symb
             }
             if (level > TOP_GOAL_LEVEL)
             {
-                lSSWME->local_singleton_id_identity_set = thisAgent->explanationBasedChunker->get_floating_identity(impasseID);
-                lSSWME->local_singleton_value_identity_set = thisAgent->explanationBasedChunker->get_floating_identity(impasseID);
+                wme_cold* lSSWMECold = writable_wme_cold_fields(thisAgent, lSSWME);
+                lSSWMECold->local_singleton_id_identity_set = thisAgent->explanationBasedChunker->get_floating_identity(impasseID);
+                lSSWMECold->local_singleton_value_identity_set = thisAgent->explanationBasedChunker->get_floating_identity(impasseID);
             }
         }
         Symbol* lreward_header = thisAgent->symbolManager->make_new_identifier('R', level);
@@ -2159,9 +2160,9 @@ void decide_non_context_slot(agent* thisAgent, slot* s)
         else
         {
             remove_from_dll(s->wmes, w, next, prev);
-            if (w->gds)
+            if (wme_cold_fields(w)->gds)
             {
-                if (w->gds->goal != NIL)
+                if (wme_cold_fields(w)->gds->goal != NIL)
                 {
                     /* If the goal pointer is non-NIL, then goal is in the stack */
                     gds_invalid_so_remove_goal(thisAgent, w);
@@ -2994,6 +2995,7 @@ void init_decider(agent* thisAgent)
 {
     thisAgent->memoryManager->init_memory_pool(MP_slot, sizeof(slot), "slot");
     thisAgent->memoryManager->init_memory_pool(MP_wme, sizeof(wme), "wme");
+    thisAgent->memoryManager->init_memory_pool(MP_wme_cold, sizeof(wme_cold), "wme cold");
     thisAgent->memoryManager->init_memory_pool(MP_preference, sizeof(preference), "preference");
 }
 
@@ -3540,16 +3542,24 @@ void uniquely_add_to_head_of_dll(agent* thisAgent, instantiation* inst)
 
 void add_wme_to_gds(agent* thisAgent, goal_dependency_set* gds, wme* wme_to_add)
 {
-    /* Set the correct GDS for this wme (wme's point to their gds) */
-    wme_to_add->gds = gds;
-    insert_at_head_of_dll(gds->wmes_in_gds, wme_to_add, gds_next, gds_prev);
+    /* Set the correct GDS for this wme (wme's point to their gds).  The
+       links of the GDS's wme list live in the wmes' cold records. */
+    wme_cold* cold = writable_wme_cold_fields(thisAgent, wme_to_add);
+    cold->gds = gds;
+    cold->gds_next = gds->wmes_in_gds;
+    cold->gds_prev = NIL;
+    if (gds->wmes_in_gds)
+    {
+        gds->wmes_in_gds->cold->gds_prev = wme_to_add;
+    }
+    gds->wmes_in_gds = wme_to_add;
 
     if (thisAgent->trace_settings[TRACE_GDS_WMES_SYSPARAM])
     {
         // BADBAD: the XML code makes this all very ugly
         char msgbuf[256];
         memset(msgbuf, 0, 256);
-        thisAgent->outputManager->sprinta_sf_cstr(thisAgent, msgbuf, 255, "Adding to GDS for %y: ", wme_to_add->gds->goal);
+        thisAgent->outputManager->sprinta_sf_cstr(thisAgent, msgbuf, 255, "Adding to GDS for %y: ", gds->goal);
         thisAgent->outputManager->printa(thisAgent,  msgbuf);
 
         xml_begin_tag(thisAgent, kTagVerbose);
@@ -3559,6 +3569,37 @@ void add_wme_to_gds(agent* thisAgent, goal_dependency_set* gds, wme* wme_to_add)
     }
 }
 
+/* --- takes a wme off its GDS's wme list, freeing the GDS once the list
+   is empty; the wme keeps pointing at its old GDS, as it always has --- */
+void remove_wme_from_gds(agent* thisAgent, wme* w)
+{
+    wme_cold* cold = w->cold;
+    goal_dependency_set* gds = cold->gds;
+
+    if (cold->gds_next)
+    {
+        cold->gds_next->cold->gds_prev = cold->gds_prev;
+    }
+    if (cold->gds_prev)
+    {
+        cold->gds_prev->cold->gds_next = cold->gds_next;
+    }
+    else
+    {
+        gds->wmes_in_gds = cold->gds_next;
+    }
+
+    /* Must check for GDS removal every time we take a WME off the GDS wme list */
+    if (!gds->wmes_in_gds)
+    {
+        if (gds->goal)
+        {
+            gds->goal->id->gds = NIL;
+        }
+        thisAgent->memoryManager->free_with_pool(MP_gds, gds);
+    }
+}
+
 /*
 ========================
 
@@ -3616,29 +3657,18 @@ void elaborate_gds(agent* thisAgent)
 
             if ((pref_for_this_wme == NIL) || (wme_goal_level < inst->match_goal_level))
             {
-                if (wme_matching_this_cond->gds != NIL)
+                goal_dependency_set* old_gds = wme_cold_fields(wme_matching_this_cond)->gds;
+
+                if (old_gds != NIL)
                 {
                     /* Then we want to check and see if the old GDS value should be changed */
-                    if (wme_matching_this_cond->gds->goal == NIL)
+                    if (old_gds->goal == NIL)
                     {
                         /* The goal is NIL: meaning that the goal for the GDS is no longer around */
-                        fast_remove_from_dll(wme_matching_this_cond->gds->wmes_in_gds,  wme_matching_this_cond, wme, gds_next, gds_prev);
-
-                        /* Must check for GDS removal every time we take a WME off the GDS wme list */
-                        if (!wme_matching_this_cond->gds->wmes_in_gds)
-                        {
-                            if (wme_matching_this_cond->gds->goal)
-                            {
-                                wme_matching_this_cond->gds->goal->id->gds = NIL;
-                            }
-
-                            thisAgent->memoryManager->free_with_pool(MP_gds, wme_matching_this_cond->gds);
-
-                        }
-
+                        remove_wme_from_gds(thisAgent, wme_matching_this_cond);
                         add_wme_to_gds(thisAgent, inst->match_goal->id->gds, wme_matching_this_cond);
                     }
-                    else if (wme_matching_this_cond->gds->goal->id->level > inst->match_goal_level)
+                    else if (old_gds->goal->id->level > inst->match_goal_level)
                     {
                         /* This WME currently belongs to the GDS of a goal below the current one */
                         /* 1. Take WME off old (current) GDS list
@@ -3646,19 +3676,8 @@ void elaborate_gds(agent* thisAgent)
                          * 3. Add WME to new GDS list
                          * 4. Update WME pointer to new GDS list
                          */
-                        fast_remove_from_dll(wme_matching_this_cond->gds->wmes_in_gds,  wme_matching_this_cond, wme, gds_next, gds_prev);
-                        if (!wme_matching_this_cond->gds->wmes_in_gds)
-                        {
-                            if (wme_matching_this_cond->gds->goal)
-                            {
-                                wme_matching_this_cond->gds->goal->id->gds = NIL;
-                            }
-
-                            thisAgent->memoryManager->free_with_pool(MP_gds, wme_matching_this_cond->gds);
-
-                        }
+                        remove_wme_from_gds(thisAgent, wme_matching_this_cond);
                         add_wme_to_gds(thisAgent, inst->match_goal->id->gds, wme_matching_this_cond);
-                        wme_matching_this_cond->gds = inst->match_goal->id->gds;
                     }
                 }
                 else
@@ -3666,7 +3685,7 @@ void elaborate_gds(agent* thisAgent)
                     /* WME should be in the GDS of the current goal if the WME's GDS does not already exist. (i.e., if NIL GDS) */
                     add_wme_to_gds(thisAgent, inst->match_goal->id->gds, wme_matching_this_cond);
 
-                    if (wme_matching_this_cond->gds->wmes_in_gds->gds_prev)
+                    if (wme_cold_fields(inst->match_goal->id->gds->wmes_in_gds)->gds_prev)
                     {
                         thisAgent->outputManager->printa_sf(thisAgent, "\nDEBUG DEBUG : The new header should never have a prev value.\n");
                     }
@@ -3702,48 +3721,26 @@ void elaborate_gds(agent* thisAgent)
                                 wme* fake_inst_wme_cond;
 
                                 fake_inst_wme_cond = pref_for_this_wme->inst->top_of_instantiated_conditions->bt.wme_;
-                                if (fake_inst_wme_cond->gds != NIL)
+                                goal_dependency_set* old_gds = wme_cold_fields(fake_inst_wme_cond)->gds;
+
+                                if (old_gds != NIL)
                                 {
                                     /* Then we want to check and see if the old GDS value should be changed */
-                                    if (fake_inst_wme_cond->gds->goal == NIL)
+                                    if (old_gds->goal == NIL)
                                     {
                                         /* The goal is NIL: meaning that the goal for the GDS is no longer around */
-
-                                        fast_remove_from_dll(fake_inst_wme_cond->gds->wmes_in_gds, fake_inst_wme_cond, wme, gds_next, gds_prev);
-
-                                        /* We have to check for GDS removal anytime we take a WME off the GDS wme list, not just when a WME
-                                         * is removed from memory. */
-                                        if (!fake_inst_wme_cond->gds->wmes_in_gds)
-                                        {
-                                            if (fake_inst_wme_cond->gds->goal)
-                                            {
-                                                fake_inst_wme_cond->gds->goal->id->gds = NIL;
-                                            }
-                                            thisAgent->memoryManager->free_with_pool(MP_gds, fake_inst_wme_cond->gds);
-                                        }
-
+                                        remove_wme_from_gds(thisAgent, fake_inst_wme_cond);
                                         add_wme_to_gds(thisAgent, inst->match_goal->id->gds, fake_inst_wme_cond);
                                     }
-                                    else if (fake_inst_wme_cond->gds->goal->id->level > inst->match_goal_level)
+                                    else if (old_gds->goal->id->level > inst->match_goal_level)
                                     {
                                         /* If the WME currently belongs to the GDS of a goal below the current one:
                                          * 1. Take WME off old (current) GDS list
                                          * 2. Check to see if old GDS WME list is empty. If so, remove(free) it.
                                          * 3. Add WME to new GDS list
                                          * 4. Update WME pointer to new GDS list */
-                                        fast_remove_from_dll(fake_inst_wme_cond->gds->wmes_in_gds, fake_inst_wme_cond, wme, gds_next, gds_prev);
-                                        if (!fake_inst_wme_cond->gds->wmes_in_gds)
-                                        {
-                                            if (fake_inst_wme_cond->gds->goal)
-                                            {
-                                                fake_inst_wme_cond->gds->goal->id->gds = NIL;
-                                            }
-
-                                            thisAgent->memoryManager->free_with_pool(MP_gds, fake_inst_wme_cond->gds);
-                                        }
-
+                                        remove_wme_from_gds(thisAgent, fake_inst_wme_cond);
                                         add_wme_to_gds(thisAgent, inst->match_goal->id->gds, fake_inst_wme_cond);
-                                        fake_inst_wme_cond->gds = inst->match_goal->id->gds;
                                     }
                                 }
                                 else
@@ -3752,7 +3749,7 @@ void elaborate_gds(agent* thisAgent)
 
                                     add_wme_to_gds(thisAgent, inst->match_goal->id->gds, fake_inst_wme_cond);
 
-                                    if (fake_inst_wme_cond->gds->wmes_in_gds->gds_prev)
+                                    if (wme_cold_fields(inst->match_goal->id->gds->wmes_in_gds)->gds_prev)
                                     {
                                         thisAgent->outputManager->printa_sf(thisAgent, "\nDEBUG DEBUG : The new header should never have a prev value.\n");
                                     }
@@ -3848,12 +3845,14 @@ approaches may be better */
 
 void gds_invalid_so_remove_goal(agent* thisAgent, wme* w)
 {
+    Symbol* gds_goal = wme_cold_fields(w)->gds->goal;
+
     if (thisAgent->trace_settings[TRACE_GDS_STATE_REMOVAL_SYSPARAM])
     {
         // BADBAD: the XML code makes this all very ugly
         char msgbuf[256];
         memset(msgbuf, 0, 256);
-        thisAgent->outputManager->sprinta_sf_cstr(thisAgent, msgbuf, 255, "Removing state %y because element in GDS changed. WME: ", w->gds->goal);
+        thisAgent->outputManager->sprinta_sf_cstr(thisAgent, msgbuf, 255, "Removing state %y because element in GDS changed. WME: ", gds_goal);
         thisAgent->outputManager->printa(thisAgent, msgbuf);
 
         xml_begin_tag(thisAgent, soar_TraceNames::kTagVerbose);
@@ -3890,15 +3889,15 @@ void gds_invalid_so_remove_goal(agent* thisAgent, wme* w)
 
     if (thisAgent->highest_goal_whose_context_changed)
     {
-        if (thisAgent->highest_goal_whose_context_changed->id->level >= w->gds->goal->id->level)
+        if (thisAgent->highest_goal_whose_context_changed->id->level >= gds_goal->id->level)
         {
-            thisAgent->highest_goal_whose_context_changed = w->gds->goal->id->higher_goal;
+            thisAgent->highest_goal_whose_context_changed = gds_goal->id->higher_goal;
         }
     }
     else
     {
         /* If nothing has yet changed (highest_ ... = NIL) then set the goal automatically */
-        thisAgent->highest_goal_whose_context_changed = w->gds->goal->id->higher_goal;
+        thisAgent->highest_goal_whose_context_changed = gds_goal->id->higher_goal;
 
         // Tell those slots they are changed so that the impasses can be regenerated bug 1011
         for (slot* s = thisAgent->highest_goal_whose_context_changed->id->slots; s != 0; s = s->next)
@@ -3912,11 +3911,11 @@ void gds_invalid_so_remove_goal(agent* thisAgent, wme* w)
 
     if (thisAgent->trace_settings[TRACE_GDS_STATE_REMOVAL_SYSPARAM])
     {
-        thisAgent->outputManager->printa_sf(thisAgent, "\n    REMOVING GOAL [%y] due to change in GDS WME ", w->gds->goal);
+        thisAgent->outputManager->printa_sf(thisAgent, "\n    REMOVING GOAL [%y] due to change in GDS WME ", gds_goal);
         print_wme(thisAgent, w);
     }
 
-    remove_existing_context_and_descendents(thisAgent, w->gds->goal);
+    remove_existing_context_and_descendents(thisAgent, gds_goal);
 
     /* BUG: Need to reset highest_goal here ???*/
 
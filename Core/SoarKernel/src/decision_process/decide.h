@@ -133,6 +133,7 @@ extern void remove_existing_attribute_impasse_for_slot(agent* thisAgent, slot* s
 
 extern void elaborate_gds(agent* thisAgent);
 extern void gds_invalid_so_remove_goal(agent* thisAgent, wme* w);
+extern void remove_wme_from_gds(agent* thisAgent, wme* w);
 extern void free_parent_list(agent* thisAgent);
 extern void uniquely_add_to_head_of_dll(agent* thisAgent, instantiation* inst);
 extern void create_gds_for_goal(agent* thisAgent, Symbol* goal);
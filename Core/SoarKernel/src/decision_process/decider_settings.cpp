@@ -24,11 +24,15 @@ decider_param_container::decider_param_container(agent* new_agent, uint64_t pDec
     pDecider_settings[DECIDER_MAX_DC_TIME] = 0;
     pDecider_settings[DECIDER_MAX_ELABORATIONS] = 100;
     pDecider_settings[DECIDER_MAX_GOAL_DEPTH] = 100;
-    pDecider_settings[DECIDER_MAX_MEMORY_USAGE] = 100000000;
+    pDecider_settings[DECIDER_MAX_MEMORY_USAGE] = 0;
     pDecider_settings[DECIDER_MAX_NIL_OUTPUT_CYCLES] = 15;
     pDecider_settings[DECIDER_WAIT_SNC] = 0;
     pDecider_settings[DECIDER_EXPLORATION_POLICY] = USER_SELECT_SOFTMAX;
     pDecider_settings[DECIDER_AUTO_REDUCE] = false;
+    pDecider_settings[DECIDER_MATCH_THREADS] = 1;
+    pDecider_settings[DECIDER_MATCH_BATCHING] = false;
+    pDecider_settings[DECIDER_POOL_TRIM_INTERVAL] = 0;
+    pDecider_settings[DECIDER_HUGE_PAGES] = HUGE_PAGES_OFF;
 
     stop_phase = new soar_module::constant_param<top_level_phase>("stop-phase", APPLY_PHASE, new soar_module::f_predicate<top_level_phase>());
     stop_phase->add_mapping(APPLY_PHASE, "apply");
@@ -48,10 +52,21 @@ decider_param_container::decider_param_container(agent* new_agent, uint64_t pDec
     add(max_elaborations);
     max_goal_depth = new soar_module::integer_param("max-goal-depth", pDecider_settings[DECIDER_MAX_GOAL_DEPTH], new soar_module::gt_predicate<int64_t>(1, true), new soar_module::f_predicate<int64_t>());
     add(max_goal_depth);
-    max_memory_usage = new soar_module::integer_param("max-memory-usage", pDecider_settings[DECIDER_MAX_MEMORY_USAGE], new soar_module::gt_predicate<int64_t>(1, true), new soar_module::f_predicate<int64_t>());
+    max_memory_usage = new soar_module::integer_param("max-memory-usage", pDecider_settings[DECIDER_MAX_MEMORY_USAGE], new soar_module::gt_predicate<int64_t>(0, true), new soar_module::f_predicate<int64_t>());
     add(max_memory_usage);
     max_nil_output_cycles = new soar_module::integer_param("max-nil-output-cycles", pDecider_settings[DECIDER_MAX_NIL_OUTPUT_CYCLES], new soar_module::gt_predicate<int64_t>(1, true), new soar_module::f_predicate<int64_t>());
     add(max_nil_output_cycles);
+    match_threads = new soar_module::integer_param("match-threads", pDecider_settings[DECIDER_MATCH_THREADS], new soar_module::gt_predicate<int64_t>(1, true), new soar_module::f_predicate<int64_t>());
+    add(match_threads);
+    match_batching = new soar_module::boolean_param("match-batching", pDecider_settings[DECIDER_MATCH_BATCHING] ? on : off, new soar_module::f_predicate<boolean>());
+    add(match_batching);
+    pool_trim_interval = new soar_module::integer_param("pool-trim-interval", pDecider_settings[DECIDER_POOL_TRIM_INTERVAL], new soar_module::gt_predicate<int64_t>(0, true), new soar_module::f_predicate<int64_t>());
+    add(pool_trim_interval);
+    huge_pages = new soar_module::constant_param<Huge_page_modes>("huge-pages", HUGE_PAGES_OFF, new soar_module::f_predicate<Huge_page_modes>());
+    huge_pages->add_mapping(HUGE_PAGES_OFF, "off");
+    huge_pages->add_mapping(HUGE_PAGES_TRANSPARENT, "transparent");
+    huge_pages->add_mapping(HUGE_PAGES_EXPLICIT, "explicit");
+    add(huge_pages);
     tcl_enabled = new soar_module::boolean_param("tcl", Soar_Instance::Get_Soar_Instance().is_Tcl_on() ? on : off, new soar_module::f_predicate<boolean>());
     add(tcl_enabled);
     timers_enabled = new soar_module::boolean_param("timers", new_agent->timers_enabled ? on : off, new soar_module::f_predicate<boolean>());
@@ -131,8 +146,12 @@ void decider_param_container::print_settings(agent* thisAgent)
     outputManager->printa_sf(thisAgent, "%s   %-%s\n", concatJustified("max-goal-depth", max_goal_depth->get_string(), 47).c_str(), "Halt if goal stack reaches this depth");
     outputManager->printa_sf(thisAgent, "%s   %-%s\n", concatJustified("max-nil-output-cycles", max_nil_output_cycles->get_string(), 47).c_str(), "Impasse after this many nil outputs (run --out)");
     outputManager->printa_sf(thisAgent, "%s   %-%s\n", concatJustified("max-dc-time", max_dc_time->get_string(), 47).c_str(), "Interrupt decision after this much time");
-    outputManager->printa_sf(thisAgent, "%s   %-%s\n", concatJustified("max-memory-usage", max_memory_usage->get_string(), 47).c_str(), "Threshold for memory warning (see help)");
+    outputManager->printa_sf(thisAgent, "%s   %-%s\n", concatJustified("max-memory-usage", max_memory_usage->get_string(), 47).c_str(), "Halt if the agent's memory exceeds this (0: no limit)");
+    outputManager->printa_sf(thisAgent, "%s   %-%s\n", concatJustified("huge-pages", huge_pages->get_string(), 47).c_str(), "Back memory pools with node-local huge pages");
     outputManager->printa_sf(thisAgent, "%s   %-%s\n", concatJustified("max-gp", max_gp->get_string(), 47).c_str(), "Maximum rules gp can generate");
+    outputManager->printa_sf(thisAgent, "%s   %-%s\n", concatJustified("match-threads", match_threads->get_string(), 47).c_str(), "Threads used for alpha lookups of large WM batches");
+    outputManager->printa_sf(thisAgent, "%s   %-%s\n", concatJustified("match-batching", match_batching->get_string(), 47).c_str(), "Add large WM batches grouped by alpha memory");
+    outputManager->printa_sf(thisAgent, "%s   %-%s\n", concatJustified("pool-trim-interval", pool_trim_interval->get_string(), 47).c_str(), "Return free pool blocks every n decisions (0: never)");
     outputManager->printa_sf(thisAgent, "%s   %-%s\n", concatJustified("stop-phase", stop_phase->get_string(), 47).c_str(), "Phase before which Soar will stop");
     outputManager->printa_sf(thisAgent, "%s   %-%s\n", concatJustified("tcl", tcl_enabled->get_string(), 47).c_str(), "Allow Tcl code in commands");
     outputManager->printa_sf(thisAgent, "%s   %-%s\n", concatJustified("timers", timers_enabled->get_string(), 47).c_str(), "Profile where Soar spends its time");
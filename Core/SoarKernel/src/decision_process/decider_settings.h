@@ -25,6 +25,10 @@ class decider_param_container: public soar_module::param_container
         soar_module::integer_param* max_goal_depth;
         soar_module::integer_param* max_memory_usage;
         soar_module::integer_param* max_nil_output_cycles;
+        soar_module::integer_param* match_threads;
+        soar_module::boolean_param* match_batching;
+        soar_module::integer_param* pool_trim_interval;
+        soar_module::constant_param<Huge_page_modes>* huge_pages;
         soar_module::boolean_param* tcl_enabled;
         soar_module::boolean_param* timers_enabled;
         soar_module::boolean_param* wait_snc;
@@ -4,6 +4,7 @@
 #include "callback.h"
 #include "condition.h"
 #include "decide.h"
+#include "decider.h"
 #include "ebc.h"
 #include "episodic_memory.h"
 #include "instantiation.h"
@@ -14,12 +15,16 @@
 #include "print.h"
 #include "production.h"
 #include "reinforcement_learning.h"
+#include "rete_const_filter.h"
+#include "rete_profiler.h"
+#include "rete_worker_pool.h"
 #include "rhs_functions.h"
 #include "rhs.h"
 #include "run_soar.h"
 #include "semantic_memory.h"
 #include "smem_settings.h"
 #include "slot.h"
+#include "small_vector.h"
 #include "soar_TraceNames.h"
 #include "symbol.h"
 #include "test.h"
@@ -29,6 +34,17 @@
 #include <assert.h>
 #include <sstream>
 #include <stdlib.h>
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
 
 /*************************************************************************
  *
@@ -59,7 +75,9 @@
  * retractions.
  *
  * Add_wme_to_rete() and remove_wme_from_rete() inform the rete of changes
- * to WM.
+ * to WM.  Add_wmes_to_rete() adds a whole list of WMEs at once; with
+ * "soar match-threads" above 1, large batches have their alpha memory
+ * lookups done in parallel.
  *
  * P_node_to_conditions_and_nots() takes a p_node and (optionally) a
  * token/wme pair, and reconstructs the (optionally instantiated) LHS
@@ -322,6 +340,13 @@ inline void relink_to_right_mem(rete_node* node)
             (node)->b.posneg.alpha_mem_->beta_nodes = (node);
         }
     }
+    /* --- the alpha memory's constant test program hasn't seen this node
+       yet, so have it rebuilt before the next wme goes through it --- */
+    if (((node)->b.posneg.const_filter_slot == UNASSIGNED_CONST_FILTER_SLOT) &&
+            (node)->b.posneg.alpha_mem_->const_filter)
+    {
+        (node)->b.posneg.alpha_mem_->const_filter->mark_dirty();
+    }
 }
 
 /* This macro cannot be easily converted to an inline function.
@@ -400,6 +425,156 @@ inline unsigned mp_bnode_is_left_unlinked(rete_node* node)
     return ((node)->a.np.is_left_unlinked);
 }
 
+/* ----------------------------------------------------------------------
+
+             Structures and Declarations:  Double Unlinking
+
+   With plain left and right unlinking, a join node is always linked to
+   at least one of its memories.  A node that was left unlinked because
+   its alpha memory was empty stays linked to that alpha memory when its
+   left memory then goes empty too, and the next wme added to the alpha
+   memory gives it a null right activation.
+
+   Instead, when the left memory of a left-unlinked Pos or MP node goes
+   empty, the node is right unlinked as well, and put on its alpha
+   memory's list of doubly unlinked nodes.  While a node is on that list
+   both of its memories are empty, so whichever one fills first can
+   relink it without activating it:
+
+     - when the alpha memory gets a wme, all its doubly unlinked nodes
+       are relinked to the left (they stay right unlinked, their left
+       memories are still empty);
+     - when the left memory gets a token, its doubly unlinked children
+       are relinked to the right (they stay left unlinked, their alpha
+       memories are still empty).
+
+   A doubly unlinked node is marked right unlinked as usual, but the rest
+   of next_from_alpha_mem points to the next node on the list, and
+   prev_from_alpha_mem to the previous one.  Beta memories count their
+   doubly unlinked children, so they only look for them when there are
+   some.
+---------------------------------------------------------------------- */
+
+inline bool node_is_doubly_unlinked(rete_node* node)
+{
+    if (bnode_is_bottom_of_split_mp(node->node_type))
+    {
+        return node_is_right_unlinked(node) && node_is_left_unlinked(node);
+    }
+    if ((node->node_type == MP_BNODE) || (node->node_type == UNHASHED_MP_BNODE))
+    {
+        return node_is_right_unlinked(node) && mp_bnode_is_left_unlinked(node);
+    }
+    return false;
+}
+
+inline rete_node* next_doubly_unlinked_node(rete_node* node)
+{
+    return reinterpret_cast<rete_node*>(reinterpret_cast<uintptr_t>(node->b.posneg.next_from_alpha_mem) &
+                                        ~static_cast<uintptr_t>(1));
+}
+
+inline void set_next_doubly_unlinked_node(rete_node* node, rete_node* next)
+{
+    node->b.posneg.next_from_alpha_mem = reinterpret_cast<rete_node*>(reinterpret_cast<uintptr_t>(next) | 1);
+}
+
+/* --- Right unlinks a left-unlinked node whose left memory just went
+   empty, and puts it on its alpha memory's doubly unlinked list --- */
+inline void doubly_unlink_node(agent* thisAgent, rete_node* node)
+{
+    alpha_mem* am = node->b.posneg.alpha_mem_;
+
+    unlink_from_right_mem(node);
+    set_next_doubly_unlinked_node(node, am->doubly_unlinked_nodes);
+    node->b.posneg.prev_from_alpha_mem = NIL;
+    if (am->doubly_unlinked_nodes)
+    {
+        am->doubly_unlinked_nodes->b.posneg.prev_from_alpha_mem = node;
+    }
+    am->doubly_unlinked_nodes = node;
+    if (bnode_is_bottom_of_split_mp(node->node_type))
+    {
+        node->parent->b.mem.num_doubly_unlinked_children++;
+    }
+    thisAgent->num_double_unlinks++;
+}
+
+/* --- Takes a node off its alpha memory's doubly unlinked list; the node
+   is left right unlinked and left unlinked --- */
+inline void remove_from_doubly_unlinked_nodes(rete_node* node)
+{
+    rete_node* next, *prev;
+
+    next = next_doubly_unlinked_node(node);
+    prev = node->b.posneg.prev_from_alpha_mem;
+    if (next)
+    {
+        next->b.posneg.prev_from_alpha_mem = prev;
+    }
+    if (prev)
+    {
+        set_next_doubly_unlinked_node(prev, next);
+    }
+    else
+    {
+        node->b.posneg.alpha_mem_->doubly_unlinked_nodes = next;
+    }
+    mark_node_as_right_unlinked(node);
+    if (bnode_is_bottom_of_split_mp(node->node_type))
+    {
+        node->parent->b.mem.num_doubly_unlinked_children--;
+    }
+}
+
+/* --- The alpha memory is getting its first wme:  relinks its doubly
+   unlinked nodes to the left.  Each of them would have taken a null right
+   activation for this wme if it had been left linked to the alpha memory --- */
+inline void relink_doubly_unlinked_nodes_to_left(agent* thisAgent, alpha_mem* am)
+{
+    rete_node* node, *next;
+
+    for (node = am->doubly_unlinked_nodes; node != NIL; node = next)
+    {
+        next = next_doubly_unlinked_node(node);
+        mark_node_as_right_unlinked(node);
+        if (bnode_is_bottom_of_split_mp(node->node_type))
+        {
+            node->parent->b.mem.num_doubly_unlinked_children--;
+            relink_to_left_mem(node);
+        }
+        else
+        {
+            make_mp_bnode_left_linked(node);
+        }
+        thisAgent->num_null_activations_avoided_by_double_unlinking++;
+    }
+    am->doubly_unlinked_nodes = NIL;
+}
+
+/* --- The node's left memory is getting its first token:  relinks it to
+   the right --- */
+inline void relink_doubly_unlinked_node_to_right(rete_node* node)
+{
+    remove_from_doubly_unlinked_nodes(node);
+    relink_to_right_mem(node);
+}
+
+inline void relink_doubly_unlinked_children_to_right(rete_node* mem_node)
+{
+    rete_node* child;
+
+    for (child = mem_node->first_child;
+            (child != NIL) && mem_node->b.mem.num_doubly_unlinked_children;
+            child = child->next_sibling)
+    {
+        if (node_is_doubly_unlinked(child))
+        {
+            relink_doubly_unlinked_node_to_right(child);
+        }
+    }
+}
+
 /* ----------------------------------------------------------------------
 
                  Structures and Declarations:  Tokens
@@ -439,218 +614,739 @@ inline void new_left_token(token* New, rete_node* current_node,
 
             Structures and Declarations:  Memory Hash Tables
 
-   Tokens and alpha memory entries (right memory's) as stored in two
-   global hash tables.  Unlike most hash tables in Soar, these two tables
-   are not dynamically resized -- their size is fixed at compile-time.
+   Tokens and alpha memory entries (right memory's) are stored in two
+   per-agent hash tables.  Both tables are resized with the number of
+   items they hold:  they grow when the table holds more than twice as
+   many items as buckets, and shrink when it holds fewer than 1/8 as
+   many.
+
+   Resizing is done incrementally.  When a resize starts, the old bucket
+   array is kept around and a few old buckets are migrated into the new
+   array on each call to rete_ht_rehash_step().  An item whose old bucket
+   index is below rehash_position lives in the new array; all others still
+   live in the old array.  Every item with a given hash value shares the
+   same old bucket, so a bucket lookup always sees all candidates.
+
+   Migration relinks the bucket dll's, so it must never happen while a
+   join routine is walking a bucket.  rete_ht_rehash_step() is therefore
+   only called at the top-level entry points into the rete (WME addition
+   and removal, production addition and excision), never from within a
+   node activation.
+
+   With RETE_TOKEN_BLOCKS, each left_ht bucket instead points to a
+   token_block that keeps the node, hash referent and address of each of
+   its tokens in three parallel arrays.  A right activation then finds
+   its candidate tokens by scanning the node and referent arrays, and
+   only touches the tokens that actually belong to the node it is joining
+   against.  Tokens keep their own addresses (instantiations, ms_changes
+   and tree-based removal all point at them); only the bucket is
+   contiguous.
+
+   Removing a token from a block only clears its slot, since a join
+   routine further up the stack may be scanning the same block and must
+   not see the remaining slots move.  Blocks with cleared slots are
+   compacted at the same top-level entry points as the rehash steps.
+   Walks over a bucket go through first_token_in_left_ht() and
+   next_token_in_left_ht(), which work the same way in both
+   representations:  tokens added to the bucket during a walk are not
+   visited.
 ---------------------------------------------------------------------- */
 
 /* --- Hash table sizes (actual sizes are powers of 2) --- */
-#define LOG2_LEFT_HT_SIZE 14
-#define LOG2_RIGHT_HT_SIZE 14
-
-#define LEFT_HT_SIZE (1 << LOG2_LEFT_HT_SIZE)
-#define RIGHT_HT_SIZE (1 << LOG2_RIGHT_HT_SIZE)
+#define LOG2_MINIMUM_RETE_HT_SIZE 10
+#define LOG2_MAXIMUM_RETE_HT_SIZE 30
 
-#define LEFT_HT_MASK (LEFT_HT_SIZE - 1)
-#define RIGHT_HT_MASK (RIGHT_HT_SIZE - 1)
+/* --- minimum number of old buckets migrated per rehash step --- */
+#define RETE_HT_MIN_BUCKETS_PER_REHASH_STEP 64
 
-
-/* --- Given the hash value (hv), get contents of bucket header cell ---
-#define left_ht_bucket(hv) \
-  (* ( ((token **) thisAgent->left_ht) + ((hv) & LEFT_HT_MASK)))
-#define right_ht_bucket(hv) \
-  (* ( ((right_mem **) thisAgent->right_ht) + ((hv) & RIGHT_HT_MASK)))
-*/
-
-/* The return value is modified by the calling function,
-   hence the call by reference, */
-inline token*& left_ht_bucket(agent* thisAgent, uint32_t hv)
+inline void** rete_ht_header(rete_hash_table* ht, uint32_t hv)
 {
-    return * (reinterpret_cast<token**>(thisAgent->left_ht) + (hv & LEFT_HT_MASK));
+    if (ht->old_buckets && ((hv & ht->old_mask) >= ht->rehash_position))
+    {
+        return ht->old_buckets + (hv & ht->old_mask);
+    }
+    return ht->buckets + (hv & ht->mask);
 }
 
-inline right_mem* right_ht_bucket(agent* thisAgent, uint32_t hv)
+/* The return value is modified by the calling function,
+   hence the call by reference, */
+inline right_mem*& right_ht_bucket(agent* thisAgent, uint32_t hv)
 {
-    return * (reinterpret_cast<right_mem**>(thisAgent->right_ht) + (hv & RIGHT_HT_MASK));
+    return * reinterpret_cast<right_mem**>(rete_ht_header(thisAgent->right_ht, hv));
 }
 
-/*#define insert_token_into_left_ht(tok,hv) { \
-  token **header_zy37; \
-  header_zy37 = ((token **) thisAgent->left_ht) + ((hv) & LEFT_HT_MASK); \
-  insert_at_head_of_dll (*header_zy37, (tok), \
-                         a.ht.next_in_bucket, a.ht.prev_in_bucket); }*/
-inline void insert_token_into_left_ht(agent* thisAgent, token* tok, uint32_t hv)
+/* --- Recomputes the hash value a token was stored under.  Only CN nodes
+   (and the left tokens their partners create) hash on the parent token and
+   wme; everything else hashes on the node id and the hash referent. --- */
+inline uint32_t left_ht_hash_value_for_token(token* tok)
 {
-    token** header_zy37;
-    header_zy37 = reinterpret_cast<token**>(thisAgent->left_ht) + (hv & LEFT_HT_MASK);
-    insert_at_head_of_dll(*header_zy37, tok,
-                          a.ht.next_in_bucket, a.ht.prev_in_bucket);
+    if (tok->node->node_type == CN_BNODE)
+    {
+        return tok->node->node_id ^
+               cast_and_possibly_truncate<uint32_t>(tok->parent) ^
+               cast_and_possibly_truncate<uint32_t>(tok->w);
+    }
+    return tok->node->node_id ^ (tok->a.ht.referent ? tok->a.ht.referent->hash_id : 0);
 }
 
-/*#define remove_token_from_left_ht(tok,hv) { \
-  fast_remove_from_dll (left_ht_bucket(hv), tok, token, \
-                        a.ht.next_in_bucket, a.ht.prev_in_bucket); }*/
-inline void remove_token_from_left_ht(agent* thisAgent, token* tok, uint32_t hv)
+/* --- state of a walk over the tokens of one node in a left_ht bucket --- */
+typedef struct left_ht_scan_struct
 {
-    fast_remove_from_dll(left_ht_bucket(thisAgent, hv), tok, token,
-                         a.ht.next_in_bucket, a.ht.prev_in_bucket);
-}
-
-/* ----------------------------------------------------------------------
+    rete_node* node;
+    Symbol* referent;
+#ifdef RETE_TOKEN_BLOCKS
+    token_block* block;
+    uint32_t slot;              /* slots at or above this one have been looked at */
+#endif
+} left_ht_scan;
 
-       Structures and Declarations:  Beta Net Interpreter Routines
+#ifdef RETE_TOKEN_BLOCKS
 
----------------------------------------------------------------------- */
+#define INITIAL_TOKEN_BLOCK_CAPACITY 4
 
-void (*(left_addition_routines[256]))(agent* thisAgent, rete_node* node, token* tok, wme* w) =
-{
-    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
-};
-void (*(right_addition_routines[256]))(agent* thisAgent, rete_node* node, wme* w) =
+inline token_block*& left_ht_block(agent* thisAgent, uint32_t hv)
 {
-    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
-};
-
+    return * reinterpret_cast<token_block**>(rete_ht_header(thisAgent->left_ht, hv));
+}
 
-void remove_token_and_subtree(agent* thisAgent, token* tok);
+/* --- The three arrays of a block share one allocation.  Growing it moves
+   the arrays but never the block itself, so a block pointer stays valid
+   for as long as the block is in the table. --- */
+void grow_token_block(agent* thisAgent, token_block* b)
+{
+    uint32_t new_capacity;
+    rete_node** nodes;
+    Symbol** referents;
+    token** tokens;
 
-/* ----------------------------------------------------------------------
+    new_capacity = b->capacity ? (b->capacity << 1) : INITIAL_TOKEN_BLOCK_CAPACITY;
+    nodes = static_cast<rete_node**>(thisAgent->memoryManager->allocate_memory(
+                                         new_capacity * (sizeof(rete_node*) + sizeof(Symbol*) + sizeof(token*)),
+                                         HASH_TABLE_MEM_USAGE));
+    referents = reinterpret_cast<Symbol**>(nodes + new_capacity);
+    tokens = reinterpret_cast<token**>(referents + new_capacity);
 
-             Structures and Declarations:  Debugging Stuff
+    if (b->nodes)
+    {
+        memcpy(nodes, b->nodes, b->count * sizeof(rete_node*));
+        memcpy(referents, b->referents, b->count * sizeof(Symbol*));
+        memcpy(tokens, b->tokens, b->count * sizeof(token*));
+        thisAgent->memoryManager->free_memory(b->nodes, HASH_TABLE_MEM_USAGE);
+    }
+    b->nodes = nodes;
+    b->referents = referents;
+    b->tokens = tokens;
+    b->capacity = new_capacity;
+}
 
-   These get invoked at the entry and exit points of all node activation
-   procedures.  Good place to put debugging checks.
----------------------------------------------------------------------- */
+void free_token_block(agent* thisAgent, token_block* b)
+{
+    if (b->nodes)
+    {
+        thisAgent->memoryManager->free_memory(b->nodes, HASH_TABLE_MEM_USAGE);
+    }
+    thisAgent->memoryManager->free_memory(b, HASH_TABLE_MEM_USAGE);
+}
 
-/* Since these do nothing, I will not convert them to inline functions
-   for the time being. -ajc (5/6/02 */
-#define activation_entry_sanity_check() {}
-#define activation_exit_sanity_check() {}
+inline void append_token_to_block(agent* thisAgent, token_block* b, token* tok)
+{
+    if (b->count == b->capacity)
+    {
+        grow_token_block(thisAgent, b);
+    }
+    b->nodes[b->count] = tok->node;
+    b->referents[b->count] = tok->a.ht.referent;
+    b->tokens[b->count] = tok;
+    tok->a.ht.slot = b->count++;
+}
 
-/* ----------------------------------------------------------------------
+inline void insert_token_into_left_ht(agent* thisAgent, token* tok, uint32_t hv, Symbol* referent)
+{
+    token_block*& b = left_ht_block(thisAgent, hv);
+    if (!b)
+    {
+        b = static_cast<token_block*>(thisAgent->memoryManager->allocate_memory_and_zerofill(
+                                          sizeof(token_block), HASH_TABLE_MEM_USAGE));
+    }
+    tok->a.ht.referent = referent;
+    append_token_to_block(thisAgent, b, tok);
+    thisAgent->left_ht->count++;
+}
 
-         Structures and Declarations:  Null Activation Statistics
+inline void remove_token_from_left_ht(agent* thisAgent, token* tok, uint32_t hv)
+{
+    token_block* b = left_ht_block(thisAgent, hv);
 
-   Counts the number of null and non-null left activations.  Note that
-   this only tallies activations of join nodes for positive conditions;
-   negative nodes and CN stuff is ignored.
----------------------------------------------------------------------- */
+    b->nodes[tok->a.ht.slot] = NIL;
+    b->tokens[tok->a.ht.slot] = NIL;
+    if (b->num_removed++ == 0)
+    {
+        b->next_to_compact = thisAgent->left_ht->blocks_to_compact;
+        thisAgent->left_ht->blocks_to_compact = b;
+    }
+    thisAgent->left_ht->count--;
+}
 
-#ifdef NULL_ACTIVATION_STATS
+/* --- Moves a token to another node with the same node_id, as happens when
+   an MP node is split or merged --- */
+inline void change_token_node(agent* thisAgent, token* tok, rete_node* node)
+{
+    tok->node = node;
+    left_ht_block(thisAgent, left_ht_hash_value_for_token(tok))->nodes[tok->a.ht.slot] = node;
+}
 
-void null_activation_stats_for_right_activation(rete_node* node, rete_node* node_to_ignore_for_null_activation_stats)
+/* --- Squeezes the cleared slots out of every block that has any.  Only
+   safe when no join routine is walking a bucket (see above). --- */
+void compact_token_blocks(agent* thisAgent)
 {
-    if (node == node_to_ignore_for_activation_stats)
-    {
-        return;
-    }
-    switch (node->node_type)
+    token_block* b;
+    uint32_t i, j;
+
+    while ((b = thisAgent->left_ht->blocks_to_compact) != NIL)
     {
-        case POSITIVE_BNODE:
-        case UNHASHED_POSITIVE_BNODE:
-            thisAgent->num_right_activations++;
-            if (! node->parent->a.np.tokens)
+        thisAgent->left_ht->blocks_to_compact = b->next_to_compact;
+        b->next_to_compact = NIL;
+        for (i = j = 0; i < b->count; i++)
+        {
+            if (!b->nodes[i])
             {
-                thisAgent->num_null_right_activations++;
+                continue;
             }
-            break;
-        case MP_BNODE:
-        case UNHASHED_MP_BNODE:
-            thisAgent->num_right_activations++;
-            if (! node->a.np.tokens)
+            if (i != j)
             {
-                thisAgent->num_null_right_activations++;
+                b->nodes[j] = b->nodes[i];
+                b->referents[j] = b->referents[i];
+                b->tokens[j] = b->tokens[i];
+                b->tokens[j]->a.ht.slot = j;
             }
-            break;
+            j++;
+        }
+        b->count = j;
+        b->num_removed = 0;
     }
 }
 
-void null_activation_stats_for_left_activation(rete_node* node)
+/* --- Blocks are walked from the top down, which visits tokens newest first
+   just like the linked buckets do, so both representations produce match
+   set changes in the same order --- */
+inline token* find_token_in_left_ht_scan(left_ht_scan* scan)
 {
-    switch (node->node_type)
+    token_block* b = scan->block;
+    rete_node** nodes = b->nodes;
+    Symbol** referents = b->referents;
+    uint32_t i;
+
+    for (i = scan->slot; i-- > 0;)
     {
-        case POSITIVE_BNODE:
-        case UNHASHED_POSITIVE_BNODE:
-            thisAgent->num_left_activations++;
-            if (node->b.posneg.alpha_mem_->right_mems == NIL)
-            {
-                thisAgent->num_null_left_activations++;
-            }
-            break;
-        case MP_BNODE:
-        case UNHASHED_MP_BNODE:
-            if (mp_bnode_is_left_unlinked(node))
-            {
-                return;
-            }
-            thisAgent->num_left_activations++;
-            if (node->b.posneg.alpha_mem_->right_mems == NIL)
-            {
-                thisAgent->num_null_left_activations++;
-            }
-            break;
+        if ((nodes[i] == scan->node) && (referents[i] == scan->referent))
+        {
+            scan->slot = i;
+            return b->tokens[i];
+        }
     }
+    scan->slot = 0;
+    return NIL;
 }
 
-void print_null_activation_stats()
+/* --- Returns the first token of the given node and hash referent (NIL for
+   unhashed and CN nodes) in the bucket for hv, or NIL if there is none --- */
+inline token* first_token_in_left_ht(agent* thisAgent, left_ht_scan* scan, uint32_t hv,
+                                     rete_node* node, Symbol* referent)
 {
-    Output_Manager::Get_OM().print_sf("\nActivations: %u right (%u null), %u left (%u null)\n",
-          thisAgent->num_right_activations,
-          thisAgent->num_null_right_activations,
-          thisAgent->num_left_activations,
-          thisAgent->num_null_left_activations);
+    scan->node = node;
+    scan->referent = referent;
+    scan->block = left_ht_block(thisAgent, hv);
+    if (!scan->block)
+    {
+        return NIL;
+    }
+    scan->slot = scan->block->count;
+    return find_token_in_left_ht_scan(scan);
+}
+
+inline token* next_token_in_left_ht(left_ht_scan* scan, token* /*tok*/)
+{
+    return find_token_in_left_ht_scan(scan);
 }
 
 #else
 
-/* Since these do nothing, I will not convert them to inline functions
-   for the time being. -ajc (5/6/02 */
-#define null_activation_stats_for_right_activation(node) {}
-#define null_activation_stats_for_left_activation(node) {}
-#define print_null_activation_stats() {}
+inline token*& left_ht_bucket(agent* thisAgent, uint32_t hv)
+{
+    return * reinterpret_cast<token**>(rete_ht_header(thisAgent->left_ht, hv));
+}
 
-#endif
+inline void insert_token_into_left_ht(agent* thisAgent, token* tok, uint32_t hv, Symbol* referent)
+{
+    token*& header = left_ht_bucket(thisAgent, hv);
+    insert_at_head_of_dll(header, tok, a.ht.next_in_bucket, a.ht.prev_in_bucket);
+    tok->a.ht.referent = referent;
+    thisAgent->left_ht->count++;
+}
 
-/* ----------------------------------------------------------------------
+inline void remove_token_from_left_ht(agent* thisAgent, token* tok, uint32_t hv)
+{
+    token*& header = left_ht_bucket(thisAgent, hv);
+    fast_remove_from_dll(header, tok, token, a.ht.next_in_bucket, a.ht.prev_in_bucket);
+    thisAgent->left_ht->count--;
+}
 
-             Structures and Declarations:  Sharing Factors
+inline void change_token_node(agent* /*thisAgent*/, token* tok, rete_node* node)
+{
+    tok->node = node;
+}
 
-   Sharing factors are computed/updated using two simple rules:
-     (1)  Any time we add a new production to the net, when we get all
-     done and have created the p-node, etc., we increment the sharing
-     factor on every node the production uses.
-     (2) Any time we make a brand new node, we initialize its sharing
-     factor to 0.  (This will get incremented shortly thereafter, due
+inline token* find_token_in_left_ht_scan(left_ht_scan* scan, token* tok)
+{
+    for (; tok != NIL; tok = tok->a.ht.next_in_bucket)
+    {
+        if ((tok->node == scan->node) && (tok->a.ht.referent == scan->referent))
+        {
+            return tok;
+        }
+    }
+    return NIL;
+}
+
+inline token* first_token_in_left_ht(agent* thisAgent, left_ht_scan* scan, uint32_t hv,
+                                     rete_node* node, Symbol* referent)
+{
+    scan->node = node;
+    scan->referent = referent;
+    return find_token_in_left_ht_scan(scan, left_ht_bucket(thisAgent, hv));
+}
+
+inline token* next_token_in_left_ht(left_ht_scan* scan, token* tok)
+{
+    return find_token_in_left_ht_scan(scan, tok->a.ht.next_in_bucket);
+}
+
+#endif
+
+inline uint32_t right_ht_hash_value_for_rm(right_mem* rm)
+{
+    return rm->am->am_id ^ rm->w->id->hash_id;
+}
+
+void init_rete_hash_table(agent* thisAgent, rete_hash_table* ht)
+{
+    ht->log2size = LOG2_MINIMUM_RETE_HT_SIZE;
+    ht->size = static_cast<uint32_t>(1) << ht->log2size;
+    ht->mask = ht->size - 1;
+    ht->buckets = static_cast<void**>(thisAgent->memoryManager->allocate_memory_and_zerofill(
+                                          ht->size * sizeof(void*), HASH_TABLE_MEM_USAGE));
+    ht->old_buckets = NIL;
+    ht->old_size = 0;
+    ht->old_mask = 0;
+    ht->rehash_position = 0;
+    ht->count = 0;
+    ht->num_resizes = 0;
+#ifdef RETE_TOKEN_BLOCKS
+    ht->blocks_to_compact = NIL;
+#endif
+}
+
+void free_rete_hash_table(agent* thisAgent, rete_hash_table* ht)
+{
+#ifdef RETE_TOKEN_BLOCKS
+    uint32_t i;
+
+    if (ht == thisAgent->left_ht)
+    {
+        for (i = 0; i < ht->size; i++)
+        {
+            if (ht->buckets[i])
+            {
+                free_token_block(thisAgent, static_cast<token_block*>(ht->buckets[i]));
+            }
+        }
+        for (i = 0; ht->old_buckets && (i < ht->old_size); i++)
+        {
+            if (ht->old_buckets[i])
+            {
+                free_token_block(thisAgent, static_cast<token_block*>(ht->old_buckets[i]));
+            }
+        }
+        ht->blocks_to_compact = NIL;
+    }
+#endif
+    if (ht->old_buckets)
+    {
+        thisAgent->memoryManager->free_memory(ht->old_buckets, HASH_TABLE_MEM_USAGE);
+        ht->old_buckets = NIL;
+    }
+    thisAgent->memoryManager->free_memory(ht->buckets, HASH_TABLE_MEM_USAGE);
+    ht->buckets = NIL;
+}
+
+/* --- Starts an incremental resize if the load is outside of its bounds.
+   The new size is picked so that the table ends up with about one item per
+   bucket, which may be several doublings away from the current size. --- */
+void start_rete_ht_resize_if_needed(agent* thisAgent, rete_hash_table* ht)
+{
+    short new_log2size;
+
+    if (ht->count > (static_cast<uint64_t>(ht->size) << 1))
+    {
+        if (ht->log2size >= LOG2_MAXIMUM_RETE_HT_SIZE)
+        {
+            return;
+        }
+    }
+    else if ((ht->count >= (ht->size >> 3)) || (ht->log2size <= LOG2_MINIMUM_RETE_HT_SIZE))
+    {
+        return;
+    }
+
+    new_log2size = LOG2_MINIMUM_RETE_HT_SIZE;
+    while ((new_log2size < LOG2_MAXIMUM_RETE_HT_SIZE) &&
+            ((static_cast<uint64_t>(1) << new_log2size) < ht->count))
+    {
+        new_log2size++;
+    }
+    if (new_log2size == ht->log2size)
+    {
+        return;
+    }
+
+    ht->old_buckets = ht->buckets;
+    ht->old_size = ht->size;
+    ht->old_mask = ht->mask;
+    ht->rehash_position = 0;
+
+    ht->log2size = new_log2size;
+    ht->size = static_cast<uint32_t>(1) << new_log2size;
+    ht->mask = ht->size - 1;
+    ht->buckets = static_cast<void**>(thisAgent->memoryManager->allocate_memory_and_zerofill(
+                                          ht->size * sizeof(void*), HASH_TABLE_MEM_USAGE));
+    ht->num_resizes++;
+}
+
+/* --- Migrates a batch of old buckets into the new bucket array, starting a
+   resize first if needed.  The batch size scales with the old table so that
+   a rehash always completes within a bounded number of steps. --- */
+void rete_ht_rehash_step(agent* thisAgent, rete_hash_table* ht, bool is_left_ht)
+{
+    uint32_t buckets_to_move, hv;
+    void** new_header;
+    token* tok;
+    right_mem* rm, *next_rm;
+#ifdef RETE_TOKEN_BLOCKS
+    token_block* old_block, *new_block;
+    uint32_t i;
+#else
+    token* next_tok;
+#endif
+
+    if (!ht->old_buckets)
+    {
+        start_rete_ht_resize_if_needed(thisAgent, ht);
+        if (!ht->old_buckets)
+        {
+            return;
+        }
+    }
+
+    buckets_to_move = ht->old_size >> 6;
+    if (buckets_to_move < RETE_HT_MIN_BUCKETS_PER_REHASH_STEP)
+    {
+        buckets_to_move = RETE_HT_MIN_BUCKETS_PER_REHASH_STEP;
+    }
+
+    while (buckets_to_move-- && (ht->rehash_position < ht->old_size))
+    {
+        if (is_left_ht)
+        {
+#ifdef RETE_TOKEN_BLOCKS
+            /* --- blocks were compacted before this step, so every slot
+               holds a live token.  Moving them newest first leaves them in
+               the same order the linked buckets would end up in. --- */
+            old_block = static_cast<token_block*>(ht->old_buckets[ht->rehash_position]);
+            for (i = old_block ? old_block->count : 0; i-- > 0;)
+            {
+                tok = old_block->tokens[i];
+                hv = left_ht_hash_value_for_token(tok);
+                new_header = ht->buckets + (hv & ht->mask);
+                new_block = static_cast<token_block*>(*new_header);
+                if (!new_block)
+                {
+                    new_block = static_cast<token_block*>(thisAgent->memoryManager->allocate_memory_and_zerofill(
+                                                              sizeof(token_block), HASH_TABLE_MEM_USAGE));
+                    *new_header = new_block;
+                }
+                append_token_to_block(thisAgent, new_block, tok);
+            }
+            if (old_block)
+            {
+                free_token_block(thisAgent, old_block);
+            }
+#else
+            for (tok = static_cast<token*>(ht->old_buckets[ht->rehash_position]); tok != NIL; tok = next_tok)
+            {
+                next_tok = tok->a.ht.next_in_bucket;
+                hv = left_ht_hash_value_for_token(tok);
+                new_header = ht->buckets + (hv & ht->mask);
+                insert_at_head_of_dll(*reinterpret_cast<token**>(new_header), tok,
+                                      a.ht.next_in_bucket, a.ht.prev_in_bucket);
+            }
+#endif
+        }
+        else
+        {
+            for (rm = static_cast<right_mem*>(ht->old_buckets[ht->rehash_position]); rm != NIL; rm = next_rm)
+            {
+                next_rm = rm->next_in_bucket;
+                hv = right_ht_hash_value_for_rm(rm);
+                new_header = ht->buckets + (hv & ht->mask);
+                insert_at_head_of_dll(*reinterpret_cast<right_mem**>(new_header), rm,
+                                      next_in_bucket, prev_in_bucket);
+            }
+        }
+        ht->old_buckets[ht->rehash_position] = NIL;
+        ht->rehash_position++;
+    }
+
+    if (ht->rehash_position >= ht->old_size)
+    {
+        thisAgent->memoryManager->free_memory(ht->old_buckets, HASH_TABLE_MEM_USAGE);
+        ht->old_buckets = NIL;
+        ht->old_size = 0;
+        ht->old_mask = 0;
+        ht->rehash_position = 0;
+    }
+}
+
+/* --- Called at the top-level entry points into the rete (see above) --- */
+inline void rete_hash_tables_rehash_step(agent* thisAgent)
+{
+#ifdef RETE_TOKEN_BLOCKS
+    compact_token_blocks(thisAgent);
+#endif
+    rete_ht_rehash_step(thisAgent, thisAgent->left_ht, true);
+    rete_ht_rehash_step(thisAgent, thisAgent->right_ht, false);
+}
+
+/* ----------------------------------------------------------------------
+
+       Structures and Declarations:  Beta Net Interpreter Routines
+
+---------------------------------------------------------------------- */
+
+void (*(left_addition_routines[256]))(agent* thisAgent, rete_node* node, token* tok, wme* w) =
+{
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+};
+void (*(right_addition_routines[256]))(agent* thisAgent, rete_node* node, wme* w) =
+{
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+};
+
+/* --- Null activations, as counted by the profiler:  a right activation
+   of a join node whose left memory is empty, or a left activation of a
+   join node whose alpha memory is empty --- */
+inline bool right_activation_is_null(rete_node* node)
+{
+    if (bnode_is_bottom_of_split_mp(node->node_type))
+    {
+        return (node->parent->a.np.tokens == NIL);
+    }
+    return (node->a.np.tokens == NIL);
+}
+
+inline bool left_activation_is_null(rete_node* node)
+{
+    /* --- P_BNODE has the positive bit set too, but no alpha memory --- */
+    return (node->node_type != P_BNODE) && bnode_is_posneg(node->node_type) &&
+           (node->b.posneg.alpha_mem_->right_mems == NIL);
+}
+
+/* --- Every left and right addition is dispatched through these two, so
+   that the profiler (see rete_profiler.h) sees each one while it's on --- */
+inline void do_left_addition(agent* thisAgent, rete_node* node, token* tok, wme* w)
+{
+    Rete_Profiler::activation_frame frame;
+
+    if (! thisAgent->reteProfiler)
+    {
+        (*(left_addition_routines[node->node_type]))(thisAgent, node, tok, w);
+        return;
+    }
+    thisAgent->reteProfiler->start_activation(node, false, left_activation_is_null(node), frame);
+    (*(left_addition_routines[node->node_type]))(thisAgent, node, tok, w);
+    thisAgent->reteProfiler->end_activation(frame);
+}
+
+inline void do_right_addition(agent* thisAgent, rete_node* node, wme* w)
+{
+    Rete_Profiler::activation_frame frame;
+
+    if (! thisAgent->reteProfiler)
+    {
+        (*(right_addition_routines[node->node_type]))(thisAgent, node, w);
+        return;
+    }
+    thisAgent->reteProfiler->start_activation(node, true, right_activation_is_null(node), frame);
+    (*(right_addition_routines[node->node_type]))(thisAgent, node, w);
+    thisAgent->reteProfiler->end_activation(frame);
+}
+
+/* --- Beta memories call their positive join children directly instead of
+   going through left_addition_routines (the call takes the hash referent
+   the memory already computed), so they wrap that call in this --- */
+template <typename left_addition>
+inline void do_positive_left_addition(agent* thisAgent, rete_node* node, left_addition pAddition)
+{
+    Rete_Profiler::activation_frame frame;
+
+    if (! thisAgent->reteProfiler)
+    {
+        pAddition();
+        return;
+    }
+    thisAgent->reteProfiler->start_activation(node, false, left_activation_is_null(node), frame);
+    pAddition();
+    thisAgent->reteProfiler->end_activation(frame);
+}
+
+void remove_token_and_subtree(agent* thisAgent, token* tok);
+
+/* ----------------------------------------------------------------------
+
+             Structures and Declarations:  Debugging Stuff
+
+   These get invoked at the entry and exit points of all node activation
+   procedures.  Good place to put debugging checks.
+---------------------------------------------------------------------- */
+
+/* Since these do nothing, I will not convert them to inline functions
+   for the time being. -ajc (5/6/02 */
+#define activation_entry_sanity_check() {}
+#define activation_exit_sanity_check() {}
+
+/* ----------------------------------------------------------------------
+
+         Structures and Declarations:  Null Activation Statistics
+
+   Counts the number of null and non-null left activations.  Note that
+   this only tallies activations of join nodes for positive conditions;
+   negative nodes and CN stuff is ignored.
+---------------------------------------------------------------------- */
+
+#ifdef NULL_ACTIVATION_STATS
+
+void null_activation_stats_for_right_activation(rete_node* node, rete_node* node_to_ignore_for_null_activation_stats)
+{
+    if (node == node_to_ignore_for_activation_stats)
+    {
+        return;
+    }
+    switch (node->node_type)
+    {
+        case POSITIVE_BNODE:
+        case UNHASHED_POSITIVE_BNODE:
+            thisAgent->num_right_activations++;
+            if (! node->parent->a.np.tokens)
+            {
+                thisAgent->num_null_right_activations++;
+            }
+            break;
+        case MP_BNODE:
+        case UNHASHED_MP_BNODE:
+            thisAgent->num_right_activations++;
+            if (! node->a.np.tokens)
+            {
+                thisAgent->num_null_right_activations++;
+            }
+            break;
+    }
+}
+
+void null_activation_stats_for_left_activation(rete_node* node)
+{
+    switch (node->node_type)
+    {
+        case POSITIVE_BNODE:
+        case UNHASHED_POSITIVE_BNODE:
+            thisAgent->num_left_activations++;
+            if (node->b.posneg.alpha_mem_->right_mems == NIL)
+            {
+                thisAgent->num_null_left_activations++;
+            }
+            break;
+        case MP_BNODE:
+        case UNHASHED_MP_BNODE:
+            if (mp_bnode_is_left_unlinked(node))
+            {
+                return;
+            }
+            thisAgent->num_left_activations++;
+            if (node->b.posneg.alpha_mem_->right_mems == NIL)
+            {
+                thisAgent->num_null_left_activations++;
+            }
+            break;
+    }
+}
+
+void print_null_activation_stats()
+{
+    Output_Manager::Get_OM().print_sf("\nActivations: %u right (%u null), %u left (%u null)\n",
+          thisAgent->num_right_activations,
+          thisAgent->num_null_right_activations,
+          thisAgent->num_left_activations,
+          thisAgent->num_null_left_activations);
+}
+
+#else
+
+/* Since these do nothing, I will not convert them to inline functions
+   for the time being. -ajc (5/6/02 */
+#define null_activation_stats_for_right_activation(node) {}
+#define null_activation_stats_for_left_activation(node) {}
+#define print_null_activation_stats() {}
+
+#endif
+
+/* ----------------------------------------------------------------------
+
+             Structures and Declarations:  Sharing Factors
+
+   Sharing factors are computed/updated using two simple rules:
+     (1)  Any time we add a new production to the net, when we get all
+     done and have created the p-node, etc., we increment the sharing
+     factor on every node the production uses.
+     (2) Any time we make a brand new node, we initialize its sharing
+     factor to 0.  (This will get incremented shortly thereafter, due
      to rule #1.)
 
    Note that there are fancy ways to compute/update sharing factors,
@@ -727,15 +1423,25 @@ inline uint64_t real_sharing_factor(rete_node* node)
 /*#define token_added(node) { \
   thisAgent->token_additions++; \
   thisAgent->token_additions_without_sharing += real_sharing_factor(node);}*/
-inline void token_added(rete_node* node)
+inline void token_added(agent* thisAgent, rete_node* node)
 {
     thisAgent->token_additions++;
     thisAgent->token_additions_without_sharing += real_sharing_factor(node);
+    if (thisAgent->reteProfiler)
+    {
+        thisAgent->reteProfiler->token_created(node);
+    }
 }
 
 #else
 
-#define token_added(node) {}
+inline void token_added(agent* thisAgent, rete_node* node)
+{
+    if (thisAgent->reteProfiler)
+    {
+        thisAgent->reteProfiler->token_created(node);
+    }
+}
 
 #endif
 
@@ -1222,6 +1928,17 @@ uint32_t hash_alpha_mem(void* item, short num_bits)
     return alpha_hash_value(am->id, am->attr, am->value, num_bits);
 }
 
+/* --- Batches smaller than this are never split across match threads;
+   the hand-off costs more than the alpha lookups it would save. --- */
+#define MIN_WMES_FOR_PARALLEL_ALPHA_MATCH 256
+
+/* --- Batches smaller than this are never grouped by alpha memory --- */
+#define MIN_WMES_FOR_GROUPED_ALPHA_MATCH 64
+
+/* --- Alpha memories used by fewer beta nodes than this never get a
+   constant test program; calling each node is cheap enough. --- */
+#define MIN_NODES_FOR_CONST_FILTER 8
+
 /* --- Which of the 16 hash tables to use? --- */
 /*#define table_for_tests(id,attr,value,acceptable) \
   thisAgent->alpha_hash_tables [ ((id) ? 1 : 0) + ((attr) ? 2 : 0) + \
@@ -1246,7 +1963,7 @@ inline uint32_t get_next_alpha_mem_id(agent* thisAgent)
    inform any successors --- */
 void add_wme_to_alpha_mem(agent* thisAgent, wme* w, alpha_mem* am)
 {
-    right_mem** header, *rm;
+    right_mem* rm;
     uint32_t hv;
 
     /* --- allocate new right_mem, fill it fields --- */
@@ -1256,8 +1973,9 @@ void add_wme_to_alpha_mem(agent* thisAgent, wme* w, alpha_mem* am)
 
     /* --- add it to dll's for the hash bucket, alpha mem, and wme --- */
     hv = am->am_id ^ w->id->hash_id;
-    header = reinterpret_cast<right_mem**>(thisAgent->right_ht) + (hv & RIGHT_HT_MASK);
-    insert_at_head_of_dll(*header, rm, next_in_bucket, prev_in_bucket);
+    right_mem*& header = right_ht_bucket(thisAgent, hv);
+    insert_at_head_of_dll(header, rm, next_in_bucket, prev_in_bucket);
+    thisAgent->right_ht->count++;
     insert_at_head_of_dll(am->right_mems, rm, next_in_am, prev_in_am);
     insert_at_head_of_dll(w->right_mems, rm, next_from_wme, prev_from_wme);
 }
@@ -1269,15 +1987,15 @@ void remove_wme_from_alpha_mem(agent* thisAgent, right_mem* rm)
     wme* w;
     alpha_mem* am;
     uint32_t hv;
-    right_mem** header;
 
     w = rm->w;
     am = rm->am;
 
     /* --- remove it from dll's for the hash bucket, alpha mem, and wme --- */
     hv = am->am_id ^ w->id->hash_id;
-    header = reinterpret_cast<right_mem**>(thisAgent->right_ht) + (hv & RIGHT_HT_MASK);
-    remove_from_dll(*header, rm, next_in_bucket, prev_in_bucket);
+    right_mem*& header = right_ht_bucket(thisAgent, hv);
+    remove_from_dll(header, rm, next_in_bucket, prev_in_bucket);
+    thisAgent->right_ht->count--;
     remove_from_dll(am->right_mems, rm, next_in_am, prev_in_am);
     remove_from_dll(w->right_mems, rm, next_from_wme, prev_from_wme);
 
@@ -1330,7 +2048,9 @@ alpha_mem* find_or_make_alpha_mem(agent* thisAgent, Symbol* id, Symbol* attr,
     am->right_mems = NIL;
     am->beta_nodes = NIL;
     am->last_beta_node = NIL;
+    am->doubly_unlinked_nodes = NIL;
     am->reference_count = 1;
+    am->const_filter = NIL;
     am->id = id;
     if (id)
     {
@@ -1384,12 +2104,11 @@ alpha_mem* find_or_make_alpha_mem(agent* thisAgent, Symbol* id, Symbol* attr,
 }
 
 /* --- Using the given hash table and hash value, try to find a
-   matching alpha memory in the indicated hash bucket.  If we find one,
-   we add the wme to it and inform successor nodes. --- */
-void add_wme_to_aht(agent* thisAgent, hash_table* ht, uint32_t hash_value, wme* w)
+   matching alpha memory in the indicated hash bucket.  This only reads
+   the alpha network, so it may be called from the match worker threads. --- */
+inline alpha_mem* find_alpha_mem_for_wme_in_aht(hash_table* ht, uint32_t hash_value, wme* w)
 {
     alpha_mem* am;
-    rete_node* node, *next;
 
     hash_value = hash_value & masks_for_n_low_order_bits[ht->log2size];
     am = reinterpret_cast<alpha_mem*>(*(ht->buckets + hash_value));
@@ -1397,18 +2116,65 @@ void add_wme_to_aht(agent* thisAgent, hash_table* ht, uint32_t hash_value, wme*
     {
         if (wme_matches_alpha_mem(w, am))
         {
-            /* --- found the right alpha memory, first add the wme --- */
-            add_wme_to_alpha_mem(thisAgent, w, am);
+            return am; /* only one possible alpha memory per table could match */
+        }
+        am = am->next_in_hash_table;
+    }
+    return NIL;
+}
 
-            /* --- now call the beta nodes --- */
-            for (node = am->beta_nodes; node != NIL; node = next)
-            {
-                next = node->b.posneg.next_from_alpha_mem;
-                (*(right_addition_routines[node->node_type]))(thisAgent, node, w);
-            }
-            return; /* only one possible alpha memory per table could match */
+Rete_Const_Filter* const_filter_for_alpha_mem(agent* thisAgent, alpha_mem* am);
+void run_const_filter(agent* thisAgent, Rete_Const_Filter* filter, wme* w);
+
+/* --- A right activation that fails a constant test finds no matches,
+   but positive and mp nodes also use it to relink themselves to their
+   left memory (and possibly unlink from the right).  It can only be
+   skipped when there is no such bookkeeping to do. --- */
+inline bool right_activation_is_skippable(rete_node* node)
+{
+    if (bnode_is_negative(node->node_type))
+    {
+        return true;
+    }
+    if (bnode_is_bottom_of_split_mp(node->node_type))
+    {
+        return ! node_is_left_unlinked(node);
+    }
+    return ! mp_bnode_is_left_unlinked(node);
+}
+
+/* --- Adds the wme to an alpha memory it is known to match and informs
+   successor nodes.  If the alpha memory has a constant test program,
+   nodes whose constant tests the wme fails are not called. --- */
+void add_wme_to_matching_alpha_mem(agent* thisAgent, alpha_mem* am, wme* w)
+{
+    rete_node* node, *next;
+    Rete_Const_Filter* filter;
+
+    /* --- first add the wme --- */
+    if (am->doubly_unlinked_nodes)
+    {
+        relink_doubly_unlinked_nodes_to_left(thisAgent, am);
+    }
+    add_wme_to_alpha_mem(thisAgent, w, am);
+
+    filter = const_filter_for_alpha_mem(thisAgent, am);
+    if (filter)
+    {
+        run_const_filter(thisAgent, filter, w);
+    }
+
+    /* --- now call the beta nodes --- */
+    for (node = am->beta_nodes; node != NIL; node = next)
+    {
+        next = node->b.posneg.next_from_alpha_mem;
+        if (filter && (! filter->verdict(node->b.posneg.const_filter_slot)) &&
+                right_activation_is_skippable(node))
+        {
+            thisAgent->num_const_filter_skipped_activations++;
+            continue;
         }
-        am = am->next_in_hash_table;
+        do_right_addition(thisAgent, node, w);
     }
 }
 
@@ -1419,10 +2185,34 @@ inline uint32_t xor_op(uint32_t i, uint32_t a, uint32_t v)
     return ((i) ^ (a) ^ (v));
 }
 
-/* --- Adds a WME to the Rete. --- */
-void add_wme_to_rete(agent* thisAgent, wme* w)
+/* --- Finds the alpha_mem (or NIL) for w in each of the 8 possible tables
+   for its acceptable flag.  Read-only, like find_alpha_mem_for_wme_in_aht(). --- */
+inline void find_alpha_mems_for_wme(agent* thisAgent, wme* w, alpha_mem** ams)
 {
     uint32_t hi, ha, hv;
+    hash_table** tables;
+
+    hi = w->id->hash_id;
+    ha = w->attr->hash_id;
+    hv = w->value->hash_id;
+
+    tables = thisAgent->alpha_hash_tables + (w->acceptable ? 8 : 0);
+
+    ams[0] = find_alpha_mem_for_wme_in_aht(tables[0], xor_op(0, 0, 0), w);
+    ams[1] = find_alpha_mem_for_wme_in_aht(tables[1], xor_op(hi, 0, 0), w);
+    ams[2] = find_alpha_mem_for_wme_in_aht(tables[2], xor_op(0, ha, 0), w);
+    ams[3] = find_alpha_mem_for_wme_in_aht(tables[3], xor_op(hi, ha, 0), w);
+    ams[4] = find_alpha_mem_for_wme_in_aht(tables[4], xor_op(0, 0, hv), w);
+    ams[5] = find_alpha_mem_for_wme_in_aht(tables[5], xor_op(hi, 0, hv), w);
+    ams[6] = find_alpha_mem_for_wme_in_aht(tables[6], xor_op(0, ha, hv), w);
+    ams[7] = find_alpha_mem_for_wme_in_aht(tables[7], xor_op(hi, ha, hv), w);
+}
+
+/* --- Links a new WME into all_wmes_in_rete.  Must be done before the WME
+   is added to any alpha memory. --- */
+inline void start_wme_addition_to_rete(agent* thisAgent, wme* w)
+{
+    rete_hash_tables_rehash_step(thisAgent);
 
     /* --- add w to all_wmes_in_rete --- */
     insert_at_head_of_dll(thisAgent->all_wmes_in_rete, w, rete_next, rete_prev);
@@ -1431,36 +2221,17 @@ void add_wme_to_rete(agent* thisAgent, wme* w)
     /* --- it's not in any right memories or tokens yet --- */
     w->right_mems = NIL;
     w->tokens = NIL;
+}
 
-    /* --- add w to the appropriate alpha_mem in each of 8 possible tables --- */
-    hi = w->id->hash_id;
-    ha = w->attr->hash_id;
-    hv = w->value->hash_id;
-
-    if (w->acceptable)
-    {
-        add_wme_to_aht(thisAgent, thisAgent->alpha_hash_tables[8],  xor_op(0, 0, 0), w);
-        add_wme_to_aht(thisAgent, thisAgent->alpha_hash_tables[9],  xor_op(hi, 0, 0), w);
-        add_wme_to_aht(thisAgent, thisAgent->alpha_hash_tables[10], xor_op(0, ha, 0), w);
-        add_wme_to_aht(thisAgent, thisAgent->alpha_hash_tables[11], xor_op(hi, ha, 0), w);
-        add_wme_to_aht(thisAgent, thisAgent->alpha_hash_tables[12], xor_op(0, 0, hv), w);
-        add_wme_to_aht(thisAgent, thisAgent->alpha_hash_tables[13], xor_op(hi, 0, hv), w);
-        add_wme_to_aht(thisAgent, thisAgent->alpha_hash_tables[14], xor_op(0, ha, hv), w);
-        add_wme_to_aht(thisAgent, thisAgent->alpha_hash_tables[15], xor_op(hi, ha, hv), w);
-    }
-    else
+/* --- Epmem bookkeeping for a WME once it has been matched. --- */
+inline void finish_wme_addition_to_rete(agent* thisAgent, wme* w)
+{
+    /* --- a new wme has no cold record, and so no epmem id, yet --- */
+    if (w->cold)
     {
-        add_wme_to_aht(thisAgent, thisAgent->alpha_hash_tables[0],  xor_op(0, 0, 0), w);
-        add_wme_to_aht(thisAgent, thisAgent->alpha_hash_tables[1],  xor_op(hi, 0, 0), w);
-        add_wme_to_aht(thisAgent, thisAgent->alpha_hash_tables[2],  xor_op(0, ha, 0), w);
-        add_wme_to_aht(thisAgent, thisAgent->alpha_hash_tables[3],  xor_op(hi, ha, 0), w);
-        add_wme_to_aht(thisAgent, thisAgent->alpha_hash_tables[4],  xor_op(0, 0, hv), w);
-        add_wme_to_aht(thisAgent, thisAgent->alpha_hash_tables[5],  xor_op(hi, 0, hv), w);
-        add_wme_to_aht(thisAgent, thisAgent->alpha_hash_tables[6],  xor_op(0, ha, hv), w);
-        add_wme_to_aht(thisAgent, thisAgent->alpha_hash_tables[7],  xor_op(hi, ha, hv), w);
+        w->cold->epmem_id = EPMEM_NODEID_BAD;
+        w->cold->epmem_valid = NIL;
     }
-    w->epmem_id = EPMEM_NODEID_BAD;
-    w->epmem_valid = NIL;
     {
         if (thisAgent->EpMem->epmem_db->get_status() == soar_module::connected)
         {
@@ -1487,6 +2258,213 @@ void add_wme_to_rete(agent* thisAgent, wme* w)
     }
 }
 
+/* --- Adds a WME to the Rete, given the alpha memories it belongs in.  The
+   alpha network is only changed by production addition and excision, so
+   alpha memories looked up before any of the WMEs in a batch were added
+   are still the right ones. --- */
+void add_wme_to_rete_using_alpha_mems(agent* thisAgent, wme* w, alpha_mem** ams)
+{
+    start_wme_addition_to_rete(thisAgent, w);
+
+    /* --- add w to the appropriate alpha_mem in each of 8 possible tables --- */
+    for (int i = 0; i < 8; i++)
+    {
+        if (ams[i])
+        {
+            add_wme_to_matching_alpha_mem(thisAgent, ams[i], w);
+        }
+    }
+
+    finish_wme_addition_to_rete(thisAgent, w);
+}
+
+/* --- Adds a WME to the Rete. --- */
+void add_wme_to_rete(agent* thisAgent, wme* w)
+{
+    alpha_mem* ams[8];
+
+    find_alpha_mems_for_wme(thisAgent, w, ams);
+    add_wme_to_rete_using_alpha_mems(thisAgent, w, ams);
+}
+
+/* --- Turns the rete profiler on or off; turning it off discards what it
+   has collected --- */
+void set_rete_profiling(agent* thisAgent, bool enabled)
+{
+    if (enabled && ! thisAgent->reteProfiler)
+    {
+        thisAgent->reteProfiler = new Rete_Profiler();
+    }
+    else if (! enabled && thisAgent->reteProfiler)
+    {
+        delete thisAgent->reteProfiler;
+        thisAgent->reteProfiler = NIL;
+    }
+}
+
+/* --- Sets the number of threads used by add_wmes_to_rete().  The worker
+   pool is created the first time more than one thread is requested. --- */
+void set_rete_match_threads(agent* thisAgent, uint64_t num_threads)
+{
+    if (thisAgent->reteWorkerPool)
+    {
+        thisAgent->reteWorkerPool->set_num_threads(num_threads);
+    }
+    else if (num_threads > 1)
+    {
+        thisAgent->reteWorkerPool = new Rete_Worker_Pool(num_threads);
+    }
+}
+
+/* --- One (alpha memory, wme) insertion in a grouped batch.  Batch_index
+   is the position of the wme in the batch; it keeps the sort stable. --- */
+typedef struct alpha_mem_insertion_struct
+{
+    alpha_mem*  am;
+    wme*        w;
+    size_t      batch_index;
+} alpha_mem_insertion;
+
+inline bool alpha_mem_insertion_precedes(const alpha_mem_insertion& a, const alpha_mem_insertion& b)
+{
+    if (a.am->am_id != b.am->am_id)
+    {
+        return a.am->am_id < b.am->am_id;
+    }
+    return a.batch_index < b.batch_index;
+}
+
+/* --- Adds a batch of WMEs whose alpha memories have already been found,
+   grouping the insertions by alpha memory.  Each (wme, alpha memory)
+   insertion is still followed immediately by the right activations it
+   causes, which is what keeps the match correct:  a join never sees a
+   wme in its right memory that it has not yet been activated with.  Only
+   the order of the insertions changes, so all the right activations for
+   one alpha memory run back to back over the same beta_nodes list and
+   right_mem chains.
+
+   Because the order of insertions changes, so does the order of the
+   resulting match set changes.  That is why grouping is only used when
+   "soar match-batching" is on. --- */
+void add_wme_batch_to_rete_grouped_by_alpha_mem(agent* thisAgent, std::vector<wme*>& batch, std::vector<alpha_mem*>& ams)
+{
+    std::vector<alpha_mem_insertion> insertions;
+    alpha_mem_insertion insertion;
+    size_t i, j;
+
+    insertions.reserve(batch.size() * 2);
+    for (i = 0; i < batch.size(); i++)
+    {
+        for (j = 0; j < 8; j++)
+        {
+            if (ams[i * 8 + j])
+            {
+                insertion.am = ams[i * 8 + j];
+                insertion.w = batch[i];
+                insertion.batch_index = i;
+                insertions.push_back(insertion);
+            }
+        }
+    }
+    std::sort(insertions.begin(), insertions.end(), alpha_mem_insertion_precedes);
+
+    for (i = 0; i < batch.size(); i++)
+    {
+        start_wme_addition_to_rete(thisAgent, batch[i]);
+    }
+    for (i = 0; i < insertions.size(); i++)
+    {
+        add_wme_to_matching_alpha_mem(thisAgent, insertions[i].am, insertions[i].w);
+    }
+    for (i = 0; i < batch.size(); i++)
+    {
+        finish_wme_addition_to_rete(thisAgent, batch[i]);
+    }
+
+    thisAgent->num_grouped_match_batches++;
+    thisAgent->num_grouped_match_wmes += batch.size();
+}
+
+/* --- Adds a list of WMEs to the Rete.  This is the entry point used for
+   all buffered working memory additions, including input-link changes.
+
+   When the agent has a match worker pool and the batch is large enough,
+   the alpha memory lookups for all WMEs are split across the pool first.
+   Everything that modifies the network -- right memories, tokens, match
+   set changes -- is always done on this thread.
+
+   With "soar match-batching" off (the default), WMEs are then added in
+   list order, wme by wme and table by table, so the resulting ms_change
+   lists are identical to adding them one at a time.  With it on, large
+   batches are added grouped by alpha memory instead (see above). --- */
+void add_wmes_to_rete(agent* thisAgent, cons* wmes)
+{
+    cons* c;
+    size_t num_wmes, i;
+    bool parallel_lookup, group_by_alpha_mem;
+
+    for (num_wmes = 0, c = wmes; c != NIL; c = c->rest)
+    {
+        num_wmes++;
+    }
+
+    parallel_lookup = thisAgent->reteWorkerPool &&
+                      (thisAgent->reteWorkerPool->get_num_threads() > 1) &&
+                      (num_wmes >= MIN_WMES_FOR_PARALLEL_ALPHA_MATCH);
+    group_by_alpha_mem = thisAgent->Decider->settings[DECIDER_MATCH_BATCHING] &&
+                         (num_wmes >= MIN_WMES_FOR_GROUPED_ALPHA_MATCH);
+
+    if (!parallel_lookup && !group_by_alpha_mem)
+    {
+        for (c = wmes; c != NIL; c = c->rest)
+        {
+            add_wme_to_rete(thisAgent, static_cast<wme*>(c->first));
+        }
+        return;
+    }
+
+    std::vector<wme*> batch;
+    std::vector<alpha_mem*> ams(num_wmes * 8);
+
+    batch.reserve(num_wmes);
+    for (c = wmes; c != NIL; c = c->rest)
+    {
+        batch.push_back(static_cast<wme*>(c->first));
+    }
+
+    if (parallel_lookup)
+    {
+        thisAgent->reteWorkerPool->run_partitioned(num_wmes, [&](size_t begin, size_t end)
+        {
+            for (size_t j = begin; j < end; j++)
+            {
+                find_alpha_mems_for_wme(thisAgent, batch[j], &ams[j * 8]);
+            }
+        });
+        thisAgent->num_parallel_match_batches++;
+        thisAgent->num_parallel_match_wmes += num_wmes;
+    }
+    else
+    {
+        for (i = 0; i < num_wmes; i++)
+        {
+            find_alpha_mems_for_wme(thisAgent, batch[i], &ams[i * 8]);
+        }
+    }
+
+    if (group_by_alpha_mem)
+    {
+        add_wme_batch_to_rete_grouped_by_alpha_mem(thisAgent, batch, ams);
+    }
+    else
+    {
+        for (i = 0; i < num_wmes; i++)
+        {
+            add_wme_to_rete_using_alpha_mems(thisAgent, batch[i], &ams[i * 8]);
+        }
+    }
+}
+
 inline void _epmem_remove_wme(agent* thisAgent, wme* w)
 {
     bool was_encoded = false;
@@ -1495,11 +2473,11 @@ inline void _epmem_remove_wme(agent* thisAgent, wme* w)
     {
         bool lti = (w->value->id->LTI_ID != NIL);
 
-        if ((w->epmem_id != EPMEM_NODEID_BAD) && (w->epmem_valid == thisAgent->EpMem->epmem_validation))
+        if ((wme_cold_fields(w)->epmem_id != EPMEM_NODEID_BAD) && (wme_cold_fields(w)->epmem_valid == thisAgent->EpMem->epmem_validation))
         {
             was_encoded = true;
 
-            (*thisAgent->EpMem->epmem_edge_removals)[ std::make_pair(w->epmem_id,static_cast<int64_t>((lti ? w->value->id->LTI_ID : 0))) ] = true;
+            (*thisAgent->EpMem->epmem_edge_removals)[ std::make_pair(wme_cold_fields(w)->epmem_id,static_cast<int64_t>((lti ? w->value->id->LTI_ID : 0))) ] = true;
 
 #ifdef DEBUG_EPMEM_WME_ADD
             fprintf(stderr, "   wme destroyed: %d %d %d\n",
@@ -1513,8 +2491,8 @@ inline void _epmem_remove_wme(agent* thisAgent, wme* w)
                 fprintf(stderr, "   returning WME to pool: %d %d %d\n",
                         (unsigned int) w->id->id->epmem_id, (unsigned int) epmem_temporal_hash(thisAgent, w->attr), (unsigned int) w->value->id->epmem_id);
 #endif
-                epmem_return_id_pool::iterator p = thisAgent->EpMem->epmem_id_replacement->find(w->epmem_id);
-                (*p->second).push_front(std::make_pair(w->value->id->epmem_id, w->epmem_id));
+                epmem_return_id_pool::iterator p = thisAgent->EpMem->epmem_id_replacement->find(wme_cold_fields(w)->epmem_id);
+                (*p->second).push_front(std::make_pair(w->value->id->epmem_id, wme_cold_fields(w)->epmem_id));
                 thisAgent->EpMem->epmem_id_replacement->erase(p);
             }
         }
@@ -1545,17 +2523,17 @@ inline void _epmem_remove_wme(agent* thisAgent, wme* w)
             }
         }
     }
-    else if ((w->epmem_id != EPMEM_NODEID_BAD) && (w->epmem_valid == thisAgent->EpMem->epmem_validation))
+    else if ((wme_cold_fields(w)->epmem_id != EPMEM_NODEID_BAD) && (wme_cold_fields(w)->epmem_valid == thisAgent->EpMem->epmem_validation))
     {
         was_encoded = true;
 
-        (*thisAgent->EpMem->epmem_node_removals)[ w->epmem_id ] = true;
+        (*thisAgent->EpMem->epmem_node_removals)[ wme_cold_fields(w)->epmem_id ] = true;
     }
 
-    if (was_encoded)
+    if (was_encoded && w->cold)
     {
-        w->epmem_id = EPMEM_NODEID_BAD;
-        w->epmem_valid = NIL;
+        w->cold->epmem_id = EPMEM_NODEID_BAD;
+        w->cold->epmem_valid = NIL;
     }
 }
 
@@ -1624,6 +2602,8 @@ void remove_wme_from_rete(agent* thisAgent, wme* w)
     rete_node* node, *next, *child;
     token* tok, *left;
 
+    rete_hash_tables_rehash_step(thisAgent);
+
     {
         if (thisAgent->EpMem->epmem_db->get_status() == soar_module::connected)
         {
@@ -1692,7 +2672,7 @@ void remove_wme_from_rete(agent* thisAgent, wme* w)
             {
                 for (child = node->first_child; child != NIL; child = child->next_sibling)
                 {
-                    (*(left_addition_routines[child->node_type]))(thisAgent, child, left, NIL);
+                    do_left_addition(thisAgent, child, left, NIL);
                 }
             }
         }
@@ -1732,6 +2712,11 @@ void remove_ref_to_alpha_mem(agent* thisAgent, alpha_mem* am)
     {
         remove_wme_from_alpha_mem(thisAgent, am->right_mems);
     }
+    if (am->const_filter)
+    {
+        delete am->const_filter;
+        thisAgent->num_const_filter_programs--;
+    }
     thisAgent->memoryManager->free_with_pool(MP_alpha_mem, am);
 }
 
@@ -1831,66 +2816,268 @@ void remove_node_from_parents_list_of_children(rete_node* node)
    join nodes.
 ------------------------------------------------------------------------ */
 
-void update_node_with_matches_from_above(agent* thisAgent, rete_node* child)
-{
-    rete_node* parent;
-    rete_node* saved_parents_first_child, *saved_childs_next_sibling;
-    right_mem* rm;
-    token* tok;
+void update_node_with_matches_from_above(agent* thisAgent, rete_node* child)
+{
+    rete_node* parent;
+    rete_node* saved_parents_first_child, *saved_childs_next_sibling;
+    right_mem* rm;
+    token* tok;
+
+    if (bnode_is_bottom_of_split_mp(child->node_type))
+    {
+        char msg[BUFFER_MSG_SIZE];
+        strncpy(msg, "\nrete.c: Internal error: update_node_with_matches_from_above called on split node", BUFFER_MSG_SIZE);
+        msg[BUFFER_MSG_SIZE - 1] = 0; /* ensure null termination */
+        abort_with_fatal_error(thisAgent, msg);
+    }
+
+    parent = child->parent;
+
+    /* --- if parent is dummy top node, tell child about dummy top token --- */
+    if (parent->node_type == DUMMY_TOP_BNODE)
+    {
+        do_left_addition(thisAgent, child, thisAgent->dummy_top_token, NIL);
+        return;
+    }
+
+    /* --- if parent is positive: first do surgery on parent's child list,
+           to replace the list with "child"; then call parent's add_right
+           routine with each wme in the parent's alpha mem; then do surgery
+           to restore previous child list of parent. --- */
+    if (bnode_is_positive(parent->node_type))
+    {
+        /* --- If the node is right unlinked, then don't activate it.  This is
+           important because some interpreter routines rely on the node
+           being right linked whenever it gets right activated. */
+        if (node_is_right_unlinked(parent))
+        {
+            return;
+        }
+        saved_parents_first_child = parent->first_child;
+        saved_childs_next_sibling = child->next_sibling;
+        parent->first_child = child;
+        child->next_sibling = NIL;
+        /* to avoid double-counting these right adds */
+        rete_node* node_to_ignore_for_activation_stats = parent;
+        for (rm = parent->b.posneg.alpha_mem_->right_mems; rm != NIL; rm = rm->next_in_am)
+        {
+            do_right_addition(thisAgent, parent, rm->w);
+        }
+        node_to_ignore_for_activation_stats = NIL;
+        parent->first_child = saved_parents_first_child;
+        child->next_sibling = saved_childs_next_sibling;
+        return;
+    }
+
+    /* --- if parent is negative or cn: easy, just look at the list of tokens
+           on the parent node. --- */
+    for (tok = parent->a.np.tokens; tok != NIL; tok = tok->next_of_node)
+        if (! tok->negrm_tokens)
+        {
+            do_left_addition(thisAgent, child, tok, NIL);
+        }
+}
+
+/* ------------------------------------------------------------------------
+                    Deferred Matching for Bulk Loads
+
+   While a bulk load is in progress (thisAgent->rete_deferred_nodes is
+   non-NIL), nodes built for new productions are entered in the deferred
+   table instead of being updated with matches from above right away.
+   Split_mp_node() and merge_into_mp_node() move the entry when they
+   replace a deferred node, and deallocated nodes are dropped from it.
+
+   Rete_flush_deferred_matches() then updates only the deferred nodes
+   whose parent (looking through a join node) was not itself deferred;
+   the rest of each new subtree is filled in by the ordinary left
+   activations.  Deferred nodes with the same parent are updated
+   together, so a shared join walks its alpha memory, or a negative node
+   its tokens, once per flush instead of once per new child.
+------------------------------------------------------------------------ */
+
+inline void update_new_node_with_matches_from_above(agent* thisAgent, rete_node* node)
+{
+    if (thisAgent->rete_deferred_nodes)
+    {
+        (*thisAgent->rete_deferred_nodes)[node] = thisAgent->rete_deferred_node_seq++;
+        return;
+    }
+    update_node_with_matches_from_above(thisAgent, node);
+}
+
+inline void forget_deferred_node(agent* thisAgent, rete_node* node)
+{
+    if (thisAgent->rete_deferred_nodes)
+    {
+        thisAgent->rete_deferred_nodes->erase(node);
+    }
+}
+
+inline void replace_deferred_node(agent* thisAgent, rete_node* old_node, rete_node* new_node)
+{
+    std::unordered_map<rete_node*, uint64_t>::iterator it;
+    uint64_t seq;
+
+    if (!thisAgent->rete_deferred_nodes)
+    {
+        return;
+    }
+    it = thisAgent->rete_deferred_nodes->find(old_node);
+    if (it == thisAgent->rete_deferred_nodes->end())
+    {
+        return;
+    }
+    seq = it->second;
+    thisAgent->rete_deferred_nodes->erase(it);
+    (*thisAgent->rete_deferred_nodes)[new_node] = seq;
+}
+
+inline void note_node_shared_during_bulk_load(agent* thisAgent)
+{
+    if (thisAgent->rete_deferred_nodes)
+    {
+        thisAgent->num_bulk_nodes_shared++;
+    }
+}
+
+uint64_t total_rete_node_count(agent* thisAgent)
+{
+    uint64_t total = 0;
+
+    for (int i = 0; i < 256; i++)
+    {
+        total += thisAgent->rete_node_counts[i];
+    }
+    return total;
+}
+
+void rete_flush_deferred_matches(agent* thisAgent)
+{
+    std::unordered_map<rete_node*, uint64_t>* deferred;
+    std::unordered_map<rete_node*, uint64_t>::iterator it;
+    std::vector< std::pair<uint64_t, rete_node*> > pending;
+    std::unordered_map<rete_node*, size_t> group_of_parent;
+    std::vector< std::pair<size_t, rete_node*> > roots;
+    std::vector<rete_node*> saved_siblings;
+    rete_node* parent, *feeder, *saved_first_child;
+    right_mem* rm;
+    token* tok;
+    size_t i, j, group_end;
+    soar_timer timer;
+
+    deferred = thisAgent->rete_deferred_nodes;
+    if (!deferred || deferred->empty())
+    {
+        return;
+    }
+    timer.start();
+
+    /* --- put the deferred nodes back in the order they were built --- */
+    pending.reserve(deferred->size());
+    for (it = deferred->begin(); it != deferred->end(); ++it)
+    {
+        pending.push_back(std::make_pair(it->second, it->first));
+    }
+    std::sort(pending.begin(), pending.end());
+
+    /* --- keep the ones fed by an existing node, grouped by parent --- */
+    for (i = 0; i < pending.size(); i++)
+    {
+        parent = pending[i].second->parent;
+        feeder = bnode_is_bottom_of_split_mp(parent->node_type) ? parent->parent : parent;
+        if (deferred->count(feeder))
+        {
+            continue;
+        }
+        roots.push_back(std::make_pair(group_of_parent.insert(std::make_pair(parent, group_of_parent.size())).first->second,
+                                       pending[i].second));
+    }
+    std::stable_sort(roots.begin(), roots.end(),
+                     [](const std::pair<size_t, rete_node*>& a, const std::pair<size_t, rete_node*>& b) { return a.first < b.first; });
+    deferred->clear();
+
+    for (i = 0; i < roots.size(); i = group_end)
+    {
+        for (group_end = i + 1; (group_end < roots.size()) && (roots[group_end].first == roots[i].first); group_end++) {}
+        parent = roots[i].second->parent;
+        thisAgent->num_bulk_subtrees_matched += group_end - i;
+
+        if (parent->node_type == DUMMY_TOP_BNODE)
+        {
+            for (j = i; j < group_end; j++)
+            {
+                do_left_addition(thisAgent, roots[j].second, thisAgent->dummy_top_token, NIL);
+            }
+        }
+        else if (bnode_is_positive(parent->node_type))
+        {
+            /* --- as in update_node_with_matches_from_above(), but with the
+               whole group temporarily standing in as the parent's children --- */
+            if (node_is_right_unlinked(parent))
+            {
+                continue;
+            }
+            saved_first_child = parent->first_child;
+            saved_siblings.clear();
+            for (j = i; j < group_end; j++)
+            {
+                saved_siblings.push_back(roots[j].second->next_sibling);
+                roots[j].second->next_sibling = (j + 1 < group_end) ? roots[j + 1].second : NIL;
+            }
+            parent->first_child = roots[i].second;
+            for (rm = parent->b.posneg.alpha_mem_->right_mems; rm != NIL; rm = rm->next_in_am)
+            {
+                do_right_addition(thisAgent, parent, rm->w);
+            }
+            parent->first_child = saved_first_child;
+            for (j = i; j < group_end; j++)
+            {
+                roots[j].second->next_sibling = saved_siblings[j - i];
+            }
+        }
+        else
+        {
+            for (tok = parent->a.np.tokens; tok != NIL; tok = tok->next_of_node)
+                if (! tok->negrm_tokens)
+                    for (j = i; j < group_end; j++)
+                    {
+                        do_left_addition(thisAgent, roots[j].second, tok, NIL);
+                    }
+        }
+    }
+
+    timer.stop();
+    thisAgent->bulk_match_usec += timer.get_usec();
+}
 
-    if (bnode_is_bottom_of_split_mp(child->node_type))
+void rete_begin_bulk_load(agent* thisAgent)
+{
+    if (thisAgent->rete_deferred_nodes)
     {
-        char msg[BUFFER_MSG_SIZE];
-        strncpy(msg, "\nrete.c: Internal error: update_node_with_matches_from_above called on split node", BUFFER_MSG_SIZE);
-        msg[BUFFER_MSG_SIZE - 1] = 0; /* ensure null termination */
-        abort_with_fatal_error(thisAgent, msg);
+        return;
     }
+    thisAgent->rete_deferred_nodes = new std::unordered_map<rete_node*, uint64_t>();
+    thisAgent->rete_deferred_node_seq = 0;
+    thisAgent->rete_bulk_node_count_at_start = total_rete_node_count(thisAgent);
+}
 
-    parent = child->parent;
+void rete_end_bulk_load(agent* thisAgent)
+{
+    uint64_t node_count;
 
-    /* --- if parent is dummy top node, tell child about dummy top token --- */
-    if (parent->node_type == DUMMY_TOP_BNODE)
+    if (!thisAgent->rete_deferred_nodes)
     {
-        (*(left_addition_routines[child->node_type]))(thisAgent, child, thisAgent->dummy_top_token, NIL);
         return;
     }
+    rete_flush_deferred_matches(thisAgent);
 
-    /* --- if parent is positive: first do surgery on parent's child list,
-           to replace the list with "child"; then call parent's add_right
-           routine with each wme in the parent's alpha mem; then do surgery
-           to restore previous child list of parent. --- */
-    if (bnode_is_positive(parent->node_type))
+    node_count = total_rete_node_count(thisAgent);
+    if (node_count > thisAgent->rete_bulk_node_count_at_start)
     {
-        /* --- If the node is right unlinked, then don't activate it.  This is
-           important because some interpreter routines rely on the node
-           being right linked whenever it gets right activated. */
-        if (node_is_right_unlinked(parent))
-        {
-            return;
-        }
-        saved_parents_first_child = parent->first_child;
-        saved_childs_next_sibling = child->next_sibling;
-        parent->first_child = child;
-        child->next_sibling = NIL;
-        /* to avoid double-counting these right adds */
-        rete_node* node_to_ignore_for_activation_stats = parent;
-        for (rm = parent->b.posneg.alpha_mem_->right_mems; rm != NIL; rm = rm->next_in_am)
-        {
-            (*(right_addition_routines[parent->node_type]))(thisAgent, parent, rm->w);
-        }
-        node_to_ignore_for_activation_stats = NIL;
-        parent->first_child = saved_parents_first_child;
-        child->next_sibling = saved_childs_next_sibling;
-        return;
+        thisAgent->num_bulk_nodes_added += node_count - thisAgent->rete_bulk_node_count_at_start;
     }
-
-    /* --- if parent is negative or cn: easy, just look at the list of tokens
-           on the parent node. --- */
-    for (tok = parent->a.np.tokens; tok != NIL; tok = tok->next_of_node)
-        if (! tok->negrm_tokens)
-        {
-            (*(left_addition_routines[child->node_type]))(thisAgent, child, tok, NIL);
-        }
+    delete thisAgent->rete_deferred_nodes;
+    thisAgent->rete_deferred_nodes = NIL;
 }
 
 /* ------------------------------------------------------------------------
@@ -1940,6 +3127,7 @@ rete_node* make_new_mem_node(agent* thisAgent,
     parent->first_child = node;
     node->first_child = NIL;
     node->b.mem.first_linked_child = NIL;
+    node->b.mem.num_doubly_unlinked_children = 0;
 
     /* These hash fields are not used for unhashed node types */
     node->left_hash_loc_field_num = left_hash_loc.field_num;
@@ -1949,7 +3137,7 @@ rete_node* make_new_mem_node(agent* thisAgent,
     node->a.np.tokens = NIL;
 
     /* --- call new node's add_left routine with all the parent's tokens --- */
-    update_node_with_matches_from_above(thisAgent, node);
+    update_new_node_with_matches_from_above(thisAgent, node);
 
     return node;
 }
@@ -1979,6 +3167,7 @@ rete_node* make_new_positive_node(agent* thisAgent,
     node->b.posneg.alpha_mem_ = am;
     node->b.posneg.nearest_ancestor_with_same_am =
         nearest_ancestor_with_same_am(node, am);
+    node->b.posneg.const_filter_slot = UNASSIGNED_CONST_FILTER_SLOT;
     relink_to_right_mem(node);
 
     /* --- don't need to force WM through new node yet, as it's just a
@@ -2048,14 +3237,16 @@ rete_node* split_mp_node(agent* thisAgent, rete_node* mp_node)
     parent->first_child = mem_node;
     mem_node->first_child = pos_node;
     mem_node->b.mem.first_linked_child = NIL;
+    mem_node->b.mem.num_doubly_unlinked_children = 0;
     mem_node->left_hash_loc_field_num = mp_copy.left_hash_loc_field_num;
     mem_node->left_hash_loc_levels_up = mp_copy.left_hash_loc_levels_up;
     mem_node->node_id = mp_copy.node_id;
+    replace_deferred_node(thisAgent, mp_node, mem_node);
 
     mem_node->a.np.tokens = mp_node->a.np.tokens;
     for (t = mp_node->a.np.tokens; t != NIL; t = t->next_of_node)
     {
-        t->node = mem_node;
+        change_token_node(thisAgent, t, mem_node);
     }
 
     /* --- transmogrify the old MP node into the new Pos node --- */
@@ -2072,6 +3263,10 @@ rete_node* split_mp_node(agent* thisAgent, rete_node* mp_node)
     {
         unlink_from_left_mem(pos_node);
     }
+    if (node_is_doubly_unlinked(pos_node))
+    {
+        mem_node->b.mem.num_doubly_unlinked_children = 1;
+    }
 
     return mem_node;
 }
@@ -2122,15 +3317,16 @@ rete_node* merge_into_mp_node(agent* thisAgent, rete_node* mem_node)
     set_sharing_factor(mp_node, pos_copy.sharing_factor);
     mp_node->b.posneg = pos_copy.b.posneg;
 
-    /* --- transfer the Mem node's tokens to the MP node --- */
+    /* --- transfer the Mem node's tokens to the MP node (the node_id has
+       to be in place first, since it determines the tokens' hash bucket) --- */
+    mp_node->left_hash_loc_field_num = mem_node->left_hash_loc_field_num;
+    mp_node->left_hash_loc_levels_up = mem_node->left_hash_loc_levels_up;
+    mp_node->node_id = mem_node->node_id;
     mp_node->a.np.tokens = mem_node->a.np.tokens;
     for (t = mem_node->a.np.tokens; t != NIL; t = t->next_of_node)
     {
-        t->node = mp_node;
+        change_token_node(thisAgent, t, mp_node);
     }
-    mp_node->left_hash_loc_field_num = mem_node->left_hash_loc_field_num;
-    mp_node->left_hash_loc_levels_up = mem_node->left_hash_loc_levels_up;
-    mp_node->node_id = mem_node->node_id;
 
     /* --- replace the Mem node with the new MP node --- */
     mp_node->parent = parent;
@@ -2140,6 +3336,11 @@ rete_node* merge_into_mp_node(agent* thisAgent, rete_node* mem_node)
 
     remove_node_from_parents_list_of_children(mem_node);
     update_stats_for_destroying_node(thisAgent, mem_node);   /* clean up rete stats stuff */
+    replace_deferred_node(thisAgent, mem_node, mp_node);
+    if (thisAgent->reteProfiler)
+    {
+        thisAgent->reteProfiler->forget_node(mem_node);
+    }
     thisAgent->memoryManager->free_with_pool(MP_rete_node, mem_node);
 
     /* --- set MP node's unlinking status according to pos_copy's --- */
@@ -2208,12 +3409,13 @@ rete_node* make_new_negative_node(agent* thisAgent,
     node->a.np.tokens = NIL;
     node->b.posneg.nearest_ancestor_with_same_am =
         nearest_ancestor_with_same_am(node, am);
+    node->b.posneg.const_filter_slot = UNASSIGNED_CONST_FILTER_SLOT;
     relink_to_right_mem(node);
 
     node->node_id = get_next_beta_node_id(thisAgent);
 
     /* --- call new node's add_left routine with all the parent's tokens --- */
-    update_node_with_matches_from_above(thisAgent, node);
+    update_new_node_with_matches_from_above(thisAgent, node);
 
     /* --- if no tokens arrived from parent, unlink the node --- */
     if (! node->a.np.tokens)
@@ -2269,9 +3471,9 @@ rete_node* make_new_cn_node(agent* thisAgent,
     partner->b.cn.partner = node;
 
     /* --- call partner's add_left routine with all the parent's tokens --- */
-    update_node_with_matches_from_above(thisAgent, partner);
+    update_new_node_with_matches_from_above(thisAgent, partner);
     /* --- call new node's add_left routine with all the parent's tokens --- */
-    update_node_with_matches_from_above(thisAgent, node);
+    update_new_node_with_matches_from_above(thisAgent, node);
 
     return node;
 }
@@ -2386,12 +3588,20 @@ void deallocate_rete_node(agent* thisAgent, rete_node* node)
     /* --- stuff for posneg nodes only --- */
     if (bnode_is_posneg(node->node_type))
     {
+        if (node->b.posneg.const_filter_slot < UNASSIGNED_CONST_FILTER_SLOT)
+        {
+            node->b.posneg.alpha_mem_->const_filter->forget_slot(node->b.posneg.const_filter_slot);
+        }
         deallocate_rete_test_list(thisAgent, node->b.posneg.other_tests);
         /* --- right unlink the node, cleanup alpha memory --- */
         if (! node_is_right_unlinked(node))
         {
             unlink_from_right_mem(node);
         }
+        else if (node_is_doubly_unlinked(node))
+        {
+            remove_from_doubly_unlinked_nodes(node);
+        }
         remove_ref_to_alpha_mem(thisAgent, node->b.posneg.alpha_mem_);
     }
 
@@ -2414,6 +3624,11 @@ void deallocate_rete_node(agent* thisAgent, rete_node* node)
     }
 
     update_stats_for_destroying_node(thisAgent, node);   /* clean up rete stats stuff */
+    forget_deferred_node(thisAgent, node);
+    if (thisAgent->reteProfiler)
+    {
+        thisAgent->reteProfiler->forget_node(node);
+    }
     thisAgent->memoryManager->free_with_pool(MP_rete_node, node);
 
     /* --- if parent has no other children, deallocate it, and recurse  --- */
@@ -2545,7 +3760,7 @@ bool find_var_location(Symbol* var, rete_node_level current_depth,
    (push a new binding for ANY variable) or SPARSE fashion (push a new
    binding only for previously-unbound variables), depending on the
    boolean "dense" parameter.  Any variables receiving new bindings
-   are also pushed onto the given "varlist".
+   are also added to the given "varlist".
 ------------------------------------------------------------------- */
 
 void bind_variables_in_test(agent* thisAgent,
@@ -2553,7 +3768,7 @@ void bind_variables_in_test(agent* thisAgent,
                             rete_node_level depth,
                             byte field_num,
                             bool dense,
-                            cons** varlist)
+                            var_vector* varlist)
 {
     Symbol* referent;
 
@@ -2561,27 +3776,24 @@ void bind_variables_in_test(agent* thisAgent,
     if (!referent->is_variable()) return;
     if (!dense && var_is_bound(referent)) return;
     push_var_binding(thisAgent, referent, depth, field_num);
-    push(thisAgent, referent, *varlist);
+    varlist->push_back(referent);
 }
 
 /* -------------------------------------------------------------------
-             Pop Bindings and Deallocate List of Variables
+                     Pop Bindings of Variables
 
    This routine takes a list of variables; for each item <v> on the
-   list, it pops a binding of <v>.  It also deallocates the list.
-   This is often used for un-binding a group of variables which got
-   bound in some procedure.
+   list, last first, it pops a binding of <v>.  It also empties the
+   list.  This is often used for un-binding a group of variables which
+   got bound in some procedure.
 ------------------------------------------------------------------- */
 
-void pop_bindings_and_deallocate_list_of_variables(agent* thisAgent, cons* vars)
+void pop_bindings_of_variables(agent* thisAgent, var_vector& vars)
 {
-    while (vars)
+    while (!vars.empty())
     {
-        cons* c;
-        c = vars;
-        vars = vars->rest;
-        pop_var_binding(thisAgent, c->first);
-        free_cons(thisAgent, c);
+        pop_var_binding(thisAgent, vars.back());
+        vars.pop_back();
     }
 }
 
@@ -2756,9 +3968,7 @@ node_varnames* make_nvn_for_posneg_cond(agent* thisAgent,
                                         node_varnames* parent_nvn)
 {
     node_varnames* New;
-    cons* vars_bound;
-
-    vars_bound = NIL;
+    var_vector vars_bound;
 
     thisAgent->memoryManager->allocate_with_pool(MP_node_varnames, &New);
     New->parent = parent_nvn;
@@ -2778,7 +3988,7 @@ node_varnames* make_nvn_for_posneg_cond(agent* thisAgent,
         add_unbound_varnames_in_test(thisAgent, cond->data.tests.value_test, NIL);
 
     /* --- Pop the variable bindings for these conditions --- */
-    pop_bindings_and_deallocate_list_of_variables(thisAgent, vars_bound);
+    pop_bindings_of_variables(thisAgent, vars_bound);
 
     return New;
 }
@@ -2789,9 +3999,7 @@ node_varnames* get_nvn_for_condition_list(agent* thisAgent,
 {
     node_varnames* New = 0;
     condition* cond;
-    cons* vars;
-
-    vars = NIL;
+    var_vector vars;
 
     for (cond = cond_list; cond != NIL; cond = cond->next)
     {
@@ -2821,7 +4029,7 @@ node_varnames* get_nvn_for_condition_list(agent* thisAgent,
     }
 
     /* --- Pop the variable bindings for these conditions --- */
-    pop_bindings_and_deallocate_list_of_variables(thisAgent, vars);
+    pop_bindings_of_variables(thisAgent, vars);
 
     return parent_nvn;
 }
@@ -3191,11 +4399,10 @@ rete_node* make_node_for_positive_cond(agent* thisAgent,
     var_location left_hash_loc;
     left_hash_loc.var_location_struct::field_num = 0;
     left_hash_loc.var_location_struct::levels_up = 0;
-    cons* vars_bound_here;
+    var_vector vars_bound_here;
 
     alpha_id = alpha_attr = alpha_value = NIL;
     rt = NIL;
-    vars_bound_here = NIL;
 
     /* --- Add sparse variable bindings for this condition --- */
     bind_variables_in_test(thisAgent, cond->data.tests.id_test, current_depth, 0,
@@ -3215,7 +4422,7 @@ rete_node* make_node_for_positive_cond(agent* thisAgent,
                             &rt, &alpha_value);
 
     /* --- Pop sparse variable bindings for this condition --- */
-    pop_bindings_and_deallocate_list_of_variables(thisAgent, vars_bound_here);
+    pop_bindings_of_variables(thisAgent, vars_bound_here);
 
     /* --- Get alpha memory --- */
     am = find_or_make_alpha_mem(thisAgent, alpha_id, alpha_attr, alpha_value,
@@ -3267,6 +4474,7 @@ rete_node* make_node_for_positive_cond(agent* thisAgent,
 
         if (node)      /* --- A matching join node was found --- */
         {
+            note_node_shared_during_bulk_load(thisAgent);
             deallocate_rete_test_list(thisAgent, rt);
             remove_ref_to_alpha_mem(thisAgent, am);
             return node;
@@ -3295,6 +4503,7 @@ rete_node* make_node_for_positive_cond(agent* thisAgent,
                 rete_test_lists_are_identical(thisAgent, mp_node->b.posneg.other_tests, rt))
         {
             /* --- Complete MP match was found --- */
+            note_node_shared_during_bulk_load(thisAgent);
             deallocate_rete_test_list(thisAgent, rt);
             remove_ref_to_alpha_mem(thisAgent, am);
             return mp_node;
@@ -3334,11 +4543,10 @@ rete_node* make_node_for_negative_cond(agent* thisAgent,
     var_location left_hash_loc;
     left_hash_loc.var_location_struct::field_num = 0;
     left_hash_loc.var_location_struct::levels_up = 0;
-    cons* vars_bound_here;
+    var_vector vars_bound_here;
 
     alpha_id = alpha_attr = alpha_value = NIL;
     rt = NIL;
-    vars_bound_here = NIL;
 
     /* --- Add sparse variable bindings for this condition --- */
     bind_variables_in_test(thisAgent, cond->data.tests.id_test, current_depth, 0,
@@ -3358,7 +4566,7 @@ rete_node* make_node_for_negative_cond(agent* thisAgent,
                             &rt, &alpha_value);
 
     /* --- Pop sparse variable bindings for this condition --- */
-    pop_bindings_and_deallocate_list_of_variables(thisAgent, vars_bound_here);
+    pop_bindings_of_variables(thisAgent, vars_bound_here);
 
     /* --- Get alpha memory --- */
     am = find_or_make_alpha_mem(thisAgent, alpha_id, alpha_attr, alpha_value,
@@ -3381,6 +4589,7 @@ rete_node* make_node_for_negative_cond(agent* thisAgent,
 
     if (node)      /* --- A matching node was found --- */
     {
+        note_node_shared_during_bulk_load(thisAgent);
         deallocate_rete_test_list(thisAgent, rt);
         remove_ref_to_alpha_mem(thisAgent, am);
         return node;
@@ -3405,7 +4614,7 @@ rete_node* make_node_for_negative_cond(agent* thisAgent,
     fills it in with a pointer to the lowermost node in the resulting
     network.  If <dest_bottom_depth> is non-NIL, this routine fills it
     in with the depth of the lowermost node.  If <dest_vars_bound> is
-    non_NIL, this routine fills it in with a list of variables bound
+    non_NIL, this routine adds to it the variables bound
     in the given <cond_list>, and does not pop the bindings for those
     variables, in which case the caller is responsible for popping theose
     bindings.  If <dest_vars_bound> is given as NIL, then this routine
@@ -3418,16 +4627,16 @@ void build_network_for_condition_list(agent* thisAgent,
                                       rete_node* parent,
                                       rete_node** dest_bottom_node,
                                       rete_node_level* dest_bottom_depth,
-                                      cons** dest_vars_bound)
+                                      var_vector* dest_vars_bound)
 {
     rete_node* node, *new_node, *child, *subconditions_bottom_node;
     condition* cond;
     rete_node_level current_depth;
-    cons* vars_bound;
+    var_vector local_vars_bound;
+    var_vector* vars_bound = dest_vars_bound ? dest_vars_bound : &local_vars_bound;
 
     node = parent;
     current_depth = depth_of_first_cond;
-    vars_bound = NIL;
 
     for (cond = cond_list; cond != NIL; cond = cond->next)
     {
@@ -3438,11 +4647,11 @@ void build_network_for_condition_list(agent* thisAgent,
                 new_node = make_node_for_positive_cond(thisAgent, cond, current_depth, node);
                 /* --- Add dense variable bindings for this condition --- */
                 bind_variables_in_test(thisAgent, cond->data.tests.id_test, current_depth, 0,
-                                       true, &vars_bound);
+                                       true, vars_bound);
                 bind_variables_in_test(thisAgent, cond->data.tests.attr_test, current_depth, 1,
-                                       true, &vars_bound);
+                                       true, vars_bound);
                 bind_variables_in_test(thisAgent, cond->data.tests.value_test, current_depth, 2,
-                                       true, &vars_bound);
+                                       true, vars_bound);
                 break;
 
             case NEGATIVE_CONDITION:
@@ -3463,6 +4672,7 @@ void build_network_for_condition_list(agent* thisAgent,
                 /* --- share existing node or build new one --- */
                 if (child)
                 {
+                    note_node_shared_during_bulk_load(thisAgent);
                     new_node = child;
                 }
                 else
@@ -3488,13 +4698,9 @@ void build_network_for_condition_list(agent* thisAgent,
     {
         *dest_bottom_depth = current_depth - 1;
     }
-    if (dest_vars_bound)
+    if (!dest_vars_bound)
     {
-        *dest_vars_bound = vars_bound;
-    }
-    else
-    {
-        pop_bindings_and_deallocate_list_of_variables(thisAgent, vars_bound);
+        pop_bindings_of_variables(thisAgent, local_vars_bound);
     }
 }
 
@@ -3736,11 +4942,19 @@ byte add_production_to_rete(agent* thisAgent, production* p, condition* lhs_top,
 {
     rete_node* bottom_node, *p_node;
     rete_node_level bottom_depth;
-    cons* vars_bound;
+    var_vector vars_bound;
     ms_change* msc;
     action* a;
     byte production_addition_result;
 
+    rete_hash_tables_rehash_step(thisAgent);
+
+    /* --- refraction needs the new p-node's matches right away --- */
+    if (refracted_inst)
+    {
+        rete_end_bulk_load(thisAgent);
+    }
+
     /* --- build the network for all the conditions --- */
     build_network_for_condition_list(thisAgent, lhs_top, 1, thisAgent->dummy_top_node,
                                      &bottom_node, &bottom_depth, &vars_bound);
@@ -3767,7 +4981,7 @@ byte add_production_to_rete(agent* thisAgent, production* p, condition* lhs_top,
     }
 
     /* --- clean up variable bindings created by build_network...() --- */
-    pop_bindings_and_deallocate_list_of_variables(thisAgent, vars_bound);
+    pop_bindings_of_variables(thisAgent, vars_bound);
 
     update_max_rhs_unbound_variables(thisAgent, num_rhs_unbound_vars_for_new_prod);
 
@@ -3891,7 +5105,7 @@ byte add_production_to_rete(agent* thisAgent, production* p, condition* lhs_top,
     }
 
     /* --- call new node's add_left routine with all the parent's tokens --- */
-    update_node_with_matches_from_above(thisAgent, p_node);
+    update_new_node_with_matches_from_above(thisAgent, p_node);
 
     /* --- store result indicator --- */
     if (! refracted_inst)
@@ -3956,6 +5170,8 @@ void excise_production_from_rete(agent* thisAgent, production* pProd)
     rete_node* p_node, *parent;
     ms_change* msc;
 
+    rete_hash_tables_rehash_step(thisAgent);
+
     soar_invoke_callbacks(thisAgent, PRODUCTION_JUST_ABOUT_TO_BE_EXCISED_CALLBACK, static_cast<soar_call_data>(pProd));
 
     p_node = pProd->p_node;
@@ -3985,6 +5201,11 @@ void excise_production_from_rete(agent* thisAgent, production* pProd)
     /* --- finally, excise the p_node --- */
     remove_node_from_parents_list_of_children(p_node);
     update_stats_for_destroying_node(thisAgent, p_node);    /* clean up rete stats stuff */
+    forget_deferred_node(thisAgent, p_node);
+    if (thisAgent->reteProfiler)
+    {
+        thisAgent->reteProfiler->forget_node(p_node);
+    }
     thisAgent->memoryManager->free_with_pool(MP_rete_node, p_node);
 
     /* --- update sharing factors on the path from here to the top node --- */
@@ -4389,6 +5610,174 @@ inline bool match_left_and_right(agent* thisAgent, rete_test* _rete_test,
             (thisAgent, (_rete_test), (left), (w)));
 }
 
+/* ----------------------------------------------------------------------
+                      Constant Test Programs
+
+   An alpha memory used by enough beta nodes gets a Rete_Const_Filter
+   (see rete_const_filter.h) holding the constant tests of those nodes.
+   The program is rebuilt lazily:  it is marked dirty when one of its
+   nodes is deallocated or a node it hasn't seen is linked to the alpha
+   memory, and rebuilt the next time a wme is added.
+
+   Integer comparisons only go into the program when the constant is
+   small enough that compare_symbols() can't overflow on it; the others,
+   and comparisons against a wme value that isn't such an integer, are
+   run through the usual test routines.
+---------------------------------------------------------------------- */
+
+#define CONST_FILTER_INT_LIMIT (static_cast<int64_t>(1) << 62)
+
+inline bool int_fits_const_filter(int64_t value)
+{
+    return (value > -CONST_FILTER_INT_LIMIT) && (value < CONST_FILTER_INT_LIMIT);
+}
+
+void add_node_to_const_filter(Rete_Const_Filter* filter, rete_node* node)
+{
+    rete_test* rt;
+    Symbol* constant;
+    uint32_t slot;
+
+    for (rt = node->b.posneg.other_tests; rt != NIL; rt = rt->next)
+        if (! test_is_variable_relational_test(rt->type))
+        {
+            break;
+        }
+    if (! rt)
+    {
+        node->b.posneg.const_filter_slot = NO_CONST_FILTER_SLOT;
+        return;
+    }
+
+    slot = filter->add_slot(node);
+    node->b.posneg.const_filter_slot = slot;
+    for (rt = node->b.posneg.other_tests; rt != NIL; rt = rt->next)
+    {
+        if (test_is_variable_relational_test(rt->type))
+        {
+            continue;
+        }
+        if (test_is_constant_relational_test(rt->type))
+        {
+            constant = rt->data.constant_referent;
+            switch (kind_of_relational_test(rt->type))
+            {
+                case RELATIONAL_EQUAL_RETE_TEST:
+                    filter->add_equality_test(rt->right_field_num, constant, false, slot);
+                    continue;
+                case RELATIONAL_NOT_EQUAL_RETE_TEST:
+                    filter->add_equality_test(rt->right_field_num, constant, true, slot);
+                    continue;
+                case RELATIONAL_LESS_RETE_TEST:
+                case RELATIONAL_GREATER_RETE_TEST:
+                case RELATIONAL_LESS_OR_EQUAL_RETE_TEST:
+                case RELATIONAL_GREATER_OR_EQUAL_RETE_TEST:
+                    if ((constant->symbol_type == INT_CONSTANT_SYMBOL_TYPE) &&
+                            int_fits_const_filter(constant->ic->value))
+                    {
+                        filter->add_int_test(rt->right_field_num,
+                                             static_cast<Rete_Const_Filter::int_test_type>(
+                                                 kind_of_relational_test(rt->type) - RELATIONAL_LESS_RETE_TEST),
+                                             constant->ic->value, rt, slot);
+                        continue;
+                    }
+                    break;
+                default:
+                    break;
+            }
+        }
+        filter->add_general_test(rt, slot);
+    }
+}
+
+void rebuild_const_filter(agent* thisAgent, alpha_mem* am)
+{
+    Rete_Const_Filter* filter = am->const_filter;
+    std::vector<rete_node*> nodes;
+    rete_node* node;
+    uint32_t slot;
+
+    /* --- keep the nodes the old program had (including ones that are
+       currently right-unlinked), and add the linked ones it hasn't seen --- */
+    for (slot = 0; slot < filter->num_slots(); slot++)
+        if (filter->slot_owner(slot))
+        {
+            nodes.push_back(filter->slot_owner(slot));
+        }
+    for (node = am->beta_nodes; node != NIL; node = node->b.posneg.next_from_alpha_mem)
+        if (node->b.posneg.const_filter_slot == UNASSIGNED_CONST_FILTER_SLOT)
+        {
+            nodes.push_back(node);
+        }
+
+    filter->clear();
+    for (std::vector<rete_node*>::iterator it = nodes.begin(); it != nodes.end(); ++it)
+    {
+        add_node_to_const_filter(filter, *it);
+    }
+    thisAgent->num_const_filter_rebuilds++;
+}
+
+/* --- Returns the alpha memory's constant test program, building or
+   rebuilding it first if needed, or NIL if it has none worth running --- */
+Rete_Const_Filter* const_filter_for_alpha_mem(agent* thisAgent, alpha_mem* am)
+{
+    if (! am->const_filter)
+    {
+        if (am->reference_count < MIN_NODES_FOR_CONST_FILTER)
+        {
+            return NIL;
+        }
+        am->const_filter = new Rete_Const_Filter();
+        thisAgent->num_const_filter_programs++;
+    }
+    if (am->const_filter->is_dirty())
+    {
+        rebuild_const_filter(thisAgent, am);
+    }
+    return am->const_filter->num_slots() ? am->const_filter : NIL;
+}
+
+void run_const_filter(agent* thisAgent, Rete_Const_Filter* filter, wme* w)
+{
+    std::vector<Rete_Const_Filter::test_ref>::iterator ref;
+    Symbol* value;
+    byte field;
+    int type;
+
+    filter->start_evaluation();
+    for (field = 0; field < 3; field++)
+    {
+        value = field_from_wme(w, field);
+        filter->run_equality_tests(field, value);
+        if (! filter->has_int_tests(field))
+        {
+            continue;
+        }
+        if ((value->symbol_type == INT_CONSTANT_SYMBOL_TYPE) && int_fits_const_filter(value->ic->value))
+        {
+            filter->run_int_tests(field, value->ic->value);
+            continue;
+        }
+        for (type = 0; type < Rete_Const_Filter::NUM_INT_TEST_TYPES; type++)
+        {
+            std::vector<Rete_Const_Filter::test_ref>& refs = filter->int_test_refs(field, type);
+            for (ref = refs.begin(); ref != refs.end(); ++ref)
+                if (filter->verdict(ref->slot) && ! match_left_and_right(thisAgent, ref->test, NIL, w))
+                {
+                    filter->fail(ref->slot);
+                }
+        }
+    }
+
+    std::vector<Rete_Const_Filter::test_ref>& general = filter->general_tests();
+    for (ref = general.begin(); ref != general.end(); ++ref)
+        if (filter->verdict(ref->slot) && ! match_left_and_right(thisAgent, ref->test, NIL, w))
+        {
+            filter->fail(ref->slot);
+        }
+}
+
 /* Note:  "=" and "<>" tests always return false when one argument is
    an integer and the other is a floating point number */
 
@@ -4399,6 +5788,11 @@ inline bool match_left_and_right(agent* thisAgent, rete_test* _rete_test,
  */
 inline int64_t compare_symbols(Symbol* s1, Symbol* s2)
 {
+    /* --- symbols are unique per value, so a symbol only equals itself --- */
+    if (s1 == s2)
+    {
+        return 0;
+    }
     switch (s1->symbol_type)
     {
         case INT_CONSTANT_SYMBOL_TYPE:
@@ -4858,17 +6252,23 @@ void beta_memory_node_left_addition(agent* thisAgent, rete_node* node,
     hv = node->node_id ^ referent->hash_id;
 
     /* --- build new left token, add it to the hash table --- */
-    token_added(node);
+    token_added(thisAgent, node);
     thisAgent->memoryManager->allocate_with_pool(MP_token, &New);
     new_left_token(New, node, tok, w);
-    insert_token_into_left_ht(thisAgent, New, hv);
-    New->a.ht.referent = referent;
+    insert_token_into_left_ht(thisAgent, New, hv, referent);
+    if (node->b.mem.num_doubly_unlinked_children)
+    {
+        relink_doubly_unlinked_children_to_right(node);
+    }
 
     /* --- inform each linked child (positive join) node --- */
     for (child = node->b.mem.first_linked_child; child != NIL; child = next)
     {
         next = child->a.pos.next_from_beta_mem;
-        positive_node_left_addition(thisAgent, child, New, referent);
+        do_positive_left_addition(thisAgent, child, [&]()
+        {
+            positive_node_left_addition(thisAgent, child, New, referent);
+        });
     }
     activation_exit_sanity_check();
 }
@@ -4887,17 +6287,23 @@ void unhashed_beta_memory_node_left_addition(agent* thisAgent,
     hv = node->node_id;
 
     /* --- build new left token, add it to the hash table --- */
-    token_added(node);
+    token_added(thisAgent, node);
     thisAgent->memoryManager->allocate_with_pool(MP_token, &New);
     new_left_token(New, node, tok, w);
-    insert_token_into_left_ht(thisAgent, New, hv);
-    New->a.ht.referent = NIL;
+    insert_token_into_left_ht(thisAgent, New, hv, NIL);
+    if (node->b.mem.num_doubly_unlinked_children)
+    {
+        relink_doubly_unlinked_children_to_right(node);
+    }
 
     /* --- inform each linked child (positive join) node --- */
     for (child = node->b.mem.first_linked_child; child != NIL; child = next)
     {
         next = child->a.pos.next_from_beta_mem;
-        unhashed_positive_node_left_addition(thisAgent, child, New);
+        do_positive_left_addition(thisAgent, child, [&]()
+        {
+            unhashed_positive_node_left_addition(thisAgent, child, New);
+        });
     }
     activation_exit_sanity_check();
 }
@@ -4956,7 +6362,7 @@ void positive_node_left_addition(agent* thisAgent,
         /* --- match found, so call each child node --- */
         for (child = node->first_child; child != NIL; child = child->next_sibling)
         {
-            (*(left_addition_routines[child->node_type]))(thisAgent, child, New, rm->w);
+            do_left_addition(thisAgent, child, New, rm->w);
         }
     }
     activation_exit_sanity_check();
@@ -5002,7 +6408,7 @@ void unhashed_positive_node_left_addition(agent* thisAgent, rete_node* node, tok
         /* --- match found, so call each child node --- */
         for (child = node->first_child; child != NIL; child = child->next_sibling)
         {
-            (*(left_addition_routines[child->node_type]))(thisAgent, child, New, rm->w);
+            do_left_addition(thisAgent, child, New, rm->w);
         }
     }
     activation_exit_sanity_check();
@@ -5045,14 +6451,17 @@ void mp_node_left_addition(agent* thisAgent, rete_node* node, token* tok, wme* w
     hv = node->node_id ^ referent->hash_id;
 
     /* --- build new left token, add it to the hash table --- */
-    token_added(node);
+    token_added(thisAgent, node);
     thisAgent->memoryManager->allocate_with_pool(MP_token, &New);
     new_left_token(New, node, tok, w);
-    insert_token_into_left_ht(thisAgent, New, hv);
-    New->a.ht.referent = referent;
+    insert_token_into_left_ht(thisAgent, New, hv, referent);
 
     if (mp_bnode_is_left_unlinked(node))
     {
+        if (node_is_right_unlinked(node))
+        {
+            relink_doubly_unlinked_node_to_right(node);
+        }
         activation_exit_sanity_check();
         return;
     }
@@ -5099,7 +6508,7 @@ void mp_node_left_addition(agent* thisAgent, rete_node* node, token* tok, wme* w
         /* --- match found, so call each child node --- */
         for (child = node->first_child; child != NIL; child = child->next_sibling)
         {
-            (*(left_addition_routines[child->node_type]))(thisAgent, child, New, rm->w);
+            do_left_addition(thisAgent, child, New, rm->w);
         }
     }
     activation_exit_sanity_check();
@@ -5122,14 +6531,17 @@ void unhashed_mp_node_left_addition(agent* thisAgent, rete_node* node,
     hv = node->node_id;
 
     /* --- build new left token, add it to the hash table --- */
-    token_added(node);
+    token_added(thisAgent, node);
     thisAgent->memoryManager->allocate_with_pool(MP_token, &New);
     new_left_token(New, node, tok, w);
-    insert_token_into_left_ht(thisAgent, New, hv);
-    New->a.ht.referent = NIL;
+    insert_token_into_left_ht(thisAgent, New, hv, NIL);
 
     if (mp_bnode_is_left_unlinked(node))
     {
+        if (node_is_right_unlinked(node))
+        {
+            relink_doubly_unlinked_node_to_right(node);
+        }
         return;
     }
 
@@ -5163,7 +6575,7 @@ void unhashed_mp_node_left_addition(agent* thisAgent, rete_node* node,
         /* --- match found, so call each child node --- */
         for (child = node->first_child; child != NIL; child = child->next_sibling)
         {
-            (*(left_addition_routines[child->node_type]))(thisAgent, child, New, rm->w);
+            do_left_addition(thisAgent, child, New, rm->w);
         }
     }
     activation_exit_sanity_check();
@@ -5172,6 +6584,7 @@ void unhashed_mp_node_left_addition(agent* thisAgent, rete_node* node,
 void positive_node_right_addition(agent* thisAgent, rete_node* node, wme* w)
 {
     uint32_t hv;
+    left_ht_scan scan;
     token* tok;
     Symbol* referent;
     rete_test* rt;
@@ -5195,17 +6608,10 @@ void positive_node_right_addition(agent* thisAgent, rete_node* node, wme* w)
     referent = w->id;
     hv = node->parent->node_id ^ referent->hash_id;
 
-    for (tok = left_ht_bucket(thisAgent, hv); tok != NIL; tok = tok->a.ht.next_in_bucket)
+    for (tok = first_token_in_left_ht(thisAgent, &scan, hv, node->parent, referent); tok != NIL;
+            tok = next_token_in_left_ht(&scan, tok))
     {
-        if (tok->node != node->parent)
-        {
-            continue;
-        }
         /* --- does tok match w? --- */
-        if (tok->a.ht.referent != referent)
-        {
-            continue;
-        }
         failed_a_test = false;
         for (rt = node->b.posneg.other_tests; rt != NIL; rt = rt->next)
             if (! match_left_and_right(thisAgent, rt, tok, w))
@@ -5220,7 +6626,7 @@ void positive_node_right_addition(agent* thisAgent, rete_node* node, wme* w)
         /* --- match found, so call each child node --- */
         for (child = node->first_child; child != NIL; child = child->next_sibling)
         {
-            (*(left_addition_routines[child->node_type]))(thisAgent, child, tok, w);
+            do_left_addition(thisAgent, child, tok, w);
         }
     }
     activation_exit_sanity_check();
@@ -5229,6 +6635,7 @@ void positive_node_right_addition(agent* thisAgent, rete_node* node, wme* w)
 void unhashed_positive_node_right_addition(agent* thisAgent, rete_node* node, wme* w)
 {
     uint32_t hv;
+    left_ht_scan scan;
     token* tok;
     rete_test* rt;
     bool failed_a_test;
@@ -5250,12 +6657,9 @@ void unhashed_positive_node_right_addition(agent* thisAgent, rete_node* node, wm
 
     hv = node->parent->node_id;
 
-    for (tok = left_ht_bucket(thisAgent, hv); tok != NIL; tok = tok->a.ht.next_in_bucket)
+    for (tok = first_token_in_left_ht(thisAgent, &scan, hv, node->parent, NIL); tok != NIL;
+            tok = next_token_in_left_ht(&scan, tok))
     {
-        if (tok->node != node->parent)
-        {
-            continue;
-        }
         /* --- does tok match w? --- */
         failed_a_test = false;
         for (rt = node->b.posneg.other_tests; rt != NIL; rt = rt->next)
@@ -5271,7 +6675,7 @@ void unhashed_positive_node_right_addition(agent* thisAgent, rete_node* node, wm
         /* --- match found, so call each child node --- */
         for (child = node->first_child; child != NIL; child = child->next_sibling)
         {
-            (*(left_addition_routines[child->node_type]))(thisAgent, child, tok, w);
+            do_left_addition(thisAgent, child, tok, w);
         }
     }
     activation_exit_sanity_check();
@@ -5280,6 +6684,7 @@ void unhashed_positive_node_right_addition(agent* thisAgent, rete_node* node, wm
 void mp_node_right_addition(agent* thisAgent, rete_node* node, wme* w)
 {
     uint32_t hv;
+    left_ht_scan scan;
     token* tok;
     Symbol* referent;
     rete_test* rt;
@@ -5303,17 +6708,10 @@ void mp_node_right_addition(agent* thisAgent, rete_node* node, wme* w)
     referent = w->id;
     hv = node->node_id ^ referent->hash_id;
 
-    for (tok = left_ht_bucket(thisAgent, hv); tok != NIL; tok = tok->a.ht.next_in_bucket)
+    for (tok = first_token_in_left_ht(thisAgent, &scan, hv, node, referent); tok != NIL;
+            tok = next_token_in_left_ht(&scan, tok))
     {
-        if (tok->node != node)
-        {
-            continue;
-        }
         /* --- does tok match w? --- */
-        if (tok->a.ht.referent != referent)
-        {
-            continue;
-        }
         failed_a_test = false;
         for (rt = node->b.posneg.other_tests; rt != NIL; rt = rt->next)
         {
@@ -5330,7 +6728,7 @@ void mp_node_right_addition(agent* thisAgent, rete_node* node, wme* w)
         /* --- match found, so call each child node --- */
         for (child = node->first_child; child != NIL; child = child->next_sibling)
         {
-            (*(left_addition_routines[child->node_type]))(thisAgent, child, tok, w);
+            do_left_addition(thisAgent, child, tok, w);
         }
     }
     activation_exit_sanity_check();
@@ -5339,6 +6737,7 @@ void mp_node_right_addition(agent* thisAgent, rete_node* node, wme* w)
 void unhashed_mp_node_right_addition(agent* thisAgent, rete_node* node, wme* w)
 {
     uint32_t hv;
+    left_ht_scan scan;
     token* tok;
     rete_test* rt;
     bool failed_a_test;
@@ -5360,12 +6759,9 @@ void unhashed_mp_node_right_addition(agent* thisAgent, rete_node* node, wme* w)
 
     hv = node->node_id;
 
-    for (tok = left_ht_bucket(thisAgent, hv); tok != NIL; tok = tok->a.ht.next_in_bucket)
+    for (tok = first_token_in_left_ht(thisAgent, &scan, hv, node, NIL); tok != NIL;
+            tok = next_token_in_left_ht(&scan, tok))
     {
-        if (tok->node != node)
-        {
-            continue;
-        }
         /* --- does tok match w? --- */
         failed_a_test = false;
         for (rt = node->b.posneg.other_tests; rt != NIL; rt = rt->next)
@@ -5381,7 +6777,7 @@ void unhashed_mp_node_right_addition(agent* thisAgent, rete_node* node, wme* w)
         /* --- match found, so call each child node --- */
         for (child = node->first_child; child != NIL; child = child->next_sibling)
         {
-            (*(left_addition_routines[child->node_type]))(thisAgent, child, tok, w);
+            do_left_addition(thisAgent, child, tok, w);
         }
     }
     activation_exit_sanity_check();
@@ -5435,11 +6831,10 @@ void negative_node_left_addition(agent* thisAgent, rete_node* node,
     hv = node->node_id ^ referent->hash_id;
 
     /* --- build new token, add it to the hash table --- */
-    token_added(node);
+    token_added(thisAgent, node);
     thisAgent->memoryManager->allocate_with_pool(MP_token, &New);
     new_left_token(New, node, tok, w);
-    insert_token_into_left_ht(thisAgent, New, hv);
-    New->a.ht.referent = referent;
+    insert_token_into_left_ht(thisAgent, New, hv, referent);
     New->negrm_tokens = NIL;
 
     /* --- look through right memory for matches --- */
@@ -5486,7 +6881,7 @@ void negative_node_left_addition(agent* thisAgent, rete_node* node,
     {
         for (child = node->first_child; child != NIL; child = child->next_sibling)
         {
-            (*(left_addition_routines[child->node_type]))(thisAgent, child, New, NIL);
+            do_left_addition(thisAgent, child, New, NIL);
         }
     }
     activation_exit_sanity_check();
@@ -5513,11 +6908,10 @@ void unhashed_negative_node_left_addition(agent* thisAgent, rete_node* node,
     hv = node->node_id;
 
     /* --- build new token, add it to the hash table --- */
-    token_added(node);
+    token_added(thisAgent, node);
     thisAgent->memoryManager->allocate_with_pool(MP_token, &New);
     new_left_token(New, node, tok, w);
-    insert_token_into_left_ht(thisAgent, New, hv);
-    New->a.ht.referent = NIL;
+    insert_token_into_left_ht(thisAgent, New, hv, NIL);
     New->negrm_tokens = NIL;
 
     /* --- look through right memory for matches --- */
@@ -5554,7 +6948,7 @@ void unhashed_negative_node_left_addition(agent* thisAgent, rete_node* node,
     {
         for (child = node->first_child; child != NIL; child = child->next_sibling)
         {
-            (*(left_addition_routines[child->node_type]))(thisAgent, child, New, NIL);
+            do_left_addition(thisAgent, child, New, NIL);
         }
     }
     activation_exit_sanity_check();
@@ -5563,6 +6957,7 @@ void unhashed_negative_node_left_addition(agent* thisAgent, rete_node* node,
 void negative_node_right_addition(agent* thisAgent, rete_node* node, wme* w)
 {
     uint32_t hv;
+    left_ht_scan scan;
     token* tok;
     Symbol* referent;
     rete_test* rt;
@@ -5574,17 +6969,10 @@ void negative_node_right_addition(agent* thisAgent, rete_node* node, wme* w)
     referent = w->id;
     hv = node->node_id ^ referent->hash_id;
 
-    for (tok = left_ht_bucket(thisAgent, hv); tok != NIL; tok = tok->a.ht.next_in_bucket)
+    for (tok = first_token_in_left_ht(thisAgent, &scan, hv, node, referent); tok != NIL;
+            tok = next_token_in_left_ht(&scan, tok))
     {
-        if (tok->node != node)
-        {
-            continue;
-        }
         /* --- does tok match w? --- */
-        if (tok->a.ht.referent != referent)
-        {
-            continue;
-        }
         failed_a_test = false;
         for (rt = node->b.posneg.other_tests; rt != NIL; rt = rt->next)
             if (! match_left_and_right(thisAgent, rt, tok, w))
@@ -5620,6 +7008,7 @@ void negative_node_right_addition(agent* thisAgent, rete_node* node, wme* w)
 void unhashed_negative_node_right_addition(agent* thisAgent, rete_node* node, wme* w)
 {
     uint32_t hv;
+    left_ht_scan scan;
     token* tok;
     rete_test* rt;
     bool failed_a_test;
@@ -5629,12 +7018,9 @@ void unhashed_negative_node_right_addition(agent* thisAgent, rete_node* node, wm
 
     hv = node->node_id;
 
-    for (tok = left_ht_bucket(thisAgent, hv); tok != NIL; tok = tok->a.ht.next_in_bucket)
+    for (tok = first_token_in_left_ht(thisAgent, &scan, hv, node, NIL); tok != NIL;
+            tok = next_token_in_left_ht(&scan, tok))
     {
-        if (tok->node != node)
-        {
-            continue;
-        }
         /* --- does tok match w? --- */
         failed_a_test = false;
         for (rt = node->b.posneg.other_tests; rt != NIL; rt = rt->next)
@@ -5680,6 +7066,7 @@ void unhashed_negative_node_right_addition(agent* thisAgent, rete_node* node, wm
 void cn_node_left_addition(agent* thisAgent, rete_node* node, token* tok, wme* w)
 {
     uint32_t hv;
+    left_ht_scan scan;
     token* t, *New;
     rete_node* child;
 
@@ -5691,23 +7078,24 @@ void cn_node_left_addition(agent* thisAgent, rete_node* node, token* tok, wme* w
     /* --- look for a matching left token (since the partner node might have
        heard about this new token already, in which case it would have done
        the CN node's work already); if found, exit --- */
-    for (t = left_ht_bucket(thisAgent, hv); t != NIL; t = t->a.ht.next_in_bucket)
-        if ((t->node == node) && (t->parent == tok) && (t->w == w))
+    for (t = first_token_in_left_ht(thisAgent, &scan, hv, node, NIL); t != NIL;
+            t = next_token_in_left_ht(&scan, t))
+        if ((t->parent == tok) && (t->w == w))
         {
             return;
         }
 
     /* --- build left token, add it to the hash table --- */
-    token_added(node);
+    token_added(thisAgent, node);
     thisAgent->memoryManager->allocate_with_pool(MP_token, &New);
     new_left_token(New, node, tok, w);
-    insert_token_into_left_ht(thisAgent, New, hv);
+    insert_token_into_left_ht(thisAgent, New, hv, NIL);
     New->negrm_tokens = NIL;
 
     /* --- pass the new token on to each child node --- */
     for (child = node->first_child; child != NIL; child = child->next_sibling)
     {
-        (*(left_addition_routines[child->node_type]))(thisAgent, child, New, NIL);
+        do_left_addition(thisAgent, child, New, NIL);
     }
 
     activation_exit_sanity_check();
@@ -5718,6 +7106,7 @@ void cn_partner_node_left_addition(agent* thisAgent, rete_node* node,
 {
     rete_node* partner, *temp;
     uint32_t hv;
+    left_ht_scan scan;
     token* left, *negrm_tok;
 
     activation_entry_sanity_check();
@@ -5726,7 +7115,7 @@ void cn_partner_node_left_addition(agent* thisAgent, rete_node* node,
     partner = node->b.cn.partner;
 
     /* --- build new negrm token --- */
-    token_added(node);
+    token_added(thisAgent, node);
     thisAgent->memoryManager->allocate_with_pool(MP_token, &negrm_tok);
     new_left_token(negrm_tok, node, tok, w);
 
@@ -5741,8 +7130,9 @@ void cn_partner_node_left_addition(agent* thisAgent, rete_node* node,
 
     /* --- look for the matching left token --- */
     hv = partner->node_id ^ cast_and_possibly_truncate<uint32_t>(tok) ^ cast_and_possibly_truncate<uint32_t>(w);
-    for (left = left_ht_bucket(thisAgent, hv); left != NIL; left = left->a.ht.next_in_bucket)
-        if ((left->node == partner) && (left->parent == tok) && (left->w == w))
+    for (left = first_token_in_left_ht(thisAgent, &scan, hv, partner, NIL); left != NIL;
+            left = next_token_in_left_ht(&scan, left))
+        if ((left->parent == tok) && (left->w == w))
         {
             break;
         }
@@ -5750,10 +7140,10 @@ void cn_partner_node_left_addition(agent* thisAgent, rete_node* node,
     /* --- if not found, create a new left token --- */
     if (!left)
     {
-        token_added(partner);
+        token_added(thisAgent, partner);
         thisAgent->memoryManager->allocate_with_pool(MP_token, &left);
         new_left_token(left, partner, tok, w);
-        insert_token_into_left_ht(thisAgent, left, hv);
+        insert_token_into_left_ht(thisAgent, left, hv, NIL);
         left->negrm_tokens = NIL;
     }
 
@@ -5821,7 +7211,7 @@ void p_node_left_addition(agent* thisAgent, rete_node* node, token* tok, wme* w)
     left_node_activation(node, true);
 
     /* --- build new left token (used only for tree-based remove) --- */
-    token_added(node);
+    token_added(thisAgent, node);
     thisAgent->memoryManager->allocate_with_pool(MP_token, &New);
     new_left_token(New, node, tok, w);
 
@@ -6416,12 +7806,16 @@ void remove_token_and_subtree(agent* thisAgent, token* root)
             remove_token_from_left_ht(thisAgent, tok, node->node_id ^
                                       (tok->a.ht.referent ?
                                        tok->a.ht.referent->hash_id : 0));
-            if (! mp_bnode_is_left_unlinked(node))
+            if (! node->a.np.tokens)
             {
-                if (! node->a.np.tokens)
+                if (! mp_bnode_is_left_unlinked(node))
                 {
                     unlink_from_right_mem(node);
                 }
+                else
+                {
+                    doubly_unlink_node(thisAgent, node);
+                }
             }
 
             /* --- for P nodes --- */
@@ -6473,6 +7867,16 @@ void remove_token_and_subtree(agent* thisAgent, token* root)
                     next = child->a.pos.next_from_beta_mem;
                     unlink_from_right_mem(child);
                 }
+                /* --- and doubly unlink the left-unlinked ones (see "Double
+                   Unlinking" above) --- */
+                for (child = node->first_child; child != NIL; child = child->next_sibling)
+                {
+                    if (bnode_is_bottom_of_split_mp(child->node_type) &&
+                            node_is_left_unlinked(child) && ! node_is_right_unlinked(child))
+                    {
+                        doubly_unlink_node(thisAgent, child);
+                    }
+                }
             }
 
             /* --- for CN nodes --- */
@@ -6506,7 +7910,7 @@ void remove_token_and_subtree(agent* thisAgent, token* root)
                 for (child = left->node->first_child; child != NIL;
                         child = child->next_sibling)
                 {
-                    (*(left_addition_routines[child->node_type]))(thisAgent, child, left, NIL);
+                    do_left_addition(thisAgent, child, left, NIL);
                 }
             }
 
@@ -6608,15 +8012,64 @@ void remove_token_and_subtree(agent* thisAgent, token* root)
     4 bytes: number of children
     node records for each child
 
+  Version 4 is identical to version 3 except that all index numbers and
+  counts are 8 bytes instead of 4.
+
+  File format (version 5):
+     magic number sequence and null byte, as above
+     1 byte: format version number (5)
+     4 bytes: number of sections
+       for each section:
+         4 bytes: section id (RETE_FS_SYMBOL_SECTION, etc.)
+         8 bytes: offset of the section from the start of the file
+         8 bytes: length of the section
+         4 bytes: CRC-32 of the section
+     4 bytes: CRC-32 of everything above
+
+     The sections hold the symbol table, the alpha memories and the node
+     records, each encoded exactly as in version 4.  The whole file is
+     built in memory and written with one fwrite().  On load, the whole
+     file is memory mapped (or read in one go where mmap isn't available)
+     and every checksum is verified before the current rete is touched,
+     so a truncated or corrupted file is rejected up front.  Strings are
+     read in place from the mapped file instead of being copied out byte
+     by byte.  Versions 3 and 4 are still loaded through the FILE.
+
+  Shared rete nets are version 5 images kept in memory instead of in a
+  file; see "Shared Rete Nets" below.
+
   EXTERNAL INTERFACE:
   Save_rete_net() and load_rete_net() save and load everything to and
-  from the given (already open) files.  They return true if successful,
-  false if any error occurred.
+  from the given (already open) files.  Share_rete_net(),
+  attach_shared_rete_net() and unshare_rete_net() manage the shared
+  images.  They all return true if successful, false if any error
+  occurred.
 ********************************************************************** */
 
 FILE* rete_fs_file;  /* File handle we're using -- "fs" for "fast-save" */
 bool rete_net_64; // used by reteload_eight_bytes, retesave_eight_bytes, BADBAD global, fix with rete_fs_file above
 
+/* --- The globals above and below are shared by every agent in the
+   process, so each save or load holds rete_fs_mutex throughout. --- */
+std::mutex rete_fs_mutex;
+
+/* --- Version 5 byte sink and source.  While a section is being saved its
+   bytes go to rete_fs_save_buffer instead of rete_fs_file; while a version
+   5 file is being loaded, bytes come from [rete_fs_load_pos, rete_fs_load_end)
+   instead of the FILE.  Running off the end sets rete_fs_load_overrun. --- */
+std::vector<uint8_t>* rete_fs_save_buffer = NIL;
+const uint8_t* rete_fs_load_pos = NIL;
+const uint8_t* rete_fs_load_end = NIL;
+bool rete_fs_load_overrun = false;
+
+#define RETE_FS_MAGIC_STRING "SoarCompactReteNet\n"
+#define RETE_FS_SECTIONED_VERSION 5
+
+#define RETE_FS_SYMBOL_SECTION    1
+#define RETE_FS_ALPHA_MEM_SECTION 2
+#define RETE_FS_NODE_SECTION      3
+#define RETE_FS_NUM_SECTIONS      3
+
 /* ----------------------------------------------------------------------
                 Save/Load Bytes, Short and Long Integers
 
@@ -6628,11 +8081,25 @@ bool rete_net_64; // used by reteload_eight_bytes, retesave_eight_bytes, BADBAD
 
 void retesave_one_byte(uint8_t b, FILE* /*f*/)
 {
+    if (rete_fs_save_buffer)
+    {
+        rete_fs_save_buffer->push_back(b);
+        return;
+    }
     fputc(b, rete_fs_file);
 }
 
 uint8_t reteload_one_byte(FILE* f)
 {
+    if (rete_fs_load_pos)
+    {
+        if (rete_fs_load_pos < rete_fs_load_end)
+        {
+            return *(rete_fs_load_pos++);
+        }
+        rete_fs_load_overrun = true;
+        return 0;
+    }
     return static_cast<uint8_t>(fgetc(f));
 }
 
@@ -6713,35 +8180,175 @@ uint64_t reteload_eight_bytes(FILE* f)
 }
 
 /* ----------------------------------------------------------------------
-                            Save/Load Strings
+                            Save/Load Strings
+
+   Strings are written as null-terminated sequences of characters, just
+   like the usual C format.  Reteload_string() returns the string read:
+   when loading from a FILE it is copied into reteload_string_buf[]; when
+   loading a mapped version 5 file it points straight into the file.
+   Either way it is only valid until the next call.
+---------------------------------------------------------------------- */
+
+char reteload_string_buf[4 * MAX_LEXEME_LENGTH];
+
+void retesave_string(const char* s, FILE* f)
+{
+    if (rete_fs_save_buffer)
+    {
+        rete_fs_save_buffer->insert(rete_fs_save_buffer->end(), s, s + strlen(s) + 1);
+        return;
+    }
+    while (*s)
+    {
+        retesave_one_byte(*s, f);
+        s++;
+    }
+    retesave_one_byte(0, f);
+}
+
+const char* reteload_string(FILE* f)
+{
+    const uint8_t* end_of_string;
+    const char* result;
+    size_t i;
+    int ch;
+
+    if (rete_fs_load_pos)
+    {
+        end_of_string = static_cast<const uint8_t*>(memchr(rete_fs_load_pos, 0, rete_fs_load_end - rete_fs_load_pos));
+        if (!end_of_string)
+        {
+            rete_fs_load_overrun = true;
+            rete_fs_load_pos = rete_fs_load_end;
+            return "";
+        }
+        result = reinterpret_cast<const char*>(rete_fs_load_pos);
+        rete_fs_load_pos = end_of_string + 1;
+        return result;
+    }
+
+    for (i = 0; i < sizeof(reteload_string_buf) - 1; i++)
+    {
+        ch = fgetc(f);
+        if ((ch == 0) || (ch == EOF))
+        {
+            break;
+        }
+        reteload_string_buf[i] = static_cast<char>(ch);
+    }
+    reteload_string_buf[i] = 0;
+    return reteload_string_buf;
+}
+
+/* ----------------------------------------------------------------------
+                      Checksums and File Mapping
 
-   Strings are written as null-terminated sequences of characters, just
-   like the usual C format.  Reteload_string() leaves the result in
-   reteload_string_buf[].
+   Version 5 files carry a CRC-32 (the usual reflected 0xEDB88320
+   polynomial) for the header and for each section.  Map_rete_fs_file()
+   makes the whole file available as one block of memory, using mmap()
+   where it is available and reading the file in otherwise.
 ---------------------------------------------------------------------- */
 
-char reteload_string_buf[4 * MAX_LEXEME_LENGTH];
+struct rete_fs_crc_table
+{
+    uint32_t entries[256];
 
-void retesave_string(const char* s, FILE* f)
+    rete_fs_crc_table()
+    {
+        uint32_t c;
+        int i, k;
+
+        for (i = 0; i < 256; i++)
+        {
+            c = static_cast<uint32_t>(i);
+            for (k = 0; k < 8; k++)
+            {
+                c = (c & 1) ? (0xEDB88320 ^ (c >> 1)) : (c >> 1);
+            }
+            entries[i] = c;
+        }
+    }
+};
+
+uint32_t rete_fs_crc32(const uint8_t* data, size_t length)
 {
-    while (*s)
+    static const rete_fs_crc_table table;
+    uint32_t crc = 0xFFFFFFFF;
+
+    while (length--)
     {
-        retesave_one_byte(*s, f);
-        s++;
+        crc = table.entries[(crc ^ *(data++)) & 0xFF] ^ (crc >> 8);
     }
-    retesave_one_byte(0, f);
+    return crc ^ 0xFFFFFFFF;
+}
+
+typedef struct rete_fs_mapping_struct
+{
+    uint8_t* data;
+    size_t size;
+    bool is_mapped;          /* true: munmap() it, false: free() it */
+} rete_fs_mapping;
+
+bool map_rete_fs_file(FILE* f, rete_fs_mapping* mapping)
+{
+    long size;
+
+    mapping->data = NIL;
+    mapping->size = 0;
+    mapping->is_mapped = false;
+
+#ifndef _WIN32
+    struct stat st;
+    void* mapped;
+
+    if ((fstat(fileno(f), &st) == 0) && (st.st_size > 0))
+    {
+        mapped = mmap(NULL, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fileno(f), 0);
+        if (mapped != MAP_FAILED)
+        {
+            mapping->data = static_cast<uint8_t*>(mapped);
+            mapping->size = static_cast<size_t>(st.st_size);
+            mapping->is_mapped = true;
+            return true;
+        }
+    }
+#endif
+
+    if ((fseek(f, 0, SEEK_END) != 0) || ((size = ftell(f)) <= 0) || (fseek(f, 0, SEEK_SET) != 0))
+    {
+        return false;
+    }
+    mapping->data = static_cast<uint8_t*>(malloc(static_cast<size_t>(size)));
+    if (!mapping->data)
+    {
+        return false;
+    }
+    mapping->size = static_cast<size_t>(size);
+    if (fread(mapping->data, 1, mapping->size, f) != mapping->size)
+    {
+        free(mapping->data);
+        mapping->data = NIL;
+        return false;
+    }
+    return true;
 }
 
-void reteload_string(FILE* f)
+void unmap_rete_fs_file(rete_fs_mapping* mapping)
 {
-    int i, ch;
-    i = 0;
-    do
+    if (!mapping->data)
+    {
+        return;
+    }
+#ifndef _WIN32
+    if (mapping->is_mapped)
     {
-        ch = reteload_one_byte(f);
-        reteload_string_buf[i++] = static_cast<char>(ch);
+        munmap(mapping->data, mapping->size);
+        mapping->data = NIL;
+        return;
     }
-    while (ch);
+#endif
+    free(mapping->data);
+    mapping->data = NIL;
 }
 
 /* ----------------------------------------------------------------------
@@ -6750,7 +8357,7 @@ void reteload_string(FILE* f)
    We write out symbol names once at the beginning of the file, and
    thereafter refer to symbols using 32-bit index numbers instead of their
    full names.  Retesave_symbol_and_assign_index() writes out one symbol
-   and assigns it an index (stored in sym->retesave_symindex).
+   and assigns it an index (stored in the symbol's side data).
    Index numbers are assigned sequentially -- the first symbol in the file
    has index number 1, the second has number 2, etc.  Retesave_symbol_table()
    saves the whole symbol table, using the following format:
@@ -6778,6 +8385,11 @@ void retesave_symbol_table(agent* thisAgent, FILE* f)
     thisAgent->symbolManager->retesave(f);
 }
 
+inline uint64_t retesave_symindex_of(agent* thisAgent, Symbol* sym)
+{
+    return sym ? thisAgent->symbolManager->side_data(sym).retesave_symindex : 0;
+}
+
 void reteload_all_symbols(agent* thisAgent, FILE* f)
 {
     uint64_t num_str_constants, num_variables;
@@ -6801,25 +8413,21 @@ void reteload_all_symbols(agent* thisAgent, FILE* f)
     current_place_in_symtab = thisAgent->reteload_symbol_table;
     for (i = 0; i < num_str_constants; i++)
     {
-        reteload_string(f);
-        *(current_place_in_symtab++) = thisAgent->symbolManager->make_str_constant(reteload_string_buf);
+        *(current_place_in_symtab++) = thisAgent->symbolManager->make_str_constant(reteload_string(f));
     }
     for (i = 0; i < num_variables; i++)
     {
-        reteload_string(f);
-        *(current_place_in_symtab++) = thisAgent->symbolManager->make_variable(reteload_string_buf);
+        *(current_place_in_symtab++) = thisAgent->symbolManager->make_variable(reteload_string(f));
     }
     for (i = 0; i < num_int_constants; i++)
     {
-        reteload_string(f);
         *(current_place_in_symtab++) =
-            thisAgent->symbolManager->make_int_constant(strtol(reteload_string_buf, NULL, 10));
+            thisAgent->symbolManager->make_int_constant(strtol(reteload_string(f), NULL, 10));
     }
     for (i = 0; i < num_float_constants; i++)
     {
-        reteload_string(f);
         *(current_place_in_symtab++) =
-            thisAgent->symbolManager->make_float_constant(strtod(reteload_string_buf, NULL));
+            thisAgent->symbolManager->make_float_constant(strtod(reteload_string(f), NULL));
     }
 }
 
@@ -6887,9 +8495,9 @@ bool retesave_alpha_mem_and_assign_index(agent* thisAgent, void* item, void* use
     am = static_cast<alpha_mem_struct*>(item);
     thisAgent->current_retesave_amindex++;
     am->retesave_amindex = thisAgent->current_retesave_amindex;
-    retesave_eight_bytes(am->id ? am->id->retesave_symindex : 0, f);
-    retesave_eight_bytes(am->attr ? am->attr->retesave_symindex : 0, f);
-    retesave_eight_bytes(am->value ? am->value->retesave_symindex : 0, f);
+    retesave_eight_bytes(retesave_symindex_of(thisAgent, am->id), f);
+    retesave_eight_bytes(retesave_symindex_of(thisAgent, am->attr), f);
+    retesave_eight_bytes(retesave_symindex_of(thisAgent, am->value), f);
     retesave_one_byte(static_cast<byte>(am->acceptable ? 1 : 0), f);
     return false;
 }
@@ -6971,7 +8579,7 @@ void reteload_free_am_table(agent* thisAgent)
     if list: 4 bytes (number of items) + list of symindices
 ---------------------------------------------------------------------- */
 
-void retesave_varnames(varnames* names, FILE* f)
+void retesave_varnames(agent* thisAgent, varnames* names, FILE* f)
 {
     cons* c;
     uint64_t i;
@@ -6985,7 +8593,7 @@ void retesave_varnames(varnames* names, FILE* f)
     {
         retesave_one_byte(1, f);
         sym = varnames_to_one_var(names);
-        retesave_eight_bytes(sym->retesave_symindex, f);
+        retesave_eight_bytes(retesave_symindex_of(thisAgent, sym), f);
     }
     else
     {
@@ -6994,7 +8602,7 @@ void retesave_varnames(varnames* names, FILE* f)
         retesave_eight_bytes(i, f);
         for (c = varnames_to_var_list(names); c != NIL; c = c->rest)
         {
-            retesave_eight_bytes(static_cast<Symbol*>(c->first)->retesave_symindex, f);
+            retesave_eight_bytes(retesave_symindex_of(thisAgent, static_cast<Symbol*>(c->first)), f);
         }
     }
 }
@@ -7031,7 +8639,7 @@ varnames* reteload_varnames(agent* thisAgent, FILE* f)
     }
 }
 
-void retesave_node_varnames(node_varnames* nvn, rete_node* node, FILE* f)
+void retesave_node_varnames(agent* thisAgent, node_varnames* nvn, rete_node* node, FILE* f)
 {
     while (true)
     {
@@ -7045,9 +8653,9 @@ void retesave_node_varnames(node_varnames* nvn, rete_node* node, FILE* f)
             nvn = nvn->data.bottom_of_subconditions;
             continue;
         }
-        retesave_varnames(nvn->data.fields.id_varnames, f);
-        retesave_varnames(nvn->data.fields.attr_varnames, f);
-        retesave_varnames(nvn->data.fields.value_varnames, f);
+        retesave_varnames(thisAgent, nvn->data.fields.id_varnames, f);
+        retesave_varnames(thisAgent, nvn->data.fields.attr_varnames, f);
+        retesave_varnames(thisAgent, nvn->data.fields.value_varnames, f);
         nvn = nvn->parent;
         node = real_parent_node(node);
     }
@@ -7097,7 +8705,7 @@ node_varnames* reteload_node_varnames(agent* thisAgent, rete_node* node, FILE* f
     for rhs_unbound_vars: 4 bytes (symindex)
 ---------------------------------------------------------------------- */
 
-void retesave_rhs_value(rhs_value rv, FILE* f)
+void retesave_rhs_value(agent* thisAgent, rhs_value rv, FILE* f)
 {
     uint64_t i;
     Symbol* sym;
@@ -7107,20 +8715,20 @@ void retesave_rhs_value(rhs_value rv, FILE* f)
     {
         retesave_one_byte(0, f);
         sym = rhs_value_to_symbol(rv);
-        retesave_eight_bytes(sym->retesave_symindex, f);
+        retesave_eight_bytes(retesave_symindex_of(thisAgent, sym), f);
     }
     else if (rhs_value_is_funcall(rv))
     {
         retesave_one_byte(1, f);
         c = rhs_value_to_funcall_list(rv);
         sym = static_cast<rhs_function*>(c->first)->name;
-        retesave_eight_bytes(sym->retesave_symindex, f);
+        retesave_eight_bytes(retesave_symindex_of(thisAgent, sym), f);
         c = c->rest;
         for (i = 0; c != NIL; i++, c = c->rest);
         retesave_eight_bytes(i, f);
         for (c = rhs_value_to_funcall_list(rv)->rest; c != NIL; c = c->rest)
         {
-            retesave_rhs_value(static_cast<rhs_value>(c->first), f);
+            retesave_rhs_value(thisAgent, static_cast<rhs_value>(c->first), f);
         }
     }
     else if (rhs_value_is_reteloc(rv))
@@ -7226,23 +8834,23 @@ rhs_value reteload_rhs_value(agent* thisAgent, FILE* f)
     record for each one (as above)
 ---------------------------------------------------------------------- */
 
-void retesave_rhs_action(action* a, FILE* f)
+void retesave_rhs_action(agent* thisAgent, action* a, FILE* f)
 {
     retesave_one_byte(a->type, f);
     retesave_one_byte(a->preference_type, f);
     retesave_one_byte(a->support, f);
     if (a->type == FUNCALL_ACTION)
     {
-        retesave_rhs_value(a->value, f);
+        retesave_rhs_value(thisAgent, a->value, f);
     }
     else     /* MAKE_ACTION's */
     {
-        retesave_rhs_value(a->id, f);
-        retesave_rhs_value(a->attr, f);
-        retesave_rhs_value(a->value, f);
+        retesave_rhs_value(thisAgent, a->id, f);
+        retesave_rhs_value(thisAgent, a->attr, f);
+        retesave_rhs_value(thisAgent, a->value, f);
         if (preference_is_binary(a->preference_type))
         {
-            retesave_rhs_value(a->referent, f);
+            retesave_rhs_value(thisAgent, a->referent, f);
         }
     }
 }
@@ -7276,7 +8884,7 @@ action* reteload_rhs_action(agent* thisAgent, FILE* f)
     return a;
 }
 
-void retesave_action_list(action* first_a, FILE* f)
+void retesave_action_list(agent* thisAgent, action* first_a, FILE* f)
 {
     uint64_t i;
     action* a;
@@ -7285,7 +8893,7 @@ void retesave_action_list(action* first_a, FILE* f)
     retesave_eight_bytes(i, f);
     for (a = first_a; a != NIL; a = a->next)
     {
-        retesave_rhs_action(a, f);
+        retesave_rhs_action(thisAgent, a, f);
     }
 }
 
@@ -7337,7 +8945,7 @@ action* reteload_action_list(agent* thisAgent, FILE* f)
     Rete test records (as above) for each one
 ---------------------------------------------------------------------- */
 
-void retesave_rete_test(rete_test* rt, FILE* f)
+void retesave_rete_test(agent* thisAgent, rete_test* rt, FILE* f)
 {
     int i;
     cons* c;
@@ -7346,7 +8954,7 @@ void retesave_rete_test(rete_test* rt, FILE* f)
     retesave_one_byte(rt->right_field_num, f);
     if (test_is_constant_relational_test(rt->type))
     {
-        retesave_eight_bytes(rt->data.constant_referent->retesave_symindex, f);
+        retesave_eight_bytes(retesave_symindex_of(thisAgent, rt->data.constant_referent), f);
     }
     else if (test_is_variable_relational_test(rt->type))
     {
@@ -7359,7 +8967,7 @@ void retesave_rete_test(rete_test* rt, FILE* f)
         retesave_two_bytes(static_cast<uint16_t>(i), f);
         for (c = rt->data.disjunction_list; c != NIL; c = c->rest)
         {
-            retesave_eight_bytes(static_cast<Symbol*>(c->first)->retesave_symindex, f);
+            retesave_eight_bytes(retesave_symindex_of(thisAgent, static_cast<Symbol*>(c->first)), f);
         }
     }
 }
@@ -7401,7 +9009,7 @@ rete_test* reteload_rete_test(agent* thisAgent, FILE* f)
     return rt;
 }
 
-void retesave_rete_test_list(rete_test* first_rt, FILE* f)
+void retesave_rete_test_list(agent* thisAgent, rete_test* first_rt, FILE* f)
 {
     uint64_t i;
     rete_test* rt;
@@ -7410,7 +9018,7 @@ void retesave_rete_test_list(rete_test* first_rt, FILE* f)
     retesave_two_bytes(static_cast<uint16_t>(i), f);
     for (rt = first_rt; rt != NIL; rt = rt->next)
     {
-        retesave_rete_test(rt, f);
+        retesave_rete_test(thisAgent, rt, f);
     }
 }
 
@@ -7547,14 +9155,14 @@ void retesave_rete_node_and_children(agent* thisAgent, rete_node* node, FILE* f)
         /* ... and fall through to the next case below ... */
         case UNHASHED_MP_BNODE:
             retesave_eight_bytes(node->b.posneg.alpha_mem_->retesave_amindex, f);
-            retesave_rete_test_list(node->b.posneg.other_tests, f);
+            retesave_rete_test_list(thisAgent, node->b.posneg.other_tests, f);
             retesave_one_byte(static_cast<byte>(node->a.np.is_left_unlinked ? 1 : 0), f);
             break;
 
         case POSITIVE_BNODE:
         case UNHASHED_POSITIVE_BNODE:
             retesave_eight_bytes(node->b.posneg.alpha_mem_->retesave_amindex, f);
-            retesave_rete_test_list(node->b.posneg.other_tests, f);
+            retesave_rete_test_list(thisAgent, node->b.posneg.other_tests, f);
             retesave_one_byte(static_cast<byte>(node_is_left_unlinked(node) ? 1 : 0), f);
             break;
 
@@ -7564,7 +9172,7 @@ void retesave_rete_node_and_children(agent* thisAgent, rete_node* node, FILE* f)
         /* ... and fall through to the next case below ... */
         case UNHASHED_NEGATIVE_BNODE:
             retesave_eight_bytes(node->b.posneg.alpha_mem_->retesave_amindex, f);
-            retesave_rete_test_list(node->b.posneg.other_tests, f);
+            retesave_rete_test_list(thisAgent, node->b.posneg.other_tests, f);
             break;
 
         case CN_PARTNER_BNODE:
@@ -7580,7 +9188,7 @@ void retesave_rete_node_and_children(agent* thisAgent, rete_node* node, FILE* f)
 
         case P_BNODE:
             prod = node->b.p.prod;
-            retesave_eight_bytes(prod->name->retesave_symindex, f);
+            retesave_eight_bytes(retesave_symindex_of(thisAgent, prod->name), f);
             if (prod->documentation)
             {
                 retesave_one_byte(1, f);
@@ -7592,17 +9200,17 @@ void retesave_rete_node_and_children(agent* thisAgent, rete_node* node, FILE* f)
             }
             retesave_one_byte(prod->type, f);
             retesave_one_byte(prod->declared_support, f);
-            retesave_action_list(prod->action_list, f);
+            retesave_action_list(thisAgent, prod->action_list, f);
             for (i = 0, c = prod->rhs_unbound_variables; c != NIL; i++, c = c->rest);
             retesave_eight_bytes(i, f);
             for (c = prod->rhs_unbound_variables; c != NIL; c = c->rest)
             {
-                retesave_eight_bytes(static_cast<Symbol*>(c->first)->retesave_symindex, f);
+                retesave_eight_bytes(retesave_symindex_of(thisAgent, static_cast<Symbol*>(c->first)), f);
             }
             if (node->b.p.parents_nvn)
             {
                 retesave_one_byte(1, f);
-                retesave_node_varnames(node->b.p.parents_nvn, node->parent, f);
+                retesave_node_varnames(thisAgent, node->b.p.parents_nvn, node->parent, f);
             }
             else
             {
@@ -7733,8 +9341,7 @@ void reteload_node_and_children(agent* thisAgent, rete_node* parent, FILE* f)
             sym->sc->production = prod;
             if (reteload_one_byte(f))
             {
-                reteload_string(f);
-                prod->documentation = make_memory_block_for_string(thisAgent, reteload_string_buf);
+                prod->documentation = make_memory_block_for_string(thisAgent, reteload_string(f));
             }
             else
             {
@@ -7828,8 +9435,175 @@ void reteload_node_and_children(agent* thisAgent, rete_node* parent, FILE* f)
   false if any error occurred.
 ---------------------------------------------------------------------- */
 
+/* ----------------------------------------------------------------------
+                      Sectioned (Version 5) Save/Load
+
+   Build_rete_fs_image() builds each section in memory, then lays out
+   the header, section table and sections one after another in a single
+   image; retesave_sections() writes that image with one fwrite().
+   Check_rete_fs_sections() validates the header and every checksum of a
+   mapped file and fills in where each section lives;
+   reteload_sections() then loads the sections straight out of the map.
+---------------------------------------------------------------------- */
+
+typedef struct rete_fs_section_struct
+{
+    uint32_t id;
+    uint64_t offset;
+    uint64_t length;
+} rete_fs_section;
+
+void build_rete_fs_image(agent* thisAgent, std::vector<uint8_t>& image)
+{
+    std::vector<uint8_t> sections[RETE_FS_NUM_SECTIONS];
+    uint32_t section_ids[RETE_FS_NUM_SECTIONS] = { RETE_FS_SYMBOL_SECTION, RETE_FS_ALPHA_MEM_SECTION, RETE_FS_NODE_SECTION };
+    uint64_t offset;
+    int i;
+
+    rete_fs_save_buffer = &sections[0];
+    retesave_symbol_table(thisAgent, NIL);
+    rete_fs_save_buffer = &sections[1];
+    retesave_alpha_memories(thisAgent, NIL);
+    rete_fs_save_buffer = &sections[2];
+    retesave_children_of_node(thisAgent, thisAgent->dummy_top_node, NIL);
+
+    /* --- magic string + null, version, section count, section table, crc --- */
+    offset = strlen(RETE_FS_MAGIC_STRING) + 1 + 1 + 4 + (RETE_FS_NUM_SECTIONS * (4 + 8 + 8 + 4)) + 4;
+
+    image.clear();
+    image.reserve(offset + sections[0].size() + sections[1].size() + sections[2].size());
+    rete_fs_save_buffer = &image;
+    retesave_string(RETE_FS_MAGIC_STRING, NIL);
+    retesave_one_byte(RETE_FS_SECTIONED_VERSION, NIL);
+    retesave_four_bytes(RETE_FS_NUM_SECTIONS, NIL);
+    for (i = 0; i < RETE_FS_NUM_SECTIONS; i++)
+    {
+        retesave_four_bytes(section_ids[i], NIL);
+        retesave_eight_bytes(offset, NIL);
+        retesave_eight_bytes(sections[i].size(), NIL);
+        retesave_four_bytes(rete_fs_crc32(sections[i].data(), sections[i].size()), NIL);
+        offset += sections[i].size();
+    }
+    retesave_four_bytes(rete_fs_crc32(image.data(), image.size()), NIL);
+    rete_fs_save_buffer = NIL;
+
+    for (i = 0; i < RETE_FS_NUM_SECTIONS; i++)
+    {
+        image.insert(image.end(), sections[i].begin(), sections[i].end());
+    }
+}
+
+bool retesave_sections(agent* thisAgent, FILE* dest_file)
+{
+    std::vector<uint8_t> image;
+
+    build_rete_fs_image(thisAgent, image);
+    return (fwrite(image.data(), 1, image.size(), dest_file) == image.size());
+}
+
+bool check_rete_fs_sections(agent* thisAgent, rete_fs_mapping* mapping,
+                            rete_fs_section sections[RETE_FS_NUM_SECTIONS])
+{
+    std::vector<rete_fs_section> table;
+    std::vector<uint32_t> crcs;
+    rete_fs_section entry;
+    uint32_t num_sections, stored_crc;
+    size_t header_length, i;
+
+    /* --- read the section table, then make sure the header is intact
+       before believing anything in it --- */
+    rete_fs_load_pos = mapping->data;
+    rete_fs_load_end = mapping->data + mapping->size;
+    rete_fs_load_overrun = false;
+
+    reteload_string(NIL);
+    reteload_one_byte(NIL);
+    num_sections = reteload_four_bytes(NIL);
+    for (i = 0; (i < num_sections) && !rete_fs_load_overrun; i++)
+    {
+        entry.id = reteload_four_bytes(NIL);
+        entry.offset = reteload_eight_bytes(NIL);
+        entry.length = reteload_eight_bytes(NIL);
+        table.push_back(entry);
+        crcs.push_back(reteload_four_bytes(NIL));
+    }
+    header_length = rete_fs_load_pos - mapping->data;
+    stored_crc = reteload_four_bytes(NIL);
+    rete_fs_load_pos = NIL;
+    rete_fs_load_end = NIL;
+    if (rete_fs_load_overrun || (rete_fs_crc32(mapping->data, header_length) != stored_crc))
+    {
+        thisAgent->outputManager->printa_sf(thisAgent, "Rete net file is corrupted (bad header).\n");
+        return false;
+    }
+
+    for (i = 0; i < RETE_FS_NUM_SECTIONS; i++)
+    {
+        sections[i].id = 0;
+    }
+    for (i = 0; i < table.size(); i++)
+    {
+        if ((table[i].offset > mapping->size) || (table[i].length > mapping->size - table[i].offset))
+        {
+            thisAgent->outputManager->printa_sf(thisAgent, "Rete net file is truncated (section %u out of bounds).\n", table[i].id);
+            return false;
+        }
+        if (rete_fs_crc32(mapping->data + table[i].offset, static_cast<size_t>(table[i].length)) != crcs[i])
+        {
+            thisAgent->outputManager->printa_sf(thisAgent, "Rete net file is corrupted (checksum mismatch in section %u).\n", table[i].id);
+            return false;
+        }
+        /* --- unknown sections are skipped, for forward compatibility --- */
+        if ((table[i].id >= RETE_FS_SYMBOL_SECTION) && (table[i].id <= RETE_FS_NUM_SECTIONS))
+        {
+            sections[table[i].id - 1] = table[i];
+        }
+    }
+    for (i = 0; i < RETE_FS_NUM_SECTIONS; i++)
+    {
+        if (sections[i].id == 0)
+        {
+            thisAgent->outputManager->printa_sf(thisAgent, "Rete net file is missing section %d.\n", static_cast<int>(i + 1));
+            return false;
+        }
+    }
+    return true;
+}
+
+inline void start_reteload_section(rete_fs_mapping* mapping, rete_fs_section* section)
+{
+    rete_fs_load_pos = mapping->data + section->offset;
+    rete_fs_load_end = rete_fs_load_pos + section->length;
+}
+
+bool reteload_sections(agent* thisAgent, rete_fs_mapping* mapping,
+                       rete_fs_section sections[RETE_FS_NUM_SECTIONS])
+{
+    uint64_t count;
+
+    rete_fs_load_overrun = false;
+
+    start_reteload_section(mapping, &sections[RETE_FS_SYMBOL_SECTION - 1]);
+    reteload_all_symbols(thisAgent, NIL);
+    start_reteload_section(mapping, &sections[RETE_FS_ALPHA_MEM_SECTION - 1]);
+    reteload_alpha_memories(thisAgent, NIL);
+    start_reteload_section(mapping, &sections[RETE_FS_NODE_SECTION - 1]);
+    count = reteload_eight_bytes(NIL);
+    while (count-- && !rete_fs_load_overrun)
+    {
+        reteload_node_and_children(thisAgent, thisAgent->dummy_top_node, NIL);
+    }
+
+    rete_fs_load_pos = NIL;
+    rete_fs_load_end = NIL;
+    return !rete_fs_load_overrun;
+}
+
+/* --- With use_rete_net_64, writes the current (sectioned) format;
+   otherwise writes version 3, for older versions of Soar. --- */
 bool save_rete_net(agent* thisAgent, FILE* dest_file, bool use_rete_net_64)
 {
+    std::lock_guard<std::mutex> lock(rete_fs_mutex);
 
     /* --- make sure there are no justifications present --- */
     if (thisAgent->all_productions_of_type[JUSTIFICATION_PRODUCTION_TYPE])
@@ -7840,20 +9614,25 @@ bool save_rete_net(agent* thisAgent, FILE* dest_file, bool use_rete_net_64)
 
     rete_fs_file = dest_file;
     rete_net_64 = use_rete_net_64;
-    uint8_t version = use_rete_net_64 ? 4 : 3;
 
-    retesave_string("SoarCompactReteNet\n", dest_file);
-    retesave_one_byte(version, dest_file);  /* format version number */
+    if (use_rete_net_64)
+    {
+        return retesave_sections(thisAgent, dest_file);
+    }
+
+    retesave_string(RETE_FS_MAGIC_STRING, dest_file);
+    retesave_one_byte(3, dest_file);  /* format version number */
     retesave_symbol_table(thisAgent, dest_file);
     retesave_alpha_memories(thisAgent, dest_file);
     retesave_children_of_node(thisAgent, thisAgent->dummy_top_node, dest_file);
     return true;
 }
 
-bool load_rete_net(agent* thisAgent, FILE* source_file)
+/* --- Empties production and working memory ahead of a load.  Returns
+   false, leaving the agent empty, if anything is left behind. --- */
+bool clear_agent_for_reteload(agent* thisAgent)
 {
-    int format_version_num;
-    uint64_t i, count;
+    int i;
 
     /* RDF: 20020814 RDF Cleaning up the agent working memory and production
        memory to avoid unnecessary errors in this function. */
@@ -7874,13 +9653,45 @@ bool load_rete_net(agent* thisAgent, FILE* source_file)
             thisAgent->outputManager->printa_sf(thisAgent, "Internal error: load_rete_net() called with nonempty PM.\n");
             return false;
         }
+    return true;
+}
+
+/* --- Frees the load tables and, if the load succeeded, recreates the
+   top state and io wmes. --- */
+bool finish_reteload(agent* thisAgent, bool success)
+{
+    /* --- clean up auxilliary tables --- */
+    reteload_free_am_table(thisAgent);
+    reteload_free_symbol_table(thisAgent);
+
+    if (!success)
+    {
+        thisAgent->outputManager->printa_sf(thisAgent, "Rete net file ended unexpectedly.\n");
+        return false;
+    }
+
+    /* RDF: 20020814 Now adding the top state and io symbols and wmes */
+    init_agent_memory(thisAgent);
+
+    return true;
+}
+
+bool load_rete_net(agent* thisAgent, FILE* source_file)
+{
+    std::lock_guard<std::mutex> lock(rete_fs_mutex);
+    int format_version_num;
+    uint64_t count;
+    rete_fs_mapping mapping;
+    rete_fs_section sections[RETE_FS_NUM_SECTIONS];
+    bool success;
 
     // BADBAD: this is global, used in retesave_one_byte
     rete_fs_file = source_file;
+    mapping.data = NIL;
 
-    /* --- read file header, make sure it's a valid file --- */
-    reteload_string(source_file);
-    if (strcmp(reteload_string_buf, "SoarCompactReteNet\n"))
+    /* --- read file header, make sure it's a valid file.  This is done
+       before clearing out the agent, so that a bad file leaves it alone. --- */
+    if (strcmp(reteload_string(source_file), RETE_FS_MAGIC_STRING))
     {
         thisAgent->outputManager->printa_sf(thisAgent, "This file isn't a Soar fastsave file.\n");
         return false;
@@ -7896,26 +9707,156 @@ bool load_rete_net(agent* thisAgent, FILE* source_file)
             // Since there's already a global, I'm putting the 32- or 64-bit switch out there globally
             rete_net_64 = true; // used by reteload_eight_bytes
             break;
+        case RETE_FS_SECTIONED_VERSION:
+            rete_net_64 = true;
+            if (!map_rete_fs_file(source_file, &mapping))
+            {
+                thisAgent->outputManager->printa_sf(thisAgent, "Could not read rete net file.\n");
+                return false;
+            }
+            if (!check_rete_fs_sections(thisAgent, &mapping, sections))
+            {
+                unmap_rete_fs_file(&mapping);
+                return false;
+            }
+            break;
         default:
             thisAgent->outputManager->printa_sf(thisAgent, "This file is in a format (version %d) I don't understand.\n", format_version_num);
             return false;
     }
 
-    reteload_all_symbols(thisAgent, source_file);
-    reteload_alpha_memories(thisAgent, source_file);
-    count = reteload_eight_bytes(source_file);
-    while (count--)
+    if (!clear_agent_for_reteload(thisAgent))
     {
-        reteload_node_and_children(thisAgent, thisAgent->dummy_top_node, source_file);
+        unmap_rete_fs_file(&mapping);
+        return false;
     }
 
-    /* --- clean up auxilliary tables --- */
-    reteload_free_am_table(thisAgent);
-    reteload_free_symbol_table(thisAgent);
+    success = true;
+    if (mapping.data)
+    {
+        success = reteload_sections(thisAgent, &mapping, sections);
+        unmap_rete_fs_file(&mapping);
+    }
+    else
+    {
+        reteload_all_symbols(thisAgent, source_file);
+        reteload_alpha_memories(thisAgent, source_file);
+        count = reteload_eight_bytes(source_file);
+        while (count--)
+        {
+            reteload_node_and_children(thisAgent, thisAgent->dummy_top_node, source_file);
+        }
+    }
 
-    /* RDF: 20020814 Now adding the top state and io symbols and wmes */
-    init_agent_memory(thisAgent);
+    return finish_reteload(thisAgent, success);
+}
+
+/* ----------------------------------------------------------------------
+                          Shared Rete Nets
+
+   A fleet of agents running the same rules would otherwise parse,
+   reorder and compile every production once per agent.  Instead, one
+   agent can compile the rules and publish its net as a named, immutable
+   version 5 image held by the process; every other agent then attaches
+   to the image, which rebuilds its own rete straight from memory.  The
+   nodes themselves can't be shared:  they hold the agent's tokens and
+   point at symbols from the agent's own symbol table.
+
+   Images are reference counted, so replacing or unsharing an image
+   while another thread is attaching to it is safe.  The image's section
+   table is worked out (and its checksums checked) once, when it is
+   shared, and not again on each attach.
+---------------------------------------------------------------------- */
+
+typedef struct shared_rete_net_struct
+{
+    std::vector<uint8_t> image;
+    rete_fs_section sections[RETE_FS_NUM_SECTIONS];
+} shared_rete_net;
+
+std::mutex shared_rete_nets_mutex;
+std::map<std::string, std::shared_ptr<const shared_rete_net> > shared_rete_nets;
+
+bool share_rete_net(agent* thisAgent, const char* name)
+{
+    std::lock_guard<std::mutex> lock(rete_fs_mutex);
+    std::shared_ptr<shared_rete_net> net = std::make_shared<shared_rete_net>();
+    rete_fs_mapping mapping;
+
+    if (thisAgent->all_productions_of_type[JUSTIFICATION_PRODUCTION_TYPE])
+    {
+        thisAgent->outputManager->printa_sf(thisAgent, "Cannot share a rete net with justifications present.\n");
+        return false;
+    }
+
+    rete_net_64 = true;
+    build_rete_fs_image(thisAgent, net->image);
+
+    mapping.data = net->image.data();
+    mapping.size = net->image.size();
+    mapping.is_mapped = false;
+    if (!check_rete_fs_sections(thisAgent, &mapping, net->sections))
+    {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> nets_lock(shared_rete_nets_mutex);
+    shared_rete_nets[name] = net;
+    return true;
+}
+
+bool attach_shared_rete_net(agent* thisAgent, const char* name)
+{
+    std::shared_ptr<const shared_rete_net> net;
+    rete_fs_mapping mapping;
+    rete_fs_section sections[RETE_FS_NUM_SECTIONS];
+    bool success;
+    int i;
+
+    {
+        std::lock_guard<std::mutex> nets_lock(shared_rete_nets_mutex);
+        std::map<std::string, std::shared_ptr<const shared_rete_net> >::iterator it = shared_rete_nets.find(name);
+        if (it != shared_rete_nets.end())
+        {
+            net = it->second;
+        }
+    }
+    if (!net)
+    {
+        thisAgent->outputManager->printa_sf(thisAgent, "There is no shared rete net named %s.\n", name);
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(rete_fs_mutex);
+
+    if (!clear_agent_for_reteload(thisAgent))
+    {
+        return false;
+    }
+
+    /* --- the image is only ever read through the mapping --- */
+    mapping.data = const_cast<uint8_t*>(net->image.data());
+    mapping.size = net->image.size();
+    mapping.is_mapped = false;
+    for (i = 0; i < RETE_FS_NUM_SECTIONS; i++)
+    {
+        sections[i] = net->sections[i];
+    }
+    rete_net_64 = true;
+    success = reteload_sections(thisAgent, &mapping, sections);
+
+    return finish_reteload(thisAgent, success);
+}
+
+bool unshare_rete_net(agent* thisAgent, const char* name)
+{
+    std::lock_guard<std::mutex> nets_lock(shared_rete_nets_mutex);
 
+    if (!shared_rete_nets.erase(name))
+    {
+        thisAgent->outputManager->printa_sf(thisAgent, "There is no shared rete net named %s.\n", name);
+        return false;
+    }
     return true;
 }
 
@@ -8076,6 +10017,92 @@ void get_all_node_count_stats(agent* thisAgent)
     thisAgent->if_no_sharing[UNHASHED_MP_BNODE] = 0;
 }
 
+/* ----------------------------------------------------------------------
+                     Rete Memory Hash Table Statistics
+
+   Fills in the item count, size and bucket-length statistics of the left
+   (token) and right (right_mem) hash tables.  If a rehash is in progress,
+   buckets in both the old and the new bucket arrays are counted.
+---------------------------------------------------------------------- */
+
+void add_bucket_length_to_stats(rete_hash_table_stats* stats, uint64_t length)
+{
+    if (length)
+    {
+        stats->nonempty_buckets++;
+        if (length > stats->max_bucket_length)
+        {
+            stats->max_bucket_length = length;
+        }
+    }
+}
+
+void init_rete_hash_table_stats(rete_hash_table* ht, rete_hash_table_stats* stats)
+{
+    stats->count = ht->count;
+    stats->size = ht->size;
+    stats->nonempty_buckets = 0;
+    stats->max_bucket_length = 0;
+    stats->num_resizes = ht->num_resizes;
+    stats->rehash_in_progress = (ht->old_buckets != NIL);
+}
+
+inline uint64_t left_ht_bucket_length(void* bucket)
+{
+#ifdef RETE_TOKEN_BLOCKS
+    token_block* b = static_cast<token_block*>(bucket);
+    return b ? (b->count - b->num_removed) : 0;
+#else
+    uint64_t length;
+    token* tok;
+
+    for (length = 0, tok = static_cast<token*>(bucket); tok != NIL; tok = tok->a.ht.next_in_bucket)
+    {
+        length++;
+    }
+    return length;
+#endif
+}
+
+void get_rete_hash_table_stats(agent* thisAgent, rete_hash_table_stats* left_stats,
+                               rete_hash_table_stats* right_stats)
+{
+    rete_hash_table* ht;
+    uint32_t i;
+    uint64_t length;
+    right_mem* rm;
+
+    ht = thisAgent->left_ht;
+    init_rete_hash_table_stats(ht, left_stats);
+    for (i = 0; i < ht->size; i++)
+    {
+        add_bucket_length_to_stats(left_stats, left_ht_bucket_length(ht->buckets[i]));
+    }
+    for (i = 0; ht->old_buckets && (i < ht->old_size); i++)
+    {
+        add_bucket_length_to_stats(left_stats, left_ht_bucket_length(ht->old_buckets[i]));
+    }
+
+    ht = thisAgent->right_ht;
+    init_rete_hash_table_stats(ht, right_stats);
+    for (i = 0; i < ht->size; i++)
+    {
+        for (length = 0, rm = static_cast<right_mem*>(ht->buckets[i]); rm != NIL; rm = rm->next_in_bucket)
+        {
+            length++;
+        }
+        add_bucket_length_to_stats(right_stats, length);
+    }
+    for (i = 0; ht->old_buckets && (i < ht->old_size); i++)
+    {
+        for (length = 0, rm = static_cast<right_mem*>(ht->old_buckets[i]); rm != NIL; rm = rm->next_in_bucket)
+        {
+            length++;
+        }
+        add_bucket_length_to_stats(right_stats, length);
+    }
+}
+
 /* Returns 0 if result invalid, 1 if result valid */
 int get_node_count_statistic(agent* thisAgent,
                              char* node_type_name,
@@ -9475,8 +11502,10 @@ void init_rete(agent* thisAgent)
         thisAgent->alpha_hash_tables[i] = make_hash_table(thisAgent, 0, hash_alpha_mem);
     }
 
-    thisAgent->left_ht = thisAgent->memoryManager->allocate_memory_and_zerofill(sizeof(char*) * LEFT_HT_SIZE, HASH_TABLE_MEM_USAGE);
-    thisAgent->right_ht = thisAgent->memoryManager->allocate_memory_and_zerofill(sizeof(char*) * RIGHT_HT_SIZE, HASH_TABLE_MEM_USAGE);
+    thisAgent->left_ht = static_cast<rete_hash_table*>(thisAgent->memoryManager->allocate_memory(sizeof(rete_hash_table), HASH_TABLE_MEM_USAGE));
+    thisAgent->right_ht = static_cast<rete_hash_table*>(thisAgent->memoryManager->allocate_memory(sizeof(rete_hash_table), HASH_TABLE_MEM_USAGE));
+    init_rete_hash_table(thisAgent, thisAgent->left_ht);
+    init_rete_hash_table(thisAgent, thisAgent->right_ht);
 
     init_dummy_top_node(thisAgent);
 
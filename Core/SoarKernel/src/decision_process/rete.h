@@ -29,7 +29,9 @@
    retractions.
 
    Add_wme_to_rete() and remove_wme_from_rete() inform the rete of changes
-   to WM.
+   to WM.  Add_wmes_to_rete() adds a whole list of WMEs at once; with
+   "soar match-threads" above 1, large batches have their alpha memory
+   lookups done in parallel.
 
    P_node_to_conditions_and_nots() takes a p_node and (optionally) a
    token/wme pair, and reconstructs the (optionally instantiated) LHS
@@ -49,6 +51,10 @@
    Save_rete_net() and load_rete_net() are used for the fastsave/load
    commands.  They save/load everything to/from the given (already open)
    files.  They return true if successful, false if any error occurred.
+
+   Share_rete_net() publishes the agent's net as a named image held by
+   the process, attach_shared_rete_net() replaces an agent's productions
+   with those of a shared image, and unshare_rete_net() drops an image.
 ======================================================================= */
 
 #ifndef RETE_H
@@ -142,6 +148,8 @@ typedef struct alpha_mem_struct
     uint32_t am_id;            /* id for hashing */
     uint64_t reference_count;  /* number of beta nodes using this mem */
     uint64_t retesave_amindex;
+    class Rete_Const_Filter* const_filter; /* constant test program, or NIL */
+    struct rete_node_struct* doubly_unlinked_nodes; /* see rete.cpp */
 } alpha_mem;
 
 /* --- the entry for one WME in one alpha memory --- */
@@ -156,6 +164,54 @@ typedef struct right_mem_struct
 
 /* Note: right_mem's are stored in hash table thisAgent->right_ht */
 
+#ifdef RETE_TOKEN_BLOCKS
+/* --- one bucket of the left (token) hash table, stored as parallel arrays.
+   A removed token leaves a NIL node behind until the block is compacted --- */
+typedef struct token_block_struct
+{
+    struct rete_node_struct** nodes;     /* node of each token */
+    Symbol** referents;                  /* hash referent of each token */
+    struct token_struct** tokens;
+    uint32_t count;                      /* slots in use, including removed ones */
+    uint32_t capacity;
+    uint32_t num_removed;
+    struct token_block_struct* next_to_compact;
+} token_block;
+#endif
+
+/* --- hash table used for the left (token) and right (right_mem) memories.
+   Items are linked into the buckets through their own next_in_bucket and
+   prev_in_bucket fields (with RETE_TOKEN_BLOCKS, left_ht buckets point to
+   token_blocks instead).  While old_buckets is non-NIL an incremental
+   rehash is in progress; see "Memory Hash Tables" in rete.cpp --- */
+typedef struct rete_hash_table_struct
+{
+    void**   buckets;            /* current bucket array */
+    uint32_t size;               /* number of buckets */
+    uint32_t mask;               /* size - 1 */
+    short    log2size;           /* log (base 2) of size */
+    void**   old_buckets;        /* bucket array being migrated, or NIL */
+    uint32_t old_size;
+    uint32_t old_mask;
+    uint32_t rehash_position;    /* old buckets below this have been migrated */
+    uint64_t count;              /* number of items in the table */
+    uint64_t num_resizes;        /* number of resizes started so far */
+#ifdef RETE_TOKEN_BLOCKS
+    token_block* blocks_to_compact;  /* blocks with removed slots */
+#endif
+} rete_hash_table;
+
+/* --- bucket-length statistics for a rete_hash_table, for "stats --rete" --- */
+typedef struct rete_hash_table_stats_struct
+{
+    uint64_t count;
+    uint64_t size;
+    uint64_t nonempty_buckets;
+    uint64_t max_bucket_length;
+    uint64_t num_resizes;
+    bool     rehash_in_progress;
+} rete_hash_table_stats;
+
 typedef struct var_location_struct
 {
     rete_node_level levels_up; /* 0=current node's alphamem, 1=parent's, etc. */
@@ -192,6 +248,7 @@ typedef struct posneg_node_data_struct
     struct rete_node_struct* next_from_alpha_mem; /* dll of nodes using that */
     struct rete_node_struct* prev_from_alpha_mem; /*   ... alpha memory */
     struct rete_node_struct* nearest_ancestor_with_same_am;
+    uint32_t const_filter_slot; /* slot in alpha_mem_->const_filter */
 } posneg_node_data;
 
 /* --- data for beta memory nodes only --- */
@@ -199,6 +256,8 @@ typedef struct beta_memory_node_data_struct
 {
     /* --- first pos node child that is left-linked --- */
     struct rete_node_struct* first_linked_child;
+    /* --- number of pos node children unlinked from both sides --- */
+    uint32_t num_doubly_unlinked_children;
 } beta_memory_node_data;
 
 /* --- data for cn and cn_partner nodes only --- */
@@ -328,7 +387,11 @@ typedef struct token_struct
     {
         struct token_in_hash_table_data_struct
         {
+#ifdef RETE_TOKEN_BLOCKS
+            uint32_t slot;    /* index in its bucket's token_block */
+#else
             struct token_struct* next_in_bucket, *prev_in_bucket; /*hash bucket dll*/
+#endif
             Symbol* referent; /* referent of the hash test (thing we hashed on) */
         } ht;
         struct token_from_right_memory_of_negative_or_cn_node_struct
@@ -387,8 +450,19 @@ extern byte add_production_to_rete(agent* thisAgent, production* p, condition* l
 extern void excise_production_from_rete(agent* thisAgent, production* p);
 
 extern void add_wme_to_rete(agent* thisAgent, wme* w);
+extern void add_wmes_to_rete(agent* thisAgent, cons* wmes);
+extern void set_rete_match_threads(agent* thisAgent, uint64_t num_threads);
+extern void set_rete_profiling(agent* thisAgent, bool enabled);
 extern void remove_wme_from_rete(agent* thisAgent, wme* w);
 
+/* --- bulk production loading ("source --bulk"):  while a bulk load is in
+   progress, nodes built for new productions are not matched against
+   working memory until rete_flush_deferred_matches() or
+   rete_end_bulk_load() is called --- */
+extern void rete_begin_bulk_load(agent* thisAgent);
+extern void rete_end_bulk_load(agent* thisAgent);
+extern void rete_flush_deferred_matches(agent* thisAgent);
+
 void retesave_eight_bytes(uint64_t w, FILE* f);
 void retesave_string(const char* s, FILE* f);
 
@@ -412,12 +486,18 @@ extern void xml_partial_match_information(agent* thisAgent, rete_node* p_node, w
 extern void print_match_set(agent* thisAgent, wme_trace_type wtt, ms_trace_type  mst);
 extern void xml_match_set(agent* thisAgent, wme_trace_type wtt, ms_trace_type  mst);
 extern void get_all_node_count_stats(agent* thisAgent);
+extern void get_rete_hash_table_stats(agent* thisAgent, rete_hash_table_stats* left_stats,
+                                      rete_hash_table_stats* right_stats);
+extern void free_rete_hash_table(agent* thisAgent, rete_hash_table* ht);
 extern int get_node_count_statistic(agent* thisAgent, char* node_type_name,
                                     char* column_name,
                                     uint64_t* result);
 
 extern bool save_rete_net(agent* thisAgent, FILE* dest_file, bool use_rete_net_64);
 extern bool load_rete_net(agent* thisAgent, FILE* source_file);
+extern bool share_rete_net(agent* thisAgent, const char* name);
+extern bool attach_shared_rete_net(agent* thisAgent, const char* name);
+extern bool unshare_rete_net(agent* thisAgent, const char* name);
 
 extern void add_varnames_to_test(agent* thisAgent, varnames* vn, test* t);
 
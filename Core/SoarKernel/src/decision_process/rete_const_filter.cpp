@@ -0,0 +1,304 @@
+/*************************************************************************
+ * PLEASE SEE THE FILE "license.txt" (INCLUDED WITH THIS SOFTWARE PACKAGE)
+ * FOR LICENSE AND COPYRIGHT INFORMATION.
+ *************************************************************************/
+
+/*************************************************************************
+ *
+ *  file:  rete_const_filter.cpp
+ *
+ * =======================================================================
+ *  Constant test filter programs for alpha memories.  See
+ *  rete_const_filter.h.  The programs are built and run by
+ *  add_wme_to_matching_alpha_mem() in rete.cpp.
+ * =======================================================================
+ */
+
+#include "rete_const_filter.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define RETE_CONST_FILTER_X86
+#include <immintrin.h>
+#endif
+
+/* ----------------------------------------------------------------------
+                          Filter Kernels
+
+   Each kernel runs one array of tests against one wme field value and
+   clears the verdict of every slot with a failing test.  Integer tests
+   are all expressed as a signed "greater than":  the wme value v passes
+   "< c" iff c > v, "> c" iff v > c, "<= c" iff not v > c, and ">= c" iff
+   not c > v.
+---------------------------------------------------------------------- */
+
+typedef void (*const_filter_equality_kernel)(const uint64_t* constants, const uint32_t* slots, size_t count,
+        uint64_t value, bool negate, uint8_t* verdicts);
+typedef void (*const_filter_int_kernel)(const int64_t* constants, const uint32_t* slots, size_t count,
+                                        int64_t value, bool constant_on_left, bool negate, uint8_t* verdicts);
+
+inline void const_filter_equality_tail(const uint64_t* constants, const uint32_t* slots, size_t begin, size_t count,
+                                       uint64_t value, bool negate, uint8_t* verdicts)
+{
+    for (size_t i = begin; i < count; i++)
+    {
+        if ((constants[i] == value) == negate)
+        {
+            verdicts[slots[i]] = 0;
+        }
+    }
+}
+
+inline void const_filter_int_tail(const int64_t* constants, const uint32_t* slots, size_t begin, size_t count,
+                                  int64_t value, bool constant_on_left, bool negate, uint8_t* verdicts)
+{
+    for (size_t i = begin; i < count; i++)
+    {
+        if ((constant_on_left ? (constants[i] > value) : (value > constants[i])) == negate)
+        {
+            verdicts[slots[i]] = 0;
+        }
+    }
+}
+
+/* --- clears the verdicts of the slots whose bits are set in failed --- */
+inline void const_filter_clear_failed(const uint32_t* slots, unsigned int failed, uint8_t* verdicts)
+{
+    for (int bit = 0; failed; bit++, failed >>= 1)
+    {
+        if (failed & 1)
+        {
+            verdicts[slots[bit]] = 0;
+        }
+    }
+}
+
+void const_filter_equality_scalar(const uint64_t* constants, const uint32_t* slots, size_t count,
+                                  uint64_t value, bool negate, uint8_t* verdicts)
+{
+    const_filter_equality_tail(constants, slots, 0, count, value, negate, verdicts);
+}
+
+void const_filter_int_scalar(const int64_t* constants, const uint32_t* slots, size_t count,
+                             int64_t value, bool constant_on_left, bool negate, uint8_t* verdicts)
+{
+    const_filter_int_tail(constants, slots, 0, count, value, constant_on_left, negate, verdicts);
+}
+
+#ifdef RETE_CONST_FILTER_X86
+
+__attribute__((target("sse4.2")))
+void const_filter_equality_sse42(const uint64_t* constants, const uint32_t* slots, size_t count,
+                                 uint64_t value, bool negate, uint8_t* verdicts)
+{
+    __m128i v = _mm_set1_epi64x(static_cast<long long>(value));
+    unsigned int pass_bits = negate ? 0x0 : 0x3;
+    size_t i;
+
+    for (i = 0; i + 2 <= count; i += 2)
+    {
+        __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(constants + i));
+        unsigned int equal = static_cast<unsigned int>(_mm_movemask_pd(_mm_castsi128_pd(_mm_cmpeq_epi64(c, v))));
+        const_filter_clear_failed(slots + i, (equal ^ pass_bits) & 0x3, verdicts);
+    }
+    const_filter_equality_tail(constants, slots, i, count, value, negate, verdicts);
+}
+
+__attribute__((target("sse4.2")))
+void const_filter_int_sse42(const int64_t* constants, const uint32_t* slots, size_t count,
+                            int64_t value, bool constant_on_left, bool negate, uint8_t* verdicts)
+{
+    __m128i v = _mm_set1_epi64x(static_cast<long long>(value));
+    unsigned int pass_bits = negate ? 0x0 : 0x3;
+    size_t i;
+
+    for (i = 0; i + 2 <= count; i += 2)
+    {
+        __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(constants + i));
+        __m128i gt = constant_on_left ? _mm_cmpgt_epi64(c, v) : _mm_cmpgt_epi64(v, c);
+        unsigned int bits = static_cast<unsigned int>(_mm_movemask_pd(_mm_castsi128_pd(gt)));
+        const_filter_clear_failed(slots + i, (bits ^ pass_bits) & 0x3, verdicts);
+    }
+    const_filter_int_tail(constants, slots, i, count, value, constant_on_left, negate, verdicts);
+}
+
+__attribute__((target("avx2")))
+void const_filter_equality_avx2(const uint64_t* constants, const uint32_t* slots, size_t count,
+                                uint64_t value, bool negate, uint8_t* verdicts)
+{
+    __m256i v = _mm256_set1_epi64x(static_cast<long long>(value));
+    unsigned int pass_bits = negate ? 0x0 : 0xF;
+    size_t i;
+
+    for (i = 0; i + 4 <= count; i += 4)
+    {
+        __m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(constants + i));
+        unsigned int equal = static_cast<unsigned int>(_mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(c, v))));
+        const_filter_clear_failed(slots + i, (equal ^ pass_bits) & 0xF, verdicts);
+    }
+    const_filter_equality_tail(constants, slots, i, count, value, negate, verdicts);
+}
+
+__attribute__((target("avx2")))
+void const_filter_int_avx2(const int64_t* constants, const uint32_t* slots, size_t count,
+                           int64_t value, bool constant_on_left, bool negate, uint8_t* verdicts)
+{
+    __m256i v = _mm256_set1_epi64x(static_cast<long long>(value));
+    unsigned int pass_bits = negate ? 0x0 : 0xF;
+    size_t i;
+
+    for (i = 0; i + 4 <= count; i += 4)
+    {
+        __m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(constants + i));
+        __m256i gt = constant_on_left ? _mm256_cmpgt_epi64(c, v) : _mm256_cmpgt_epi64(v, c);
+        unsigned int bits = static_cast<unsigned int>(_mm256_movemask_pd(_mm256_castsi256_pd(gt)));
+        const_filter_clear_failed(slots + i, (bits ^ pass_bits) & 0xF, verdicts);
+    }
+    const_filter_int_tail(constants, slots, i, count, value, constant_on_left, negate, verdicts);
+}
+
+#endif /* RETE_CONST_FILTER_X86 */
+
+/* --- picks the widest kernels this processor supports, once --- */
+struct const_filter_kernels
+{
+    const_filter_equality_kernel    equality;
+    const_filter_int_kernel         compare;
+
+    const_filter_kernels()
+    {
+        equality = const_filter_equality_scalar;
+        compare = const_filter_int_scalar;
+#ifdef RETE_CONST_FILTER_X86
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2"))
+        {
+            equality = const_filter_equality_avx2;
+            compare = const_filter_int_avx2;
+        }
+        else if (__builtin_cpu_supports("sse4.2"))
+        {
+            equality = const_filter_equality_sse42;
+            compare = const_filter_int_sse42;
+        }
+#endif
+    }
+};
+
+inline const const_filter_kernels& get_const_filter_kernels()
+{
+    static const const_filter_kernels kernels;
+    return kernels;
+}
+
+/* ----------------------------------------------------------------------
+                          Rete_Const_Filter
+---------------------------------------------------------------------- */
+
+Rete_Const_Filter::Rete_Const_Filter()
+{
+    dirty = true;
+}
+
+void Rete_Const_Filter::clear()
+{
+    int field, type;
+
+    owners.clear();
+    verdicts.clear();
+    for (field = 0; field < 3; field++)
+    {
+        equal[field].constants.clear();
+        equal[field].slots.clear();
+        not_equal[field].constants.clear();
+        not_equal[field].slots.clear();
+        for (type = 0; type < NUM_INT_TEST_TYPES; type++)
+        {
+            int_tests[field][type].constants.clear();
+            int_tests[field][type].slots.clear();
+            int_tests[field][type].refs.clear();
+        }
+    }
+    general.clear();
+    dirty = false;
+}
+
+uint32_t Rete_Const_Filter::add_slot(rete_node* pOwner)
+{
+    owners.push_back(pOwner);
+    return static_cast<uint32_t>(owners.size() - 1);
+}
+
+void Rete_Const_Filter::add_equality_test(byte pField, Symbol* pConstant, bool pNegate, uint32_t pSlot)
+{
+    equality_tests& tests = pNegate ? not_equal[pField] : equal[pField];
+
+    tests.constants.push_back(static_cast<uint64_t>(reinterpret_cast<uintptr_t>(pConstant)));
+    tests.slots.push_back(pSlot);
+}
+
+void Rete_Const_Filter::add_int_test(byte pField, int_test_type pType, int64_t pConstant, rete_test* pTest, uint32_t pSlot)
+{
+    int_tests_of_type& tests = int_tests[pField][pType];
+    test_ref ref;
+
+    ref.test = pTest;
+    ref.slot = pSlot;
+    tests.constants.push_back(pConstant);
+    tests.slots.push_back(pSlot);
+    tests.refs.push_back(ref);
+}
+
+void Rete_Const_Filter::add_general_test(rete_test* pTest, uint32_t pSlot)
+{
+    test_ref ref;
+
+    ref.test = pTest;
+    ref.slot = pSlot;
+    general.push_back(ref);
+}
+
+bool Rete_Const_Filter::has_int_tests(byte pField)
+{
+    for (int type = 0; type < NUM_INT_TEST_TYPES; type++)
+    {
+        if (!int_tests[pField][type].slots.empty())
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+void Rete_Const_Filter::run_equality_tests(byte pField, Symbol* pValue)
+{
+    const const_filter_kernels& kernels = get_const_filter_kernels();
+    uint64_t value = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(pValue));
+
+    if (!equal[pField].slots.empty())
+    {
+        kernels.equality(&equal[pField].constants[0], &equal[pField].slots[0], equal[pField].slots.size(),
+                         value, false, &verdicts[0]);
+    }
+    if (!not_equal[pField].slots.empty())
+    {
+        kernels.equality(&not_equal[pField].constants[0], &not_equal[pField].slots[0], not_equal[pField].slots.size(),
+                         value, true, &verdicts[0]);
+    }
+}
+
+void Rete_Const_Filter::run_int_tests(byte pField, int64_t pValue)
+{
+    const const_filter_kernels& kernels = get_const_filter_kernels();
+    static const bool constant_on_left[NUM_INT_TEST_TYPES] = { true, false, false, true };
+    static const bool negate[NUM_INT_TEST_TYPES] = { false, false, true, true };
+
+    for (int type = 0; type < NUM_INT_TEST_TYPES; type++)
+    {
+        int_tests_of_type& tests = int_tests[pField][type];
+        if (!tests.slots.empty())
+        {
+            kernels.compare(&tests.constants[0], &tests.slots[0], tests.slots.size(),
+                            pValue, constant_on_left[type], negate[type], &verdicts[0]);
+        }
+    }
+}
@@ -0,0 +1,111 @@
+/*************************************************************************
+ * PLEASE SEE THE FILE "license.txt" (INCLUDED WITH THIS SOFTWARE PACKAGE)
+ * FOR LICENSE AND COPYRIGHT INFORMATION.
+ *************************************************************************/
+
+/* =======================================================================
+                             rete_const_filter.h
+
+   A constant test filter program for one alpha memory.  Many join nodes
+   hanging off the same alpha memory often differ only in their constant
+   tests (e.g. "^value > 3", "^value > 4", ... or "^color <> red").  The
+   rete builds a filter program for such an alpha memory that holds the
+   constant tests of all of its join nodes, laid out as flat arrays per
+   wme field and per kind of test.  When a wme is added to the alpha
+   memory, the program evaluates the wme against every node's constant
+   tests in one pass, and the right activations of nodes whose constant
+   tests fail are skipped.
+
+   Equality and integer comparisons are run over the arrays with SSE4.2
+   or AVX2 when the processor supports them (checked at run time), and
+   with plain loops otherwise.  Any other constant test (disjunctions,
+   float constants, goal/impasse tests, ...) is handed back to the rete
+   as a "general" test and run through the usual rete test routines.
+
+   Each node's constant tests are assigned a slot; after a wme has been
+   run through the program, verdict(slot) is nonzero iff all the constant
+   tests in that slot passed.
+======================================================================= */
+
+#ifndef RETE_CONST_FILTER_H
+#define RETE_CONST_FILTER_H
+
+#include "kernel.h"
+
+#include <vector>
+
+/* --- slot numbers for nodes that are not in a filter program --- */
+#define NO_CONST_FILTER_SLOT        0xFFFFFFFF   /* node has no constant tests */
+#define UNASSIGNED_CONST_FILTER_SLOT 0xFFFFFFFE  /* program hasn't seen node yet */
+
+class Rete_Const_Filter
+{
+    public:
+
+        enum int_test_type
+        {
+            INT_LESS_TEST,
+            INT_GREATER_TEST,
+            INT_LESS_OR_EQUAL_TEST,
+            INT_GREATER_OR_EQUAL_TEST,
+            NUM_INT_TEST_TYPES
+        };
+
+        Rete_Const_Filter();
+
+        void        clear();
+        bool        is_dirty()                          { return dirty; }
+        void        mark_dirty()                        { dirty = true; }
+
+        uint32_t    add_slot(rete_node* pOwner);
+        void        forget_slot(uint32_t pSlot)         { owners[pSlot] = NIL; dirty = true; }
+        size_t      num_slots()                         { return owners.size(); }
+        rete_node*  slot_owner(uint32_t pSlot)          { return owners[pSlot]; }
+
+        void        add_equality_test(byte pField, Symbol* pConstant, bool pNegate, uint32_t pSlot);
+        void        add_int_test(byte pField, int_test_type pType, int64_t pConstant, rete_test* pTest, uint32_t pSlot);
+        void        add_general_test(rete_test* pTest, uint32_t pSlot);
+
+        /* --- evaluation:  start_evaluation(), then run each field's tests
+           (the caller runs the general tests, and the integer tests when
+           the field isn't an integer), then read the verdicts --- */
+        void        start_evaluation()                  { verdicts.assign(owners.size(), 1); }
+        void        run_equality_tests(byte pField, Symbol* pValue);
+        void        run_int_tests(byte pField, int64_t pValue);
+        bool        verdict(uint32_t pSlot)             { return (pSlot >= verdicts.size()) || verdicts[pSlot]; }
+        void        fail(uint32_t pSlot)                { verdicts[pSlot] = 0; }
+
+        /* --- tests that need the rete test routines (general tests, plus
+           integer tests on a field whose value isn't an integer) --- */
+        struct test_ref
+        {
+            rete_test*  test;
+            uint32_t    slot;
+        };
+        std::vector<test_ref>&  general_tests()                         { return general; }
+        std::vector<test_ref>&  int_test_refs(byte pField, int pType)   { return int_tests[pField][pType].refs; }
+        bool                    has_int_tests(byte pField);
+
+    private:
+
+        struct equality_tests
+        {
+            std::vector<uint64_t>   constants;   /* Symbol pointers */
+            std::vector<uint32_t>   slots;
+        };
+        struct int_tests_of_type
+        {
+            std::vector<int64_t>    constants;
+            std::vector<uint32_t>   slots;
+            std::vector<test_ref>   refs;
+        };
+
+        std::vector<rete_node*>     owners;
+        std::vector<uint8_t>        verdicts;
+        equality_tests              equal[3], not_equal[3];
+        int_tests_of_type           int_tests[3][NUM_INT_TEST_TYPES];
+        std::vector<test_ref>       general;
+        bool                        dirty;
+};
+
+#endif /* RETE_CONST_FILTER_H */
@@ -0,0 +1,168 @@
+/*************************************************************************
+ * PLEASE SEE THE FILE "license.txt" (INCLUDED WITH THIS SOFTWARE PACKAGE)
+ * FOR LICENSE AND COPYRIGHT INFORMATION.
+ *************************************************************************/
+
+/*************************************************************************
+ *
+ *  file:  rete_profiler.cpp
+ *
+ * =======================================================================
+ *  Per-node activation counts and timings for the beta network, rolled
+ *  up to productions.  See rete_profiler.h.
+ * =======================================================================
+ */
+
+#include "rete_profiler.h"
+
+#include "agent.h"
+#include "production.h"
+#include "rete.h"
+
+#include <string.h>
+
+Rete_Profiler::Rete_Profiler()
+{
+    child_time = 0;
+    raw_per_usec = get_raw_time_per_usec();
+}
+
+void Rete_Profiler::reset()
+{
+    nodes.clear();
+    child_time = 0;
+}
+
+/* ----------------------------------------------------------------------
+   Activations nest:  a right activation of a join node left-activates
+   its children, and so on.  Child_time holds the time spent so far in
+   activations nested inside the current one; each frame saves the
+   enclosing activation's child_time and restores it (plus its own total
+   time) when it ends, so every node is charged only for its own work.
+---------------------------------------------------------------------- */
+
+void Rete_Profiler::start_activation(rete_node* pNode, bool pRight, bool pNull, activation_frame& pFrame)
+{
+    node_profile& profile = nodes[pNode];
+
+    if (pRight)
+    {
+        profile.right_activations++;
+        if (pNull)
+        {
+            profile.null_right_activations++;
+        }
+    }
+    else
+    {
+        profile.left_activations++;
+        if (pNull)
+        {
+            profile.null_left_activations++;
+        }
+    }
+
+    pFrame.profile = &profile;
+    pFrame.outer_child_time = child_time;
+    child_time = 0;
+    pFrame.start = get_raw_time();
+}
+
+void Rete_Profiler::end_activation(activation_frame& pFrame)
+{
+    uint64_t elapsed = get_raw_time() - pFrame.start;
+
+    /* --- pFrame.profile is still valid:  nested activations may add nodes
+       to the map, but rehashing an unordered_map keeps references to its
+       elements, and nodes are never deallocated during an addition --- */
+    pFrame.profile->raw_time += (elapsed > child_time) ? (elapsed - child_time) : 0;
+    child_time = pFrame.outer_child_time + elapsed;
+}
+
+uint64_t Rete_Profiler::get_total_usec()
+{
+    uint64_t total = 0;
+
+    for (std::unordered_map<rete_node*, node_profile>::iterator it = nodes.begin(); it != nodes.end(); ++it)
+    {
+        total += it->second.raw_time;
+    }
+    return static_cast<uint64_t>(total / raw_per_usec);
+}
+
+/* --- calls pVisit on every node production pNode's p-node uses, the way
+   adjust_sharing_factors_from_here_to_top() walks them --- */
+template <typename visitor>
+inline void for_each_node_of_production(rete_node* pNode, visitor pVisit)
+{
+    while (pNode != NIL)
+    {
+        pVisit(pNode);
+        if (pNode->node_type == CN_BNODE)
+        {
+            pNode = pNode->b.cn.partner;
+        }
+        else
+        {
+            pNode = pNode->parent;
+        }
+    }
+}
+
+void Rete_Profiler::get_production_profiles(agent* thisAgent, std::vector<production_profile>& pProfiles)
+{
+    std::unordered_map<rete_node*, uint64_t> sharers;
+    production* prod;
+    int type;
+
+    pProfiles.clear();
+
+    for (type = 0; type < NUM_PRODUCTION_TYPES; type++)
+        for (prod = thisAgent->all_productions_of_type[type]; prod != NIL; prod = prod->next)
+            if (prod->p_node)
+            {
+                for_each_node_of_production(prod->p_node, [&sharers](rete_node* node)
+                {
+                    sharers[node]++;
+                });
+            }
+
+    for (type = 0; type < NUM_PRODUCTION_TYPES; type++)
+        for (prod = thisAgent->all_productions_of_type[type]; prod != NIL; prod = prod->next)
+        {
+            if (! prod->p_node)
+            {
+                continue;
+            }
+
+            production_profile profile;
+            double raw_time = 0;
+
+            memset(&profile, 0, sizeof(profile));
+            profile.prod = prod;
+            for_each_node_of_production(prod->p_node, [&](rete_node* node)
+            {
+                uint64_t num_sharers = sharers[node];
+
+                profile.num_nodes++;
+                if (num_sharers > 1)
+                {
+                    profile.num_shared_nodes++;
+                }
+
+                std::unordered_map<rete_node*, node_profile>::iterator it = nodes.find(node);
+                if (it == nodes.end())
+                {
+                    return;
+                }
+                profile.left_activations += it->second.left_activations;
+                profile.null_left_activations += it->second.null_left_activations;
+                profile.right_activations += it->second.right_activations;
+                profile.null_right_activations += it->second.null_right_activations;
+                profile.tokens_created += it->second.tokens_created;
+                raw_time += static_cast<double>(it->second.raw_time) / num_sharers;
+            });
+            profile.usec = raw_time / raw_per_usec;
+            pProfiles.push_back(profile);
+        }
+}
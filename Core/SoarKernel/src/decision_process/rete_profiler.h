@@ -0,0 +1,89 @@
+/*************************************************************************
+ * PLEASE SEE THE FILE "license.txt" (INCLUDED WITH THIS SOFTWARE PACKAGE)
+ * FOR LICENSE AND COPYRIGHT INFORMATION.
+ *************************************************************************/
+
+/* =======================================================================
+                             rete_profiler.h
+
+   Run-time profiler for the beta network.  An agent owns a profiler only
+   while profiling is on ("production matches --profile on"), so the cost
+   when it is off is one pointer test per node activation.
+
+   For each beta node the profiler counts left and right activations,
+   null activations (a left activation of a join node whose alpha memory
+   is empty, or a right activation of one whose left memory is empty),
+   tokens created at the node, and the time spent in the node itself,
+   excluding the time spent in the activations it passes on to other
+   nodes.
+
+   Get_production_profiles() rolls the node figures up to the
+   productions using each node.  A node shared by several productions
+   has its time split evenly among them, so the times of all productions
+   add up to the total time spent in the beta network; activation and
+   token counts are not split.
+======================================================================= */
+
+#ifndef RETE_PROFILER_H
+#define RETE_PROFILER_H
+
+#include "kernel.h"
+
+#include <unordered_map>
+#include <vector>
+
+class Rete_Profiler
+{
+    public:
+
+        typedef struct node_profile_struct
+        {
+            uint64_t    left_activations;
+            uint64_t    null_left_activations;
+            uint64_t    right_activations;
+            uint64_t    null_right_activations;
+            uint64_t    tokens_created;
+            uint64_t    raw_time;           /* in get_raw_time() units */
+        } node_profile;
+
+        typedef struct production_profile_struct
+        {
+            production* prod;
+            uint64_t    num_nodes;
+            uint64_t    num_shared_nodes;
+            uint64_t    left_activations;
+            uint64_t    null_left_activations;
+            uint64_t    right_activations;
+            uint64_t    null_right_activations;
+            uint64_t    tokens_created;
+            double      usec;               /* share of the nodes' time */
+        } production_profile;
+
+        /* --- one activation in progress; see start_activation() --- */
+        typedef struct activation_frame_struct
+        {
+            node_profile*   profile;
+            uint64_t        start;
+            uint64_t        outer_child_time;
+        } activation_frame;
+
+        Rete_Profiler();
+
+        void        reset();
+
+        void        start_activation(rete_node* pNode, bool pRight, bool pNull, activation_frame& pFrame);
+        void        end_activation(activation_frame& pFrame);
+        void        token_created(rete_node* pNode)     { nodes[pNode].tokens_created++; }
+        void        forget_node(rete_node* pNode)       { nodes.erase(pNode); }
+
+        uint64_t    get_total_usec();
+        void        get_production_profiles(agent* thisAgent, std::vector<production_profile>& pProfiles);
+
+    private:
+
+        std::unordered_map<rete_node*, node_profile>   nodes;
+        uint64_t                                        child_time;
+        double                                          raw_per_usec;
+};
+
+#endif /* RETE_PROFILER_H */
@@ -0,0 +1,143 @@
+/*************************************************************************
+ * PLEASE SEE THE FILE "license.txt" (INCLUDED WITH THIS SOFTWARE PACKAGE)
+ * FOR LICENSE AND COPYRIGHT INFORMATION.
+ *************************************************************************/
+
+/*************************************************************************
+ *
+ *  file:  rete_worker_pool.cpp
+ *
+ * =======================================================================
+ *  Fork-join worker pool for parallel (read-only) match work.  See
+ *  rete_worker_pool.h.
+ * =======================================================================
+ */
+
+#include "rete_worker_pool.h"
+
+Rete_Worker_Pool::Rete_Worker_Pool(uint64_t pNumThreads)
+{
+    current_task = NULL;
+    current_count = 0;
+    workers_remaining = 0;
+    generation = 0;
+    num_threads = (pNumThreads > 0) ? pNumThreads : 1;
+    shutting_down = false;
+
+    start_workers();
+}
+
+Rete_Worker_Pool::~Rete_Worker_Pool()
+{
+    stop_workers();
+}
+
+void Rete_Worker_Pool::set_num_threads(uint64_t pNumThreads)
+{
+    if (pNumThreads == 0)
+    {
+        pNumThreads = 1;
+    }
+    if (pNumThreads == num_threads)
+    {
+        return;
+    }
+    stop_workers();
+    num_threads = pNumThreads;
+    start_workers();
+}
+
+/* --- The calling thread always processes chunk 0, so only
+   num_threads - 1 workers are needed. --- */
+void Rete_Worker_Pool::start_workers()
+{
+    shutting_down = false;
+    for (size_t i = 1; i < num_threads; i++)
+    {
+        workers.push_back(std::thread(&Rete_Worker_Pool::worker_loop, this, i, generation));
+    }
+}
+
+void Rete_Worker_Pool::stop_workers()
+{
+    {
+        std::lock_guard<std::mutex> lock(pool_mutex);
+        shutting_down = true;
+    }
+    work_ready.notify_all();
+    for (size_t i = 0; i < workers.size(); i++)
+    {
+        workers[i].join();
+    }
+    workers.clear();
+}
+
+inline void run_chunk(const Rete_Worker_Pool::partition_task& pTask, size_t pCount, size_t pChunkIndex, size_t pNumChunks)
+{
+    size_t begin = (pCount * pChunkIndex) / pNumChunks;
+    size_t end = (pCount * (pChunkIndex + 1)) / pNumChunks;
+
+    if (begin < end)
+    {
+        pTask(begin, end);
+    }
+}
+
+void Rete_Worker_Pool::worker_loop(size_t pChunkIndex, uint64_t pGeneration)
+{
+    uint64_t last_generation = pGeneration;
+    const partition_task* task;
+    size_t count;
+
+    for (;;)
+    {
+        {
+            std::unique_lock<std::mutex> lock(pool_mutex);
+            work_ready.wait(lock, [&] { return shutting_down || (generation != last_generation); });
+            if (shutting_down)
+            {
+                return;
+            }
+            last_generation = generation;
+            task = current_task;
+            count = current_count;
+        }
+
+        run_chunk(*task, count, pChunkIndex, static_cast<size_t>(num_threads));
+
+        {
+            std::lock_guard<std::mutex> lock(pool_mutex);
+            if (--workers_remaining == 0)
+            {
+                work_done.notify_one();
+            }
+        }
+    }
+}
+
+void Rete_Worker_Pool::run_partitioned(size_t pCount, const partition_task& pTask)
+{
+    if (workers.empty() || (pCount < num_threads))
+    {
+        if (pCount)
+        {
+            pTask(0, pCount);
+        }
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(pool_mutex);
+        current_task = &pTask;
+        current_count = pCount;
+        workers_remaining = workers.size();
+        generation++;
+    }
+    work_ready.notify_all();
+
+    run_chunk(pTask, pCount, 0, static_cast<size_t>(num_threads));
+
+    std::unique_lock<std::mutex> lock(pool_mutex);
+    work_done.wait(lock, [&] { return workers_remaining == 0; });
+    current_task = NULL;
+}
@@ -0,0 +1,65 @@
+/*************************************************************************
+ * PLEASE SEE THE FILE "license.txt" (INCLUDED WITH THIS SOFTWARE PACKAGE)
+ * FOR LICENSE AND COPYRIGHT INFORMATION.
+ *************************************************************************/
+
+/* =======================================================================
+                             rete_worker_pool.h
+
+   A small fork-join thread pool used by the rete to spread read-only
+   match work across cores.  Each agent owns at most one pool, which is
+   created when "soar match-threads" is set above 1.
+
+   Run_partitioned() splits the range [0, count) into one contiguous
+   chunk per thread (the calling thread takes the first one) and returns
+   only after every chunk has been processed.  Tasks must not touch any
+   kernel state that is not safe to read concurrently:  memory pools,
+   symbol reference counts and the rete's own linked lists are all
+   unsynchronized.
+======================================================================= */
+
+#ifndef RETE_WORKER_POOL_H
+#define RETE_WORKER_POOL_H
+
+#include "kernel.h"
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class Rete_Worker_Pool
+{
+    public:
+
+        typedef std::function<void(size_t, size_t)> partition_task;
+
+        Rete_Worker_Pool(uint64_t pNumThreads);
+        ~Rete_Worker_Pool();
+
+        void        set_num_threads(uint64_t pNumThreads);
+        uint64_t    get_num_threads() { return num_threads; }
+
+        void        run_partitioned(size_t pCount, const partition_task& pTask);
+
+    private:
+
+        void        start_workers();
+        void        stop_workers();
+        void        worker_loop(size_t pChunkIndex, uint64_t pGeneration);
+
+        std::vector<std::thread>    workers;
+        std::mutex                  pool_mutex;
+        std::condition_variable     work_ready;
+        std::condition_variable     work_done;
+
+        const partition_task*       current_task;
+        size_t                      current_count;
+        size_t                      workers_remaining;
+        uint64_t                    generation;
+        uint64_t                    num_threads;
+        bool                        shutting_down;
+};
+
+#endif /* RETE_WORKER_POOL_H */
@@ -998,6 +998,12 @@ void do_one_top_level_phase(agent* thisAgent)
             thisAgent->current_phase = INPUT_PHASE;
             thisAgent->d_cycle_count++;
             thisAgent->WM->wma_d_cycle_count++;
+
+            if (thisAgent->Decider->settings[DECIDER_POOL_TRIM_INTERVAL] &&
+                    !(thisAgent->d_cycle_count % thisAgent->Decider->settings[DECIDER_POOL_TRIM_INTERVAL]))
+            {
+                thisAgent->memoryManager->trim_memory_pools();
+            }
             break;
 
         /////////////////////////////////////////////////////////////////////////////////
@@ -1091,6 +1097,21 @@ void do_one_top_level_phase(agent* thisAgent)
     thisAgent->cumulative_wm_size += thisAgent->num_wmes_in_rete;
     thisAgent->num_wm_sizes_accumulated++;
 
+    /* --- halt rather than let the pools grow until the process runs out
+       of memory; init-soar frees enough to run again, unless the agent's
+       long-term knowledge alone is over the limit --- */
+    if (!thisAgent->system_halted && thisAgent->memoryManager->memory_limit_exceeded())
+    {
+        thisAgent->outputManager->printa_sf(thisAgent, "\nMemory usage of %u bytes exceeded max-memory-usage (%u bytes).  Soar halted.\n",
+                                            static_cast<uint64_t>(thisAgent->memoryManager->get_total_memory()),
+                                            thisAgent->Decider->settings[DECIDER_MAX_MEMORY_USAGE]);
+        xml_generate_error(thisAgent, "Memory usage exceeded max-memory-usage.  Soar halted.");
+        soar_invoke_callbacks(thisAgent,
+                              MAX_MEMORY_USAGE_CALLBACK,
+                              reinterpret_cast<soar_call_data>(thisAgent->current_phase));
+        thisAgent->system_halted = true;
+    }
+
     if (thisAgent->system_halted)
     {
         thisAgent->stop_soar = true;
@@ -499,10 +499,12 @@ epmem_hash_id epmem_temporal_hash(agent* thisAgent, Symbol* sym, bool add_on_fai
 
     if (sym->is_constant())
     {
-        if ((!sym->epmem_hash) || (sym->epmem_valid != thisAgent->EpMem->epmem_validation))
+        symbol_side_data& side = thisAgent->symbolManager->side_data(sym);
+
+        if ((!side.epmem_hash) || (side.epmem_valid != thisAgent->EpMem->epmem_validation))
         {
-            sym->epmem_hash = NIL;
-            sym->epmem_valid = thisAgent->EpMem->epmem_validation;
+            side.epmem_hash = NIL;
+            side.epmem_valid = thisAgent->EpMem->epmem_validation;
 
             switch (sym->symbol_type)
             {
@@ -520,11 +522,11 @@ epmem_hash_id epmem_temporal_hash(agent* thisAgent, Symbol* sym, bool add_on_fai
             }
 
             // cache results for later re-use
-            sym->epmem_hash = return_val;
-            sym->epmem_valid = thisAgent->EpMem->epmem_validation;
+            side.epmem_hash = return_val;
+            side.epmem_valid = thisAgent->EpMem->epmem_validation;
         }
 
-        return_val = sym->epmem_hash;
+        return_val = side.epmem_hash;
     }
 
     ////////////////////////////////////////////////////////////////////////////
@@ -2461,7 +2463,7 @@ inline void _epmem_store_level(agent* thisAgent,
 //              (*w_p)->id->symbol_type,  (*w_p)->attr->var->symbol_type,  (*w_p)->value->symbol_type);
 //      #endif
         // skip over WMEs already in the system
-        if (((*w_p)->epmem_id != EPMEM_NODEID_BAD) && ((*w_p)->epmem_valid == thisAgent->EpMem->epmem_validation))
+        if ((wme_cold_fields(*w_p)->epmem_id != EPMEM_NODEID_BAD) && (wme_cold_fields(*w_p)->epmem_valid == thisAgent->EpMem->epmem_validation))
         {
             continue;
         }
@@ -2540,10 +2542,10 @@ inline void _epmem_store_level(agent* thisAgent,
                 (unsigned int) parent_id, symbol_to_string(thisAgent, (*w_p)->attr, true, NIL, 0), symbol_to_string(thisAgent, (*w_p)->value, true, NIL, 0));
 #endif
         // skip over WMEs already in the system
-        if (((*w_p)->epmem_id != EPMEM_NODEID_BAD) && ((*w_p)->epmem_valid == thisAgent->EpMem->epmem_validation))
+        if ((wme_cold_fields(*w_p)->epmem_id != EPMEM_NODEID_BAD) && (wme_cold_fields(*w_p)->epmem_valid == thisAgent->EpMem->epmem_validation))
         {
 #ifdef DEBUG_EPMEM_WME_ADD
-            fprintf(stderr, "   WME already in system with id %d.\n", (unsigned int)(*w_p)->epmem_id);
+            fprintf(stderr, "   WME already in system with id %d.\n", (unsigned int)wme_cold_fields(*w_p)->epmem_id);
 #endif
             continue;
         }
@@ -2562,8 +2564,9 @@ inline void _epmem_store_level(agent* thisAgent,
 #ifdef DEBUG_EPMEM_WME_ADD
             fprintf(stderr, "   WME value is IDENTIFIER.\n");
 #endif
-            (*w_p)->epmem_valid = thisAgent->EpMem->epmem_validation;
-            (*w_p)->epmem_id = EPMEM_NODEID_BAD;
+            wme_cold* w_cold = writable_wme_cold_fields(thisAgent, *w_p);
+            w_cold->epmem_valid = thisAgent->EpMem->epmem_validation;
+            w_cold->epmem_id = EPMEM_NODEID_BAD;
 
             my_hash = NIL;
             my_id_repo2 = NIL;
@@ -2601,10 +2604,10 @@ inline void _epmem_store_level(agent* thisAgent,
 
                         if (r_p->second->my_id != EPMEM_NODEID_BAD)
                         {
-                            (*w_p)->epmem_id = r_p->second->my_id;
-                            (*thisAgent->EpMem->epmem_id_replacement)[(*w_p)->epmem_id ] = my_id_repo2;
+                            w_cold->epmem_id = r_p->second->my_id;
+                            (*thisAgent->EpMem->epmem_id_replacement)[w_cold->epmem_id ] = my_id_repo2;
 #ifdef DEBUG_EPMEM_WME_ADD
-                            fprintf(stderr, "   Assigning id from existing pool: %d\n", (unsigned int)(*w_p)->epmem_id);
+                            fprintf(stderr, "   Assigning id from existing pool: %d\n", (unsigned int)w_cold->epmem_id);
 #endif
                         }
 
@@ -2638,11 +2641,11 @@ inline void _epmem_store_level(agent* thisAgent,
                                 {
                                     if (pool_p->first == (*w_p)->value->id->epmem_id)
                                     {
-                                        (*w_p)->epmem_id = pool_p->second;
+                                        w_cold->epmem_id = pool_p->second;
                                         (*my_id_repo)->erase(pool_p);
-                                        (*thisAgent->EpMem->epmem_id_replacement)[(*w_p)->epmem_id ] = (*my_id_repo);
+                                        (*thisAgent->EpMem->epmem_id_replacement)[w_cold->epmem_id ] = (*my_id_repo);
 #ifdef DEBUG_EPMEM_WME_ADD
-                                        fprintf(stderr, "   Assigning id from existing pool: %d\n", (unsigned int)(*w_p)->epmem_id);
+                                        fprintf(stderr, "   Assigning id from existing pool: %d\n", (unsigned int)w_cold->epmem_id);
 #endif
                                         break;
                                     }
@@ -2700,17 +2703,17 @@ inline void _epmem_store_level(agent* thisAgent,
                                         ((*thisAgent->EpMem->epmem_id_ref_counts)[ pool_p->first ]->empty()))
 
                                 {
-                                    (*w_p)->epmem_id = pool_p->second;
+                                    w_cold->epmem_id = pool_p->second;
                                     (*w_p)->value->id->epmem_id = pool_p->first;
 #ifdef DEBUG_EPMEM_WME_ADD
                                     fprintf(stderr, "   Found unused id. Setting wme id for VALUE to %d\n", (unsigned int)(*w_p)->value->id->epmem_id);
 #endif
                                     (*w_p)->value->id->epmem_valid = thisAgent->EpMem->epmem_validation;
                                     (*my_id_repo)->erase(pool_p);
-                                    (*thisAgent->EpMem->epmem_id_replacement)[(*w_p)->epmem_id ] = (*my_id_repo);
+                                    (*thisAgent->EpMem->epmem_id_replacement)[w_cold->epmem_id ] = (*my_id_repo);
 
 #ifdef DEBUG_EPMEM_WME_ADD
-                                    fprintf(stderr, "   Assigning id from existing pool %d.\n", (unsigned int)(*w_p)->epmem_id);
+                                    fprintf(stderr, "   Assigning id from existing pool %d.\n", (unsigned int)w_cold->epmem_id);
 #endif
                                     break;
                                 }
@@ -2732,7 +2735,7 @@ inline void _epmem_store_level(agent* thisAgent,
             }
 
             // add wme if no success above
-            if ((*w_p)->epmem_id == EPMEM_NODEID_BAD)
+            if (w_cold->epmem_id == EPMEM_NODEID_BAD)
             {
 #ifdef DEBUG_EPMEM_WME_ADD
                 fprintf(stderr, "   No success, adding wme to database.");
@@ -2784,15 +2787,15 @@ inline void _epmem_store_level(agent* thisAgent,
                 thisAgent->EpMem->epmem_stmts_graph->add_epmem_wmes_identifier->bind_int(4, LLONG_MAX);
                 thisAgent->EpMem->epmem_stmts_graph->add_epmem_wmes_identifier->execute(soar_module::op_reinit);
 
-                (*w_p)->epmem_id = static_cast<epmem_node_id>(thisAgent->EpMem->epmem_db->last_insert_rowid());
+                w_cold->epmem_id = static_cast<epmem_node_id>(thisAgent->EpMem->epmem_db->last_insert_rowid());
 #ifdef DEBUG_EPMEM_WME_ADD
-                fprintf(stderr, "   Incrementing and setting wme id to %d\n", (unsigned int)(*w_p)->epmem_id);
+                fprintf(stderr, "   Incrementing and setting wme id to %d\n", (unsigned int)w_cold->epmem_id);
 #endif
                 // replace the epmem_id and wme id in the right place
-                (*thisAgent->EpMem->epmem_id_replacement)[(*w_p)->epmem_id ] = my_id_repo2;
+                (*thisAgent->EpMem->epmem_id_replacement)[w_cold->epmem_id ] = my_id_repo2;
 
                 // new nodes definitely start
-                epmem_edge.emplace((*w_p)->epmem_id,static_cast<int64_t>((*w_p)->value->id->is_lti() ? (*w_p)->value->id->LTI_ID : 0));
+                epmem_edge.emplace(w_cold->epmem_id,static_cast<int64_t>((*w_p)->value->id->is_lti() ? (*w_p)->value->id->LTI_ID : 0));
                 thisAgent->EpMem->epmem_edge_mins->push_back(time_counter);
                 thisAgent->EpMem->epmem_edge_maxes->push_back(false);
             }
@@ -2802,13 +2805,13 @@ inline void _epmem_store_level(agent* thisAgent,
                 fprintf(stderr, "   No success but already has id, so don't remove.\n");
 #endif
                 // definitely don't remove
-                (*thisAgent->EpMem->epmem_edge_removals)[std::make_pair((*w_p)->epmem_id, static_cast<int64_t>((*w_p)->value->id->is_lti() ? (*w_p)->value->id->LTI_ID : 0)) ] = false;
+                (*thisAgent->EpMem->epmem_edge_removals)[std::make_pair(w_cold->epmem_id, static_cast<int64_t>((*w_p)->value->id->is_lti() ? (*w_p)->value->id->LTI_ID : 0)) ] = false;
 
                 // we add ONLY if the last thing we did was remove
-                if ((*thisAgent->EpMem->epmem_edge_maxes)[static_cast<size_t>((*w_p)->epmem_id - 1)])
+                if ((*thisAgent->EpMem->epmem_edge_maxes)[static_cast<size_t>(w_cold->epmem_id - 1)])
                 {
-                    epmem_edge.emplace((*w_p)->epmem_id,static_cast<int64_t>((*w_p)->value->id->is_lti() ? (*w_p)->value->id->LTI_ID : 0));
-                    (*thisAgent->EpMem->epmem_edge_maxes)[static_cast<size_t>((*w_p)->epmem_id - 1)] = false;
+                    epmem_edge.emplace(w_cold->epmem_id,static_cast<int64_t>((*w_p)->value->id->is_lti() ? (*w_p)->value->id->LTI_ID : 0));
+                    (*thisAgent->EpMem->epmem_edge_maxes)[static_cast<size_t>(w_cold->epmem_id - 1)] = false;
                 }
             }
 
@@ -2847,16 +2850,17 @@ inline void _epmem_store_level(agent* thisAgent,
 #ifdef DEBUG_EPMEM_WME_ADD
             fprintf(stderr, "   WME value is a CONSTANT.\n");
 #endif
+            wme_cold* w_cold = writable_wme_cold_fields(thisAgent, *w_p);
 
             // have we seen this node in this database?
-            if (((*w_p)->epmem_id == EPMEM_NODEID_BAD) || ((*w_p)->epmem_valid != thisAgent->EpMem->epmem_validation))
+            if ((w_cold->epmem_id == EPMEM_NODEID_BAD) || (w_cold->epmem_valid != thisAgent->EpMem->epmem_validation))
             {
 #ifdef DEBUG_EPMEM_WME_ADD
                 fprintf(stderr, "   This is a new wme.\n");
 #endif
 
-                (*w_p)->epmem_id = EPMEM_NODEID_BAD;
-                (*w_p)->epmem_valid = thisAgent->EpMem->epmem_validation;
+                w_cold->epmem_id = EPMEM_NODEID_BAD;
+                w_cold->epmem_valid = thisAgent->EpMem->epmem_validation;
 
                 my_hash = epmem_temporal_hash(thisAgent, (*w_p)->attr);
                 my_hash2 = epmem_temporal_hash(thisAgent, (*w_p)->value);
@@ -2873,14 +2877,14 @@ inline void _epmem_store_level(agent* thisAgent,
 
                     if (thisAgent->EpMem->epmem_stmts_graph->find_epmem_wmes_constant->execute() == soar_module::row)
                     {
-                        (*w_p)->epmem_id = thisAgent->EpMem->epmem_stmts_graph->find_epmem_wmes_constant->column_int(0);
+                        w_cold->epmem_id = thisAgent->EpMem->epmem_stmts_graph->find_epmem_wmes_constant->column_int(0);
                     }
 
                     thisAgent->EpMem->epmem_stmts_graph->find_epmem_wmes_constant->reinitialize();
                 }
 
                 // act depending on new/existing feature
-                if ((*w_p)->epmem_id == EPMEM_NODEID_BAD)
+                if (w_cold->epmem_id == EPMEM_NODEID_BAD)
                 {
 #ifdef DEBUG_EPMEM_WME_ADD
                     fprintf(stderr, "   No duplicate wme found in epmem_wmes_constant.  Adding wme to table!!!!\n");
@@ -2893,12 +2897,12 @@ inline void _epmem_store_level(agent* thisAgent,
                     thisAgent->EpMem->epmem_stmts_graph->add_epmem_wmes_constant->bind_int(3, my_hash2);
                     thisAgent->EpMem->epmem_stmts_graph->add_epmem_wmes_constant->execute(soar_module::op_reinit);
 
-                    (*w_p)->epmem_id = (epmem_node_id) thisAgent->EpMem->epmem_db->last_insert_rowid();
+                    w_cold->epmem_id = (epmem_node_id) thisAgent->EpMem->epmem_db->last_insert_rowid();
 #ifdef DEBUG_EPMEM_WME_ADD
-                    fprintf(stderr, "   Setting wme id from last row to %d\n", (unsigned int)(*w_p)->epmem_id);
+                    fprintf(stderr, "   Setting wme id from last row to %d\n", (unsigned int)w_cold->epmem_id);
 #endif
                     // new nodes definitely start
-                    epmem_node.push((*w_p)->epmem_id);
+                    epmem_node.push(w_cold->epmem_id);
                     thisAgent->EpMem->epmem_node_mins->push_back(time_counter);
                     thisAgent->EpMem->epmem_node_maxes->push_back(false);
                 }
@@ -2906,16 +2910,16 @@ inline void _epmem_store_level(agent* thisAgent,
                 {
 #ifdef DEBUG_EPMEM_WME_ADD
                     fprintf(stderr, "   Node found in database, definitely don't remove.\n");
-                    fprintf(stderr, "   Setting wme id from existing node to %d\n", (unsigned int)(*w_p)->epmem_id);
+                    fprintf(stderr, "   Setting wme id from existing node to %d\n", (unsigned int)w_cold->epmem_id);
 #endif
                     // definitely don't remove
-                    (*thisAgent->EpMem->epmem_node_removals)[(*w_p)->epmem_id ] = false;
+                    (*thisAgent->EpMem->epmem_node_removals)[w_cold->epmem_id ] = false;
 
                     // add ONLY if the last thing we did was add
-                    if ((*thisAgent->EpMem->epmem_node_maxes)[static_cast<size_t>((*w_p)->epmem_id - 1)])
+                    if ((*thisAgent->EpMem->epmem_node_maxes)[static_cast<size_t>(w_cold->epmem_id - 1)])
                     {
-                        epmem_node.push((*w_p)->epmem_id);
-                        (*thisAgent->EpMem->epmem_node_maxes)[static_cast<size_t>((*w_p)->epmem_id - 1)] = false;
+                        epmem_node.push(w_cold->epmem_id);
+                        (*thisAgent->EpMem->epmem_node_maxes)[static_cast<size_t>(w_cold->epmem_id - 1)] = false;
                     }
                 }
             }
@@ -62,9 +62,9 @@ void Explanation_Based_Chunker::add_to_grounds(condition* cond)
     if ((cond)->bt.wme_->tc != grounds_tc)
     {
         (cond)->bt.wme_->tc = grounds_tc;
-        cond->bt.wme_->chunker_bt_last_ground_cond = cond;
+        writable_wme_cold_fields(thisAgent, cond->bt.wme_)->chunker_bt_last_ground_cond = cond;
     }
-    if ((cond->bt.wme_->chunker_bt_last_ground_cond != cond) && ebc_settings[SETTING_EBC_LEARNING_ON])
+    if ((wme_cold_fields(cond->bt.wme_)->chunker_bt_last_ground_cond != cond) && ebc_settings[SETTING_EBC_LEARNING_ON])
     {
         check_for_singleton_unification(cond);
     }
@@ -112,7 +112,7 @@ void remove_output_function(agent* thisAgent, const char* name)
         if (ol->cb == cb)
         {
             /* Remove ol entry */
-            ol->link_wme->output_link = NULL;
+            writable_wme_cold_fields(thisAgent, ol->link_wme)->output_link = NULL;
             wme_remove_ref(thisAgent, ol->link_wme);
             remove_from_dll(thisAgent->existing_output_links, ol, next, prev);
             thisAgent->memoryManager->free_with_pool(MP_output_link, ol);
@@ -209,47 +209,27 @@ wme* add_input_wme(agent* thisAgent, Symbol* id, Symbol* attr, Symbol* value)
     }
 
     add_wme_to_wm(thisAgent, w);
+    (*thisAgent->input_wmes_by_timetag)[w->timetag] = w;
 
     //PrintDebugFormat("Added wme with timetag %d to id %c%d ",w->timetag,id->id->name_letter,id->id->name_number) ;
 
     return w;
 }
 
-wme* find_input_wme_by_timetag_from_id(agent* thisAgent, Symbol* idSym, uint64_t timetag, tc_number tc)
+wme* find_input_wme_by_timetag(agent* thisAgent, uint64_t timetag)
 {
-    wme* pWME, *w;
+    std::unordered_map< uint64_t, wme* >::iterator it = thisAgent->input_wmes_by_timetag->find(timetag);
 
-    //PrintDebugFormat("Scanning id %c%d", idSym->id->name_letter, idSym->id->name_number) ;
-
-    // Mark this id as having been visited (the key here is that tc numbers always increase so tc_num must be < tc until it's marked)
-    idSym->id->tc_num = tc ;
-
-    // This is inefficient.  Using a hash table could save a lot here.
-    for (pWME = idSym->id->input_wmes; pWME != NIL; pWME = pWME->next)
+    if (it == thisAgent->input_wmes_by_timetag->end())
     {
-        //PrintDebugFormat("Timetag %ld", pWME->timetag) ;
-        if (pWME->timetag == timetag)
-        {
-            return pWME ;
-        }
-
-        // NOTE: The test for the tc_num keeps us from getting stuck in loops within graphs
-        if (pWME->value->symbol_type == IDENTIFIER_SYMBOL_TYPE && pWME->value->id->tc_num != tc)
-        {
-            w = find_input_wme_by_timetag_from_id(thisAgent, pWME->value, timetag, tc) ;
-            if (w)
-            {
-                return w ;
-            }
-        }
+        return NIL;
     }
-
-    return NIL ;
+    return it->second;
 }
 
 bool remove_input_wme(agent* thisAgent, wme* w)
 {
-    wme* temp;
+    std::unordered_map< uint64_t, wme* >::iterator it;
 
     /* --- a little bit of error checking --- */
     if (!w)
@@ -257,26 +237,20 @@ bool remove_input_wme(agent* thisAgent, wme* w)
         thisAgent->outputManager->printa_sf(thisAgent,  "Error: an input routine called remove_input_wme on a NULL wme.\n");
         return false;
     }
-    for (temp = w->id->id->input_wmes; temp != NIL; temp = temp->next)
-        if (temp == w)
-        {
-            break;
-        }
-    if (!temp)
+    it = thisAgent->input_wmes_by_timetag->find(w->timetag);
+    if ((it == thisAgent->input_wmes_by_timetag->end()) || (it->second != w))
     {
         thisAgent->outputManager->printa_sf(thisAgent,  "Error: an input routine called remove_input_wme on a wme that\n");
         thisAgent->outputManager->printa_sf(thisAgent,  "isn't one of the input wmes currently in working memory.\n");
         return false;
     }
-    /* Note: for efficiency, it might be better to use a hash table for the
-    above test, rather than scanning the linked list.  We could have one
-    global hash table for all the input wmes in the system. */
     /* --- go ahead and remove the wme --- */
+    thisAgent->input_wmes_by_timetag->erase(it);
     remove_from_dll(w->id->id->input_wmes, w, next, prev);
     /* REW: begin 09.15.96 */
-    if (w->gds)
+    if (wme_cold_fields(w)->gds)
     {
-        if (w->gds->goal != NIL)
+        if (wme_cold_fields(w)->gds->goal != NIL)
         {
             gds_invalid_so_remove_goal(thisAgent, w);
             /* NOTE: the call to remove_wme_from_wm will take care
@@ -414,15 +388,27 @@ void do_input_cycle(agent* thisAgent)
          mark link "modified but same tc" (unless it's already marked
          some other more serious way)
 
-     For wme addition or removal: (<id> ^att <id2>):
+     For wme addition: (<id> ^att <id2>):
        for each link in associated_output_links(id),
-         mark link "modified" (unless it's already marked
-         some other more serious way)
+         add id2 and everything reachable from it to the link's TC,
+         then mark link "modified but same tc"
 
-   Note that we don't update all the TC information after every WM change.
-   The TC info doesn't get updated until do_output_cycle() is called.
+     For wme removal: (<id> ^att <id2>):
+       for each link in associated_output_links(id),
+         mark link "modified but same tc"; once the whole batch has been
+         seen, if id2 is now unreachable (see remove_unlinked_id_from_output_link_tc)
+         drop it and what hangs only off it from the link's TC, otherwise
+         mark link "modified"
+
+   So the TC info of an unchanged link is kept current as WM changes, and
+   the cost is proportional to the structure added or removed.  Only a
+   removal we can't account for this way leaves the TC to be recalculated
+   from scratch when do_output_cycle() is called.
 -------------------------------------------------------------------- */
 
+void add_id_to_output_link_tc(agent* thisAgent, output_link* ol, Symbol* id);
+bool remove_unlinked_id_from_output_link_tc(agent* thisAgent, output_link* ol, Symbol* id);
+
 #define LINK_NAME_SIZE 1024
 void update_for_top_state_wme_addition(agent* thisAgent, wme* w)
 {
@@ -446,9 +432,10 @@ void update_for_top_state_wme_addition(agent* thisAgent, wme* w)
     ol->link_wme = w;
     wme_add_ref(w, true);
     ol->ids_in_tc = NIL;
+    ol->ids_maybe_unlinked = NIL;
     ol->cb = cb;
     /* --- make wme point to the structure --- */
-    w->output_link = ol;
+    writable_wme_cold_fields(thisAgent, w)->output_link = ol;
 
     /* SW 07 10 2003
        previously, this wouldn't be done until the first OUTPUT phase.
@@ -479,14 +466,14 @@ void update_for_top_state_wme_addition(agent* thisAgent, wme* w)
 
 void update_for_top_state_wme_removal(wme* w)
 {
-    if (! w->output_link)
+    if (! wme_cold_fields(w)->output_link)
     {
         return;
     }
-    w->output_link->status = REMOVED_OL_STATUS;
+    wme_cold_fields(w)->output_link->status = REMOVED_OL_STATUS;
 }
 
-void update_for_io_wme_change(wme* w)
+void update_for_io_wme_change(agent* thisAgent, wme* w, bool is_addition)
 {
     cons* c;
     output_link* ol;
@@ -496,11 +483,19 @@ void update_for_io_wme_change(wme* w)
         ol = static_cast<output_link_struct*>(c->first);
         if (w->value->symbol_type == IDENTIFIER_SYMBOL_TYPE)
         {
-            /* --- mark ol "modified" --- */
             if ((ol->status == UNCHANGED_OL_STATUS) ||
                     (ol->status == MODIFIED_BUT_SAME_TC_OL_STATUS))
             {
-                ol->status = MODIFIED_OL_STATUS;
+                /* --- update the TC in place; removals wait for the whole batch --- */
+                if (is_addition)
+                {
+                    add_id_to_output_link_tc(thisAgent, ol, w->value);
+                }
+                else
+                {
+                    push(thisAgent, w->value, ol->ids_maybe_unlinked);
+                }
+                ol->status = MODIFIED_BUT_SAME_TC_OL_STATUS;
             }
         }
         else
@@ -514,6 +509,38 @@ void update_for_io_wme_change(wme* w)
     }
 }
 
+/* --------------------------------------------------------------------
+   Once the whole batch of removals has been seen, try to drop the ids
+   that lost a link from each link's TC.  Waiting matters: if (A ^x B)
+   and (B ^y C) go away together and we pruned B straight away, the
+   (B ^y C) removal would no longer be seen as part of the TC and C
+   would be left behind.
+-------------------------------------------------------------------- */
+
+void prune_output_link_tcs(agent* thisAgent)
+{
+    output_link* ol;
+    cons* c;
+    Symbol* id;
+
+    for (ol = thisAgent->existing_output_links; ol != NIL; ol = ol->next)
+    {
+        while (ol->ids_maybe_unlinked)
+        {
+            c = ol->ids_maybe_unlinked;
+            ol->ids_maybe_unlinked = c->rest;
+            id = static_cast<symbol_struct*>(c->first);
+            free_cons(thisAgent, c);
+
+            if ((ol->status == MODIFIED_BUT_SAME_TC_OL_STATUS) &&
+                    !remove_unlinked_id_from_output_link_tc(thisAgent, ol, id))
+            {
+                ol->status = MODIFIED_OL_STATUS;
+            }
+        }
+    }
+}
+
 void inform_output_module_of_wm_changes(agent* thisAgent,
                                         cons* wmes_being_added,
                                         cons* wmes_being_removed)
@@ -533,7 +560,7 @@ void inform_output_module_of_wm_changes(agent* thisAgent,
         }
         if (w->id->id->associated_output_links)
         {
-            update_for_io_wme_change(w);
+            update_for_io_wme_change(thisAgent, w, true);
             thisAgent->output_link_changed = true; /* KJC 11/23/98 */
             thisAgent->d_cycle_last_output = thisAgent->d_cycle_count;   /* KJC 11/17/05 */
         }
@@ -561,26 +588,67 @@ void inform_output_module_of_wm_changes(agent* thisAgent,
         }
         if (w->id->id->associated_output_links)
         {
-            update_for_io_wme_change(w);
+            update_for_io_wme_change(thisAgent, w, false);
         }
     }
+    prune_output_link_tcs(thisAgent);
 }
 
 /* --------------------------------------------------------------------
                      Updating Link TC Information
 
-   We make no attempt to do the TC updating intelligently.  Whenever the
-   TC changes, we throw away all the old TC info and recalculate the new
-   TC from scratch.  I figure that this part of the system won't get
-   used very frequently and I hope it won't be a time hog.
-
-   Remove_output_link_tc_info() and calculate_output_link_tc_info() are
-   the main routines here.
+   Each output link keeps the list of ids in its TC, and each id keeps
+   the list of output links whose TC it is in; the latter doubles as the
+   membership test, so the TC info stays valid across other tc_number
+   walks.  Calculate_output_link_tc_info() builds the TC from scratch
+   and remove_output_link_tc_info() throws it all away.  In between,
+   update_for_io_wme_change() grows the TC with add_id_to_output_link_tc()
+   and prune_output_link_tcs() shrinks it with
+   remove_unlinked_id_from_output_link_tc().
 -------------------------------------------------------------------- */
 
-void remove_output_link_tc_info(agent* thisAgent, output_link* ol)
+inline bool id_in_output_link_tc(Symbol* id, output_link* ol)
+{
+    for (cons* c = id->id->associated_output_links; c != NIL; c = c->rest)
+        if (c->first == ol)
+        {
+            return true;
+        }
+    return false;
+}
+
+void remove_output_link_from_id(agent* thisAgent, output_link* ol, Symbol* id)
 {
     cons* c, *prev_c;
+
+    /* --- remove "ol" from the list of associated_output_links(id) --- */
+    prev_c = NIL;
+    for (c = id->id->associated_output_links; c != NIL; prev_c = c, c = c->rest)
+        if (c->first == ol)
+        {
+            break;
+        }
+    if (!c)
+    {
+        char msg[BUFFER_MSG_SIZE];
+        strncpy(msg, "io.c: Internal error: can't find output link in id's list\n", BUFFER_MSG_SIZE);
+        msg[BUFFER_MSG_SIZE - 1] = 0; /* ensure null termination */
+        abort_with_fatal_error(thisAgent, msg);
+    }
+    if (prev_c)
+    {
+        prev_c->rest = c->rest;
+    }
+    else
+    {
+        id->id->associated_output_links = c->rest;
+    }
+    free_cons(thisAgent, c);
+}
+
+void remove_output_link_tc_info(agent* thisAgent, output_link* ol)
+{
+    cons* c;
     Symbol* id;
 
     while (ol->ids_in_tc)    /* for each id in the old TC... */
@@ -590,72 +658,116 @@ void remove_output_link_tc_info(agent* thisAgent, output_link* ol)
         id = static_cast<symbol_struct*>(c->first);
         free_cons(thisAgent, c);
 
-        /* --- remove "ol" from the list of associated_output_links(id) --- */
-        prev_c = NIL;
-        for (c = id->id->associated_output_links; c != NIL; prev_c = c, c = c->rest)
-            if (c->first == ol)
-            {
-                break;
-            }
-        if (!c)
-        {
-            char msg[BUFFER_MSG_SIZE];
-            strncpy(msg, "io.c: Internal error: can't find output link in id's list\n", BUFFER_MSG_SIZE);
-            msg[BUFFER_MSG_SIZE - 1] = 0; /* ensure null termination */
-            abort_with_fatal_error(thisAgent, msg);
-        }
-        if (prev_c)
-        {
-            prev_c->rest = c->rest;
-        }
-        else
-        {
-            id->id->associated_output_links = c->rest;
-        }
-        free_cons(thisAgent, c);
+        remove_output_link_from_id(thisAgent, ol, id);
         thisAgent->symbolManager->symbol_remove_ref(&id);
     }
 }
 
 
-void add_id_to_output_link_tc(agent* thisAgent, Symbol* id)
+void add_id_to_output_link_tc(agent* thisAgent, output_link* ol, Symbol* id)
 {
     slot* s;
     wme* w;
 
     /* --- if id is already in the TC, exit --- */
-    if (id->tc_num == thisAgent->output_link_tc_num)
+    if (id_in_output_link_tc(id, ol))
     {
         return;
     }
-    id->tc_num = thisAgent->output_link_tc_num;
-
 
     /* --- add id to output_link's list --- */
-    push(thisAgent, id, thisAgent->output_link_for_tc->ids_in_tc);
+    push(thisAgent, id, ol->ids_in_tc);
     thisAgent->symbolManager->symbol_add_ref(id);  /* make sure the id doesn't get deallocated before we
                            have a chance to free the cons cell we just added */
 
     /* --- add output_link to id's list --- */
-    push(thisAgent, thisAgent->output_link_for_tc, id->id->associated_output_links);
+    push(thisAgent, ol, id->id->associated_output_links);
 
     /* --- do TC through working memory --- */
     /* --- scan through all wmes for all slots for this id --- */
     for (w = id->id->input_wmes; w != NIL; w = w->next)
         if (w->value->symbol_type == IDENTIFIER_SYMBOL_TYPE)
         {
-            add_id_to_output_link_tc(thisAgent, w->value);
+            add_id_to_output_link_tc(thisAgent, ol, w->value);
         }
     for (s = id->id->slots; s != NIL; s = s->next)
         for (w = s->wmes; w != NIL; w = w->next)
             if (w->value->symbol_type == IDENTIFIER_SYMBOL_TYPE)
             {
-                add_id_to_output_link_tc(thisAgent, w->value);
+                add_id_to_output_link_tc(thisAgent, ol, w->value);
             }
     /* don't need to check impasse_wmes, because we couldn't have a pointer
        to a goal or impasse identifier */
 }
 
+/* --------------------------------------------------------------------
+   Called after a link to id from inside the TC of ol has been removed.
+   If nothing else in WM links to id (its link_count is zero), id is
+   garbage, and so is every child whose only link is the one from id;
+   those are dropped from the TC and true is returned.  If id is still
+   linked from somewhere, we can't tell cheaply whether that somewhere
+   is in the TC, so we return false and the TC gets recalculated.  (Any
+   part already dropped by then is consistent, since both lists are
+   updated together.)
+-------------------------------------------------------------------- */
+
+bool remove_id_from_output_link_tc_if_garbage(agent* thisAgent, output_link* ol, Symbol* id, uint64_t links_from_garbage)
+{
+    cons* c, *prev_c;
+    slot* s;
+    wme* w;
+    bool all_removed;
+
+    if (!id_in_output_link_tc(id, ol))
+    {
+        return true;
+    }
+    if (id->id->link_count != links_from_garbage)
+    {
+        return false;
+    }
+
+    /* --- remove id from output_link's list --- */
+    prev_c = NIL;
+    for (c = ol->ids_in_tc; c != NIL; prev_c = c, c = c->rest)
+        if (c->first == id)
+        {
+            break;
+        }
+    if (prev_c)
+    {
+        prev_c->rest = c->rest;
+    }
+    else
+    {
+        ol->ids_in_tc = c->rest;
+    }
+    free_cons(thisAgent, c);
+    remove_output_link_from_id(thisAgent, ol, id);
+
+    /* --- a child whose only link is from id is garbage too --- */
+    all_removed = true;
+    for (w = id->id->input_wmes; w != NIL; w = w->next)
+        if (w->value->symbol_type == IDENTIFIER_SYMBOL_TYPE)
+        {
+            all_removed = remove_id_from_output_link_tc_if_garbage(thisAgent, ol, w->value, 1) && all_removed;
+        }
+    for (s = id->id->slots; s != NIL; s = s->next)
+        for (w = s->wmes; w != NIL; w = w->next)
+            if (w->value->symbol_type == IDENTIFIER_SYMBOL_TYPE)
+            {
+                all_removed = remove_id_from_output_link_tc_if_garbage(thisAgent, ol, w->value, 1) && all_removed;
+            }
+
+    thisAgent->symbolManager->symbol_remove_ref(&id);
+    return all_removed;
+}
+
+bool remove_unlinked_id_from_output_link_tc(agent* thisAgent, output_link* ol, Symbol* id)
+{
+    return remove_id_from_output_link_tc_if_garbage(thisAgent, ol, id, 0);
+}
+
 void calculate_output_link_tc_info(agent* thisAgent, output_link* ol)
 {
     /* --- if link doesn't have any substructure, there's no TC --- */
@@ -665,9 +777,7 @@ void calculate_output_link_tc_info(agent* thisAgent, output_link* ol)
     }
 
     /* --- do TC starting with the link wme's value --- */
-    thisAgent->output_link_for_tc = ol;
-    thisAgent->output_link_tc_num = get_new_tc_number(thisAgent);
-    add_id_to_output_link_tc(thisAgent, ol->link_wme->value);
+    add_id_to_output_link_tc(thisAgent, ol, ol->link_wme->value);
 }
 
 /* --------------------------------------------------------------------
@@ -106,6 +106,11 @@ extern Symbol* get_next_io_symbol_from_text_input_line(agent* thisAgent,
    TOP_STATE_JUST_REMOVED.  Remove_input_wme() normally returns true,
    indicating success.  It returns false if an error occurs (e.g., if the
    wme argument isn't in WM).
+
+   Find_input_wme_by_timetag() returns the input wme with the given
+   timetag, or NIL if there isn't one.  The agent keeps a hash table of its
+   input wmes by timetag for this, which remove_input_wme() also uses to
+   check its argument, so neither has to scan the input structures.
 ======================================================================= */
 
 #define TOP_STATE_JUST_CREATED 1
@@ -121,6 +126,7 @@ extern void release_io_symbol(agent* thisAgent, Symbol* sym);
 
 extern wme* add_input_wme(agent* thisAgent, Symbol* id, Symbol* attr, Symbol* value);
 extern bool remove_input_wme(agent* thisAgent, wme* w);
+extern wme* find_input_wme_by_timetag(agent* thisAgent, uint64_t timetag);
 
 /* =======================================================================
                             Output Functions
@@ -176,6 +182,7 @@ typedef struct output_link_struct
     byte status;                             /* current xxx_OL_STATUS */
     wme* link_wme;                           /* points to the output link wme */
     cons* ids_in_tc;                         /* ids in TC(link) */
+    cons* ids_maybe_unlinked;                /* ids that lost a link from the TC */
     soar_callback* cb;                       /* corresponding output function */
 } output_link;
 
@@ -731,10 +731,12 @@ smem_hash_id SMem_Manager::hash(Symbol* sym, bool add_on_fail)
 
     if (sym->is_constant())
     {
-        if ((!sym->smem_hash) || (sym->smem_valid != smem_validation))
+        symbol_side_data& side = thisAgent->symbolManager->side_data(sym);
+
+        if ((!side.smem_hash) || (side.smem_valid != smem_validation))
         {
-            sym->smem_hash = NIL;
-            sym->smem_valid = smem_validation;
+            side.smem_hash = NIL;
+            side.smem_valid = smem_validation;
 
             switch (sym->symbol_type)
             {
@@ -752,11 +754,11 @@ smem_hash_id SMem_Manager::hash(Symbol* sym, bool add_on_fail)
             }
 
             // cache results for later re-use
-            sym->smem_hash = return_val;
-            sym->smem_valid = smem_validation;
+            side.smem_hash = return_val;
+            side.smem_valid = smem_validation;
         }
 
-        return_val = sym->smem_hash;
+        return_val = side.smem_hash;
     }
 
     ////////////////////////////////////////////////////////////////////////////
@@ -156,7 +156,7 @@ Symbol* SMem_Manager::get_current_iSTI_for_LTI(uint64_t pLTI_ID, goal_stack_leve
         return_val->id->level = pLevel;
         return_val->id->promotion_level = pLevel;
         return_val->id->LTI_ID = pLTI_ID;
-        return_val->id->smem_valid = smem_validation;
+        thisAgent->symbolManager->side_data(return_val).smem_valid = smem_validation;
         lti_to_sti_map[pLTI_ID] = return_val;
         return return_val;
     }
@@ -194,7 +194,7 @@ uint64_t SMem_Manager::get_current_LTI_for_iSTI(Symbol* pISTI, bool useLookupTab
     {
         pISTI->id->LTI_ID = returnVal;
         pISTI->update_cached_lti_print_str();
-        pISTI->id->smem_valid = smem_validation;
+        thisAgent->symbolManager->side_data(pISTI).smem_valid = smem_validation;
     }
     return returnVal;
 
@@ -230,7 +230,7 @@ void SMem_Manager::install_memory(Symbol* state, uint64_t pLTI_ID, Symbol* sti,
             sti->id->level = NO_WME_LEVEL;
             sti->id->promotion_level = NO_WME_LEVEL;
             sti->id->LTI_ID = pLTI_ID;
-            sti->id->smem_valid = smem_validation;
+            thisAgent->symbolManager->side_data(sti).smem_valid = smem_validation;
             sti_created_here = true;
         }
     }
@@ -242,6 +242,7 @@ void production_param_container::print_settings(agent* thisAgent)
     outputManager->printa_sf(thisAgent, "                   %-[--timetags --wmes]\n");
     outputManager->printa_sf(thisAgent, "production matches %-[--names --count  ] [--assertions ]\n");
     outputManager->printa_sf(thisAgent, "                   %-[--timetags --wmes] [--retractions]\n");
+    outputManager->printa_sf(thisAgent, "production matches %---profile [on | off | reset | <count>]\n");
     outputManager->printa(thisAgent,    "------------------------------------------------------------------\n");
     outputManager->printa_sf(thisAgent, "production memory-usage   %-[options] [max] %-\n");
     outputManager->printa_sf(thisAgent, "production memory-usage   %-<production_name> %-\n");
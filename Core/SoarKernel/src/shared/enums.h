@@ -126,9 +126,15 @@ enum Decider_settings {
     DECIDER_WAIT_SNC,
     DECIDER_EXPLORATION_POLICY,
     DECIDER_AUTO_REDUCE,
+    DECIDER_MATCH_THREADS,
+    DECIDER_MATCH_BATCHING,
+    DECIDER_POOL_TRIM_INTERVAL,
+    DECIDER_HUGE_PAGES,
     num_decider_settings
 };
 
+enum Huge_page_modes { HUGE_PAGES_OFF, HUGE_PAGES_TRANSPARENT, HUGE_PAGES_EXPLICIT };
+
 enum Output_sysparams {
     OM_ECHO_COMMANDS,
     OM_AGENT_WRITES,
@@ -256,6 +262,7 @@ MP_instantiation,
 MP_chunk_cond,
 MP_preference,
 MP_wme,
+MP_wme_cold,
 MP_output_link,
 MP_io_wme,
 MP_slot,
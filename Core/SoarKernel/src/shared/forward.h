@@ -28,6 +28,7 @@ typedef struct pi_struct parent_inst;
 typedef struct preference_struct preference;
 typedef struct production_struct production;
 typedef struct rete_node_struct rete_node;
+typedef struct rete_hash_table_struct rete_hash_table;
 typedef struct rete_test_struct rete_test;
 typedef struct rhs_function_struct rhs_function;
 typedef struct saved_test_struct saved_test;
@@ -36,6 +37,7 @@ typedef struct slot_struct slot;
 typedef struct symbol_struct Symbol;
 typedef struct chunk_element_struct chunk_element;
 typedef struct test_struct test_info;
+typedef struct thread_memory_pools_struct thread_memory_pools;
 typedef struct trace_mode_info_struct trace_mode_info;
 
 typedef unsigned char byte;
@@ -55,6 +57,8 @@ class soar_timer;
 class Soar_Instance;
 class Memory_Manager;
 class Symbol_Manager;
+class Rete_Worker_Pool;
+class Rete_Profiler;
 
 class SoarDecider;
 class WM_Manager;
@@ -45,11 +45,18 @@
  * because of a sequence of dependent instantiation firings in the top state.
  * - This option was turned on in Soar 6 to 8.6 and turned off in 9.0 to 9.5.1b
  */
+/* RETE_TOKEN_BLOCKS: Store each bucket of the rete's token hash table as
+ * parallel arrays of (node, hash referent, token) instead of a linked list
+ * of tokens, so that right activations can scan for candidate tokens without
+ * touching each token's cache line.  See "Memory Hash Tables" in rete.cpp.
+ * Compare the two with "do_performance_test.sh -s tokens" in each build.
+ */
 /*  RETE stat tracking                     Note:  May be broken right now though bug might be superficial */
 
 #define BUG_139_WORKAROUND
 //#define BUG_139_WORKAROUND_WARNING
 //#define DO_TOP_LEVEL_COND_REF_CTS
+//#define RETE_TOKEN_BLOCKS
 //#define TOKEN_SHARING_STATS           /* get statistics on token counts with and without sharing */
 //#define SHARING_FACTORS               /* gather statistics on beta node sharing */
 //#define NULL_ACTIVATION_STATS         /* gather statistics on null activation */
@@ -484,6 +484,128 @@ void do_for_all_items_in_hash_bucket(struct hash_table_struct* ht,
         }
 }
 
+/* ====================================================================
+
+                 Open-Addressing Hash Table Routines
+
+   See mem.h.  Items live directly in ht->slots, with linear probing.
+   Since every slot keeps its item's full hash, resizing just moves the
+   slots into a new array.
+==================================================================== */
+
+struct open_hash_table_struct* make_open_hash_table(agent* thisAgent, short minimum_log2size,
+        full_hash_function h)
+{
+    open_hash_table* ht;
+
+    ht = static_cast<open_hash_table_struct*>(thisAgent->memoryManager->allocate_memory(sizeof(open_hash_table),
+                                              HASH_TABLE_MEM_USAGE));
+    if (minimum_log2size < 1)
+    {
+        minimum_log2size = 1;
+    }
+    ht->count = 0;
+    ht->size = static_cast<uint32_t>(1) << minimum_log2size;
+    ht->mask = ht->size - 1;
+    ht->minimum_size = ht->size;
+    ht->slots = static_cast<open_hash_slot*>(thisAgent->memoryManager->allocate_memory_and_zerofill(ht->size * sizeof(open_hash_slot),
+                HASH_TABLE_MEM_USAGE));
+    ht->h = h;
+    return ht;
+}
+
+void free_open_hash_table(agent* thisAgent, struct open_hash_table_struct* ht)
+{
+    thisAgent->memoryManager->free_memory(ht->slots, HASH_TABLE_MEM_USAGE);
+    thisAgent->memoryManager->free_memory(ht, HASH_TABLE_MEM_USAGE);
+}
+
+void resize_open_hash_table(agent* thisAgent, open_hash_table* ht, uint32_t new_size)
+{
+    open_hash_slot* new_slots;
+    uint32_t i, j, new_mask;
+
+    new_mask = new_size - 1;
+    new_slots = static_cast<open_hash_slot*>(thisAgent->memoryManager->allocate_memory_and_zerofill(new_size * sizeof(open_hash_slot),
+                HASH_TABLE_MEM_USAGE));
+
+    for (i = 0; i < ht->size; i++)
+    {
+        if (ht->slots[i].item)
+        {
+            for (j = ht->slots[i].hash & new_mask; new_slots[j].item; j = (j + 1) & new_mask);
+            new_slots[j] = ht->slots[i];
+        }
+    }
+
+    thisAgent->memoryManager->free_memory(ht->slots, HASH_TABLE_MEM_USAGE);
+    ht->slots = new_slots;
+    ht->size = new_size;
+    ht->mask = new_mask;
+}
+
+void add_to_open_hash_table(agent* thisAgent, struct open_hash_table_struct* ht, void* item)
+{
+    uint32_t hash_value, i;
+
+    ht->count++;
+    if (ht->count * 4 > static_cast<int64_t>(ht->size) * 3)
+    {
+        resize_open_hash_table(thisAgent, ht, ht->size * 2);
+    }
+    hash_value = (*(ht->h))(item);
+    for (i = hash_value & ht->mask; ht->slots[i].item; i = (i + 1) & ht->mask);
+    ht->slots[i].item = item;
+    ht->slots[i].hash = hash_value;
+}
+
+void remove_from_open_hash_table(agent* thisAgent, struct open_hash_table_struct* ht, void* item)
+{
+    uint32_t i, j, home;
+
+    for (i = (*(ht->h))(item) & ht->mask; ht->slots[i].item != item; i = (i + 1) & ht->mask)
+    {
+        if (!ht->slots[i].item)
+        {
+            /* Reaching here means that we couldn't find the item */
+            assert(false && "Couldn't find item to remove from open hash table!");
+            return;
+        }
+    }
+
+    /* --- close the gap:  move back any later item in the same run that
+       can't be reached from its home slot once slot i is emptied --- */
+    for (j = (i + 1) & ht->mask; ht->slots[j].item; j = (j + 1) & ht->mask)
+    {
+        home = ht->slots[j].hash & ht->mask;
+        if ((i < j) ? ((home <= i) || (home > j)) : ((home <= i) && (home > j)))
+        {
+            ht->slots[i] = ht->slots[j];
+            i = j;
+        }
+    }
+    ht->slots[i].item = NIL;
+
+    /* --- update count and possibly resize the table --- */
+    ht->count--;
+    if ((ht->count * 8 < static_cast<int64_t>(ht->size)) && (ht->size > ht->minimum_size))
+    {
+        resize_open_hash_table(thisAgent, ht, ht->size / 2);
+    }
+}
+
+void do_for_all_items_in_open_hash_table(agent* thisAgent, struct open_hash_table_struct* ht,
+        hash_table_callback_fn2 f, void* userdata)
+{
+    uint32_t i;
+
+    for (i = 0; i < ht->size; i++)
+        if (ht->slots[i].item && (*f)(thisAgent, ht->slots[i].item, userdata))
+        {
+            return;
+        }
+}
+
 /* ====================================================================
 
                        Module Initialization
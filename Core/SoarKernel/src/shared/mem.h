@@ -146,6 +146,36 @@ extern void do_for_all_items_in_hash_bucket(struct hash_table_struct* ht,
         hash_table_callback_fn f,
         uint32_t hash_value);
 
+/* -------------------------------------- */
+/* Open-addressing hash table routines */
+/* -------------------------------------- */
+
+typedef uint32_t ((*full_hash_function)(void* item));
+
+typedef struct open_hash_slot_struct
+{
+    void* item;               /* NIL if the slot is empty */
+    uint32_t hash;            /* full hash value of item */
+} open_hash_slot;
+
+typedef struct open_hash_table_struct
+{
+    int64_t count;            /* number of items in the table */
+    uint32_t size;            /* number of slots, a power of two */
+    uint32_t mask;            /* size - 1 */
+    uint32_t minimum_size;    /* table never shrinks below this size */
+    open_hash_slot* slots;
+    full_hash_function h;     /* call this to hash an item being added/removed */
+} open_hash_table;
+
+extern struct open_hash_table_struct* make_open_hash_table(agent* thisAgent, short minimum_log2size,
+        full_hash_function h);
+extern void free_open_hash_table(agent* thisAgent, struct open_hash_table_struct* ht);
+extern void add_to_open_hash_table(agent* thisAgent, struct open_hash_table_struct* ht, void* item);
+extern void remove_from_open_hash_table(agent* thisAgent, struct open_hash_table_struct* ht, void* item);
+extern void do_for_all_items_in_open_hash_table(agent* thisAgent, struct open_hash_table_struct* ht,
+        hash_table_callback_fn2 f, void* userdata);
+
 #endif
 
 /* ======================================================================
@@ -265,5 +295,18 @@ extern void do_for_all_items_in_hash_bucket(struct hash_table_struct* ht,
      normally return false.  If the callback function ever returns true,
      iteration over the hash table items stops and the do_for_xxx()
      routine returns immediately.
+
+   Open-addressing hash table routines:
+
+     For tables that are mostly looked up, such as the symbol tables,
+     open_hash_table keeps the items in one array of slots, probed
+     linearly from the slot picked by the low bits of the item's hash.
+     Each slot also holds the item's full 32-bit hash, so a lookup only
+     compares items whose hashes match, and growing the table never calls
+     the hash function.  The hash function must mix well into the low
+     bits.  Callers look items up by walking the slots themselves, from
+     (hash & mask) until an empty slot.  The table grows when it is 3/4
+     full and shrinks when it is less than 1/8 full; removal shifts later
+     items back instead of leaving tombstones.
 ====================================================================== */
 
@@ -7,6 +7,7 @@
 #include "sml_Names.h"
 #include "stats.h"
 
+#include <algorithm>
 #include <iostream>
 #include <stdlib.h>
 
@@ -39,18 +40,46 @@
    number, must be prime */
 #define DEFAULT_BLOCK_SIZE 0x7FF0   /* about 32K bytes per block */
 
+/* --- every memory manager in the process, for get_process_memory_statistics() --- */
+struct memory_manager_registry
+{
+    std::mutex                      mutex;
+    std::vector<Memory_Manager*>    managers;
+};
+
+static memory_manager_registry& get_memory_manager_registry()
+{
+    static memory_manager_registry registry;
+    return registry;
+}
+
 Memory_Manager::Memory_Manager()
 {
     memory_for_usage_overhead = memory_for_usage + STATS_OVERHEAD_MEM_USAGE;
+    memory_pools_in_use = NIL;
+    memory_limit = 0;
+    memory_limit_hit = false;
+    huge_pages = HUGE_PAGES_OFF;
+    page_arena = NIL;
 
     for (int i = 0; i < NUM_MEM_USAGE_CODES; i++)
     {
         memory_for_usage[i] = 0;
     }
+
+    memory_manager_registry& registry = get_memory_manager_registry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    registry.managers.push_back(this);
 }
 
 Memory_Manager::~Memory_Manager()
 {
+    {
+        memory_manager_registry& registry = get_memory_manager_registry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        registry.managers.erase(std::remove(registry.managers.begin(), registry.managers.end(), this), registry.managers.end());
+    }
+
     /* Releasing memory pools */
     memory_pool* cur_pool = memory_pools_in_use;
     memory_pool* next_pool;
@@ -62,11 +91,19 @@ Memory_Manager::~Memory_Manager()
     }
 
     // dynamic memory pools (cleared in the last step)
-    for (std::unordered_map< size_t, memory_pool* >::iterator it = dyn_memory_pools.begin(); it != dyn_memory_pools.end(); it++)
+    for (size_t i = 0; i < dyn_memory_pools.size(); i++)
     {
-        delete it->second;
+        delete dyn_memory_pools[i];
     }
     dyn_memory_pools.clear();
+    for (size_t i = 0; i < thread_pool_sets.size(); i++)
+    {
+        delete thread_pool_sets[i];
+    }
+    thread_pool_sets.clear();
+    retired_thread_pool_sets.clear();
+
+    delete page_arena;
 }
 
 void Memory_Manager::init_memory_pool_by_ptr(memory_pool* pThisPool, size_t item_size, const char* name)
@@ -115,26 +152,119 @@ void Memory_Manager::init_memory_pool(MemoryPoolType mempool_index, size_t item_
     lThisPool->index = mempool_index;
 }
 
+/* ----------------------------------------------------------------------
+   Dynamic pools serve the STL allocators in mempool_allocator.h, which
+   ask the process-wide MPM for a pool on every allocation and free.
+   Each thread has its own set of dynamic pools, so allocating and
+   freeing take no lock; the mutex is only taken to make a pool or add
+   a block to one.  An item freed on a thread other than the one that
+   allocated it simply joins the freeing thread's pool of that size.
+
+   Since items wander between threads like that, blocks are never given
+   back when a thread ends.  Its set of pools is retired instead, to be
+   adopted by the next thread that needs one, and the blocks are freed
+   along with the MPM.
+---------------------------------------------------------------------- */
+
+#define THREAD_POOL_DIRECT_SIZES 257    /* item sizes looked up by index */
+
+struct thread_memory_pools_struct
+{
+    memory_pool*                                by_size[THREAD_POOL_DIRECT_SIZES];
+    std::unordered_map< size_t, memory_pool* >  larger;
+
+    thread_memory_pools_struct()
+    {
+        for (size_t i = 0; i < THREAD_POOL_DIRECT_SIZES; i++)
+        {
+            by_size[i] = NIL;
+        }
+    }
+};
+
+static thread_local thread_memory_pools* tl_memory_pools = NIL;
+static thread_local bool tl_memory_pools_retired = false;
+
+struct thread_memory_pools_guard
+{
+    ~thread_memory_pools_guard()
+    {
+        if (tl_memory_pools)
+        {
+            Memory_Manager::Get_MPM().retire_thread_memory_pools(tl_memory_pools);
+            tl_memory_pools = NIL;
+        }
+        tl_memory_pools_retired = true;
+    }
+};
+
 memory_pool* Memory_Manager::get_memory_pool(size_t size)
 {
-    memory_pool* return_val = NULL;
+    thread_memory_pools* lPools = tl_memory_pools;
+
+    if (!lPools)
+    {
+        lPools = tl_memory_pools = adopt_thread_memory_pools();
 
-    std::unordered_map< size_t, memory_pool* >::iterator it = dyn_memory_pools.find(size);
-    if (it == dyn_memory_pools.end())
+        /* --- a thread still allocating while its thread-locals are torn
+           down keeps the set it adopts then until the MPM is freed --- */
+        if (!tl_memory_pools_retired)
+        {
+            static thread_local thread_memory_pools_guard guard;
+            (void) guard;
+        }
+    }
+
+    if (size < THREAD_POOL_DIRECT_SIZES)
     {
-        memory_pool* newbie = new memory_pool;
+        memory_pool* lPool = lPools->by_size[size];
+        return lPool ? lPool : make_thread_memory_pool(lPools, size);
+    }
 
-        init_memory_pool_by_ptr(newbie, size, "dynamic");
-        dyn_memory_pools.insert(std::make_pair(size, newbie));
+    std::unordered_map< size_t, memory_pool* >::iterator it = lPools->larger.find(size);
+    return (it != lPools->larger.end()) ? it->second : make_thread_memory_pool(lPools, size);
+}
+
+thread_memory_pools* Memory_Manager::adopt_thread_memory_pools()
+{
+    std::lock_guard<std::mutex> lock(dyn_memory_pools_mutex);
+    thread_memory_pools* lPools;
 
-        return_val = newbie;
+    if (!retired_thread_pool_sets.empty())
+    {
+        lPools = retired_thread_pool_sets.back();
+        retired_thread_pool_sets.pop_back();
     }
     else
     {
-        return_val = it->second;
+        lPools = new thread_memory_pools;
+        thread_pool_sets.push_back(lPools);
     }
+    return lPools;
+}
 
-    return return_val;
+void Memory_Manager::retire_thread_memory_pools(thread_memory_pools* pPools)
+{
+    std::lock_guard<std::mutex> lock(dyn_memory_pools_mutex);
+    retired_thread_pool_sets.push_back(pPools);
+}
+
+memory_pool* Memory_Manager::make_thread_memory_pool(thread_memory_pools* pPools, size_t size)
+{
+    memory_pool* newbie = new memory_pool;
+    std::lock_guard<std::mutex> lock(dyn_memory_pools_mutex);
+
+    init_memory_pool_by_ptr(newbie, size, "dynamic");
+    dyn_memory_pools.push_back(newbie);
+    if (size < THREAD_POOL_DIRECT_SIZES)
+    {
+        pPools->by_size[size] = newbie;
+    }
+    else
+    {
+        pPools->larger[size] = newbie;
+    }
+    return newbie;
 }
 
 void Memory_Manager::free_memory_pool_by_ptr(memory_pool* pThisPool)
@@ -147,7 +277,7 @@ void Memory_Manager::free_memory_pool_by_ptr(memory_pool* pThisPool)
         //std::cout << "Free memory block for " << pThisPool->name << std::endl;
         // the first 4 bytes point to the next block
         next_block = *(char**)cur_block;
-        free_memory(cur_block, POOL_MEM_USAGE);
+        free_block(cur_block);
         cur_block = next_block;
     }
     pThisPool->num_blocks = 0;
@@ -184,6 +314,20 @@ bool Memory_Manager::add_block_to_memory_pool_by_name(const std::string& pool_na
 }
 
 void Memory_Manager::add_block_to_memory_pool(memory_pool* pThisPool)
+{
+    if (pThisPool->index == num_memory_pools)
+    {
+        /* --- a dynamic pool:  other threads may be adding blocks to theirs --- */
+        std::lock_guard<std::mutex> lock(dyn_memory_pools_mutex);
+        add_block(pThisPool);
+    }
+    else
+    {
+        add_block(pThisPool);
+    }
+}
+
+void Memory_Manager::add_block(memory_pool* pThisPool)
 {
     char* new_block;
     size_t size, i, item_num, interleave_factor;
@@ -192,30 +336,18 @@ void Memory_Manager::add_block_to_memory_pool(memory_pool* pThisPool)
 
     /* --- allocate a new block for the pool --- */
     size = pThisPool->item_size * pThisPool->items_per_block + sizeof(char*);
-    new_block = static_cast<char*>(allocate_memory(size, POOL_MEM_USAGE));
+    new_block = allocate_block(pThisPool, size);
     *(char**)new_block = static_cast<char*>(pThisPool->first_block);
     pThisPool->first_block = new_block;
     pThisPool->num_blocks++;
 
-    /* somewhere in here, need to check if total mem usage exceeds limit set by user
-we only check when increasing pools, because the other memories are small by comparison,
-we shouldn't check for every block added to any pool, since that is unduly expensive
-can we keep a block counter on the agent and check it modulo some function of the limit?
-     */
-    /*
-uint64_t total = 0;
-for (i=0; i<NUM_MEM_USAGE_CODES; i++) total += memory_for_usage[i];
-
-if (total > thisAgent->Decider->settings[DECIDER_MAX_MEMORY_USAGE]) {
-soar_invoke_callbacks(thisAgent, thisAgent,
-MAX_MEMORY_USAGE_CALLBACK,
-(soar_call_data) NULL);
-print (thisAgent, "%8lu bytes total memory allocated\n", total);
-print (thisAgent, "exceeds total allowed for Soar: %8lu bytes \n",
-thisAgent->Decider->settings[DECIDER_MAX_MEMORY_USAGE]);
-}
-
-     */
+    /* --- we only check the limit when a pool grows, since the other
+       memories are small by comparison; the agent itself halts at the end
+       of the phase (see memory_limit_exceeded()) --- */
+    if (memory_limit && (get_total_memory() > memory_limit))
+    {
+        memory_limit_hit = true;
+    }
 
     /* --- link up the new entries onto the free list --- */
     interleave_factor = DEFAULT_INTERLEAVE_FACTOR;
@@ -242,6 +374,198 @@ thisAgent->Decider->settings[DECIDER_MAX_MEMORY_USAGE]);
 
 }
 
+/* ----------------------------------------------------------------------
+   Blocks of the fixed pools come from the page arena while huge pages
+   are on.  Dynamic pools keep using malloc, since other threads add
+   blocks to those of the process-wide MPM.  An arena chunk is counted
+   whole as pool memory; it has no size header.
+---------------------------------------------------------------------- */
+
+char* Memory_Manager::allocate_block(memory_pool* pThisPool, size_t size)
+{
+    if ((huge_pages != HUGE_PAGES_OFF) && (pThisPool->index != num_memory_pools) && (size <= PAGE_ARENA_CHUNK_SIZE))
+    {
+        if (!page_arena)
+        {
+            page_arena = new Page_Arena();
+        }
+        char* block = static_cast<char*>(page_arena->allocate_chunk(huge_pages));
+        if (block)
+        {
+            memory_for_usage[POOL_MEM_USAGE] += PAGE_ARENA_CHUNK_SIZE;
+            return block;
+        }
+    }
+    return static_cast<char*>(allocate_memory(size, POOL_MEM_USAGE));
+}
+
+void Memory_Manager::free_block(char* pBlock)
+{
+    if (page_arena && page_arena->owns(pBlock))
+    {
+        fill_with_garbage(pBlock, PAGE_ARENA_CHUNK_SIZE);
+        memory_for_usage[POOL_MEM_USAGE] -= PAGE_ARENA_CHUNK_SIZE;
+        page_arena->free_chunk(pBlock);
+    }
+    else
+    {
+        free_memory(pBlock, POOL_MEM_USAGE);
+    }
+}
+
+/* --- bytes of pool blocks taken from huge-page regions, and how many
+   bytes of those regions the system actually backs with huge pages --- */
+void Memory_Manager::get_huge_page_coverage(size_t& pArenaBytes, size_t& pHugePageBytes)
+{
+    pArenaBytes = 0;
+    pHugePageBytes = 0;
+    if (page_arena)
+    {
+        pArenaBytes = page_arena->get_used_bytes();
+        pHugePageBytes = page_arena->get_huge_page_bytes();
+    }
+}
+
+/* ====================================================================
+
+                      Returning Free Pool Blocks
+
+   Pools only ever grow while the agent runs, so after a spike (a deep
+   lookahead, say) they keep their peak size.  Trim_memory_pools() gives
+   back every block none of whose items is in use.  Rather than keeping
+   live counts per block on every allocation and free, it counts each
+   block's free items by walking the free list, which costs nothing
+   until a trim is asked for.  Init-soar trims, as does the decision
+   cycle every "soar pool-trim-interval" decisions.
+
+   Dynamic pools are skipped:  other threads allocate from those of the
+   process-wide MPM without a lock.  Blocks from the page arena go back
+   to the arena, not to the system.
+==================================================================== */
+
+size_t Memory_Manager::trim_memory_pools()
+{
+    size_t released = 0;
+
+    for (memory_pool* p = memory_pools_in_use; p != NIL; p = p->next)
+    {
+        if (p->index != num_memory_pools)
+        {
+            released += trim_memory_pool(p);
+        }
+    }
+    return released;
+}
+
+size_t Memory_Manager::trim_memory_pool(memory_pool* pThisPool)
+{
+    std::vector<char*> blocks;
+    std::vector<size_t> free_counts;
+    size_t block_size = pThisPool->item_size * pThisPool->items_per_block + sizeof(char*);
+    size_t num_free_blocks = 0;
+    char* block, *prev_block, *next_block;
+    void* item, *prev_item, *next_item;
+
+    if (!pThisPool->free_list)
+    {
+        return 0;
+    }
+
+    for (block = static_cast<char*>(pThisPool->first_block); block != NIL; block = *(char**)block)
+    {
+        blocks.push_back(block);
+    }
+    std::sort(blocks.begin(), blocks.end());
+    free_counts.assign(blocks.size(), 0);
+
+    /* --- the block holding an item is the last one starting below it --- */
+    auto block_index = [&blocks](void* pItem) -> size_t
+    {
+        return (std::upper_bound(blocks.begin(), blocks.end(), static_cast<char*>(pItem)) - blocks.begin()) - 1;
+    };
+
+    for (item = pThisPool->free_list; item != NIL; item = *(void**)item)
+    {
+        if (++free_counts[block_index(item)] == pThisPool->items_per_block)
+        {
+            num_free_blocks++;
+        }
+    }
+    if (!num_free_blocks)
+    {
+        return 0;
+    }
+
+    /* --- unlink the items of the wholly free blocks, then the blocks --- */
+    prev_item = NIL;
+    for (item = pThisPool->free_list; item != NIL; item = next_item)
+    {
+        next_item = *(void**)item;
+        if (free_counts[block_index(item)] == pThisPool->items_per_block)
+        {
+            if (prev_item)
+            {
+                *(void**)prev_item = next_item;
+            }
+            else
+            {
+                pThisPool->free_list = next_item;
+            }
+        }
+        else
+        {
+            prev_item = item;
+        }
+    }
+
+    prev_block = NIL;
+    for (block = static_cast<char*>(pThisPool->first_block); block != NIL; block = next_block)
+    {
+        next_block = *(char**)block;
+        if (free_counts[block_index(block)] == pThisPool->items_per_block)
+        {
+            if (prev_block)
+            {
+                *(char**)prev_block = next_block;
+            }
+            else
+            {
+                pThisPool->first_block = next_block;
+            }
+            free_block(block);
+            pThisPool->num_blocks--;
+        }
+        else
+        {
+            prev_block = block;
+        }
+    }
+
+    return num_free_blocks * block_size;
+}
+
+size_t Memory_Manager::get_total_memory()
+{
+    size_t total = 0;
+
+    for (int i = 0; i < NUM_MEM_USAGE_CODES; i++)
+    {
+        total += memory_for_usage[i];
+    }
+    return total;
+}
+
+/* --- true while the memory limit is exceeded; only re-measured once a
+   growing pool has gone past it --- */
+bool Memory_Manager::memory_limit_exceeded()
+{
+    if (memory_limit_hit)
+    {
+        memory_limit_hit = memory_limit && (get_total_memory() > memory_limit);
+    }
+    return memory_limit_hit;
+}
+
 /* ====================================================================
 
                    Basic Memory Allocation Utilities
@@ -328,6 +652,57 @@ void Memory_Manager::print_memory_statistics()
     }
 }
 
+/* ----------------------------------------------------------------------
+   Adds up the usage figures of every memory manager in the process and
+   merges their pools by name and item size.  The figures of an agent
+   that is running on another thread are only approximate, since its
+   counters are read without stopping it.
+---------------------------------------------------------------------- */
+
+void Memory_Manager::get_process_memory_statistics(size_t pUsage[NUM_MEM_USAGE_CODES], std::vector<memory_pool>& pPools)
+{
+    memory_manager_registry& registry = get_memory_manager_registry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    size_t i;
+
+    for (i = 0; i < NUM_MEM_USAGE_CODES; i++)
+    {
+        pUsage[i] = 0;
+    }
+    pPools.clear();
+
+    for (std::vector<Memory_Manager*>::iterator it = registry.managers.begin(); it != registry.managers.end(); ++it)
+    {
+        Memory_Manager* lManager = *it;
+        std::lock_guard<std::mutex> pools_lock(lManager->dyn_memory_pools_mutex);
+
+        for (i = 0; i < NUM_MEM_USAGE_CODES; i++)
+        {
+            pUsage[i] += lManager->memory_for_usage[i];
+        }
+        for (memory_pool* p = lManager->memory_pools_in_use; p != NIL; p = p->next)
+        {
+            for (i = 0; i < pPools.size(); i++)
+            {
+                if ((pPools[i].item_size == p->item_size) && !strcmp(pPools[i].name, p->name))
+                {
+                    break;
+                }
+            }
+            if (i == pPools.size())
+            {
+                pPools.push_back(*p);
+                pPools[i].next = NIL;
+            }
+            else
+            {
+                pPools[i].num_blocks += p->num_blocks;
+                pPools[i].used_count += p->used_count;
+            }
+        }
+    }
+}
+
 void Memory_Manager::debug_print_memory_stats(agent* thisAgent)
 {
     // Hostname
@@ -10,19 +10,36 @@
  * A memory manager class that decouples memory pools from the individual
  * agent.
  *
- * - MPM is a singleton like the OutputManager and SoarInstance.  It
- *   is created on Kernel creation.
+ * - Every agent owns a Memory_Manager, created with the agent and
+ *   destroyed with it, so agents running on different threads never
+ *   touch the same free lists and need no locking.
+ *
+ * - There is also one process-wide MPM, a singleton like the
+ *   OutputManager and SoarInstance, created on Kernel creation.  It
+ *   holds the dynamic pools used by the STL allocators in
+ *   mempool_allocator.h, which don't know their agent.  Those pools
+ *   are per thread; see get_memory_pool().
  *
  * - MPM uses an enum list for all the core memory pool types.  Kernel
  *   calls that deal with memory pools now pass in a parameter to
  *   specify which pool instead of the actual pool itself (which was
  *   in the agent, but is now in the MPM)
  *
- * - Memory pools now have an initialized flag, since more than one
- *   agent may try to initialize a pool.
+ * - Memory pools have an initialized flag, so initializing a pool
+ *   twice is harmless.
+ *
+ * - Agent caches a pointer to its MPM to ease access.
+ *
+ * - Trim_memory_pools() gives blocks whose items are all free back to
+ *   the system, and a memory limit ("soar max-memory-usage") halts the
+ *   agent once its pools grow past it.
  *
- * - Agent caches a pointer to MPM to ease access.  Also made
- *   refactoring slightly less painful.
+ * - With "soar huge-pages" on, the blocks of the agent's pools come
+ *   from a Page_Arena of huge-page regions local to the agent's NUMA
+ *   node instead of from malloc; see page_arena.h.
+ *
+ * - Get_process_memory_statistics() adds up the figures of every
+ *   memory manager in the process, for "stats --memory --process".
  *
  * =======================================================================
  */
@@ -31,8 +48,12 @@
 #define MEMPOOL_MANAGER_H_
 
 #include "kernel.h"
+#include "Export.h"
+#include "page_arena.h"
 
+#include <mutex>
 #include <unordered_map>
+#include <vector>
 
 #ifndef _WIN32
 #include <stdlib.h> // malloc
@@ -113,7 +134,7 @@ inline void decrement_used_count(P p)
 
 #endif /* MEMORY_POOL_STATS */
 
-class Memory_Manager
+class EXPORT Memory_Manager
 {
         /* CLI is a friend because it prints out mempool stats */
         friend class cli::CommandLineInterface;
@@ -124,6 +145,7 @@ class Memory_Manager
             static Memory_Manager instance;
             return instance;
         }
+        Memory_Manager();
         virtual ~Memory_Manager();
 
         void init_memory_pool(MemoryPoolType mempool_index, size_t item_size, const char* name);
@@ -134,20 +156,29 @@ class Memory_Manager
         bool add_block_to_memory_pool_by_name(const std::string& pool_name, int blocks);
 
         memory_pool* get_memory_pool(size_t size);
+        void retire_thread_memory_pools(thread_memory_pools* pPools);
         void* allocate_memory(size_t size, int usage_code);
         void* allocate_memory_and_zerofill(size_t size, int usage_code);
         void free_memory(void* mem, int usage_code);
 
+        size_t trim_memory_pools();
+        size_t get_total_memory();
+        void set_memory_limit(size_t pLimit) { memory_limit = pLimit; memory_limit_hit = false; }
+        size_t get_memory_limit() { return memory_limit; }
+        bool memory_limit_exceeded();
+
+        void set_huge_pages(Huge_page_modes pMode) { huge_pages = pMode; }
+        Huge_page_modes get_huge_pages() { return huge_pages; }
+        void get_huge_page_coverage(size_t& pArenaBytes, size_t& pHugePageBytes);
+
         void print_memory_statistics();
         void debug_print_memory_stats(agent* thisAgent);
 
-        std::unordered_map< size_t, memory_pool* >   dyn_memory_pools;
+        static void get_process_memory_statistics(size_t pUsage[NUM_MEM_USAGE_CODES], std::vector<memory_pool>& pPools);
 
     private:
 
-        Memory_Manager();
-
-        /* The following two functions are declared but not implemented to avoid copies of singletons */
+        /* The following two functions are declared but not implemented to avoid copies */
         Memory_Manager(Memory_Manager const&) {};
         void operator=(Memory_Manager const&) {};
 
@@ -155,8 +186,26 @@ class Memory_Manager
         size_t              memory_for_usage[NUM_MEM_USAGE_CODES];
         memory_pool*        memory_pools_in_use;
         size_t*             memory_for_usage_overhead;
+        size_t              memory_limit;       /* 0 for none; checked as pools grow */
+        bool                memory_limit_hit;
+        Huge_page_modes     huge_pages;
+        Page_Arena*         page_arena;         /* NIL until a block comes from it */
+
+        /* --- per-thread dynamic pools; guarded by dyn_memory_pools_mutex,
+           which also guards memory_pools_in_use and memory_for_usage while
+           threads add dynamic pools and blocks to them --- */
+        std::mutex                          dyn_memory_pools_mutex;
+        std::vector<memory_pool*>           dyn_memory_pools;
+        std::vector<thread_memory_pools*>   thread_pool_sets;
+        std::vector<thread_memory_pools*>   retired_thread_pool_sets;
 
         void free_memory_pool_by_ptr(memory_pool* pThisPool);
+        void add_block(memory_pool* pThisPool);
+        char* allocate_block(memory_pool* pThisPool, size_t size);
+        void free_block(char* pBlock);
+        size_t trim_memory_pool(memory_pool* pThisPool);
+        thread_memory_pools* adopt_thread_memory_pools();
+        memory_pool* make_thread_memory_pool(thread_memory_pools* pPools, size_t size);
 
     public:
         template <typename T>
@@ -52,56 +52,53 @@ namespace soar_module
             typedef const T&    const_reference;
 
         public:
-            soar_memory_pool_allocator() : mem_pool(NULL), memory_manager(NULL)
+            soar_memory_pool_allocator() : memory_manager(NULL)
         {
                 memory_manager = &(Memory_Manager::Get_MPM());
-                mem_pool = memory_manager->get_memory_pool(sizeof(value_type));
         }
 
-            soar_memory_pool_allocator(agent* new_agent): mem_pool(NULL), memory_manager(NULL)
+            soar_memory_pool_allocator(agent* new_agent): memory_manager(NULL)
             {
                 // useful for debugging
                 // std::string temp_this( typeid( value_type ).name() );
                 memory_manager = &(Memory_Manager::Get_MPM());
-                mem_pool = memory_manager->get_memory_pool(sizeof(value_type));
             }
 
-            soar_memory_pool_allocator(const soar_memory_pool_allocator& obj): mem_pool(NULL), memory_manager(NULL)
+            soar_memory_pool_allocator(const soar_memory_pool_allocator& obj): memory_manager(NULL)
             {
                 // useful for debugging
                 // std::string temp_this( typeid( value_type ).name() );
                 memory_manager = &(Memory_Manager::Get_MPM());
-                mem_pool = memory_manager->get_memory_pool(sizeof(value_type));
             }
 
             template <class _other>
-            soar_memory_pool_allocator(const soar_memory_pool_allocator<_other>& other): mem_pool(NULL), memory_manager(NULL)
+            soar_memory_pool_allocator(const soar_memory_pool_allocator<_other>& other): memory_manager(NULL)
             {
                     // useful for debugging
                     // std::string temp_this( typeid( T ).name() );
                     // std::string temp_other( typeid( _other ).name() );
                     memory_manager = &(Memory_Manager::Get_MPM());
-                    mem_pool = memory_manager->get_memory_pool(sizeof(value_type));
-            }
+                }
 
+            /* --- the pool is looked up on every call, since the MPM gives
+               each thread its own dynamic pools --- */
             pointer allocate(size_type n, const void* = 0)
             {
                 //assert(memory_manager);
                 //assert (n==1);
                 pointer t;
-                //assert(mem_pool);
-                memory_manager->allocate_with_pool_ptr(mem_pool, &t);
+                memory_manager->allocate_with_pool_ptr(memory_manager->get_memory_pool(sizeof(value_type)), &t);
                 // assert(t);
                 return t;
             }
 
             void deallocate(void* p, size_type n)
             {
-                //assert(memory_manager && mem_pool);
+                //assert(memory_manager);
                 if (p)
                 {
                     //assert (n==1);
-                    memory_manager->free_with_pool_ptr(mem_pool, p);
+                    memory_manager->free_with_pool_ptr(memory_manager->get_memory_pool(sizeof(value_type)), p);
                 }
             }
 
@@ -140,7 +137,6 @@ namespace soar_module
         private:
             //            agent* thisAgent;
             Memory_Manager* memory_manager;
-            memory_pool* mem_pool;
 
     };
 
@@ -159,51 +155,41 @@ namespace soar_module
             typedef const T&    const_reference;
 
         public:
-            soar_memory_pool_allocator_n() : mem_pool(NULL), memory_manager(NULL)
+            soar_memory_pool_allocator_n() : memory_manager(NULL)
         {
                 memory_manager = &(Memory_Manager::Get_MPM());
-                mem_pool = memory_manager->get_memory_pool(sizeof(value_type));
         }
 
-            soar_memory_pool_allocator_n(agent* new_agent): mem_pool(NULL), memory_manager(NULL)
+            soar_memory_pool_allocator_n(agent* new_agent): memory_manager(NULL)
             {
                 // useful for debugging
                 // std::string temp_this( typeid( value_type ).name() );
                 memory_manager = &(Memory_Manager::Get_MPM());
-                mem_pool = memory_manager->get_memory_pool(sizeof(value_type));
             }
 
-            soar_memory_pool_allocator_n(const soar_memory_pool_allocator_n& obj): mem_pool(NULL), memory_manager(NULL)
+            soar_memory_pool_allocator_n(const soar_memory_pool_allocator_n& obj): memory_manager(NULL)
             {
                 // useful for debugging
                 // std::string temp_this( typeid( value_type ).name() );
                 memory_manager = &(Memory_Manager::Get_MPM());
-                mem_pool = memory_manager->get_memory_pool(sizeof(value_type));
             }
 
             template <class _other>
-            soar_memory_pool_allocator_n(const soar_memory_pool_allocator_n<_other>& other): mem_pool(NULL), memory_manager(NULL)
+            soar_memory_pool_allocator_n(const soar_memory_pool_allocator_n<_other>& other): memory_manager(NULL)
             {
                     // useful for debugging
                     // std::string temp_this( typeid( T ).name() );
                     // std::string temp_other( typeid( _other ).name() );
                     memory_manager = &(Memory_Manager::Get_MPM());
-                    mem_pool = memory_manager->get_memory_pool(sizeof(value_type));
-            }
+                }
 
             pointer allocate(size_type n, const void* = 0)
             {
                 //assert(memory_manager);
                 pointer t;
-                if (n == 1)
-                {
-                    //assert(mem_pool);
-                    memory_manager->allocate_with_pool_ptr(mem_pool, &t);
-                } else {
-                    memory_pool* lMem_pool = memory_manager->get_memory_pool(n*sizeof(value_type));
-                    //assert(lMem_pool);
-                    memory_manager->allocate_with_pool_ptr(lMem_pool, &t);
-                }
+                memory_pool* lMem_pool = memory_manager->get_memory_pool(n*sizeof(value_type));
+                //assert(lMem_pool);
+                memory_manager->allocate_with_pool_ptr(lMem_pool, &t);
                 //std::cout << "Dynamic memory pool allocation of size " << n << " * " << sizeof(value_type) << " requested!" << std::endl;
                 //assert(t);
                 return t;
@@ -211,17 +197,12 @@ namespace soar_module
 
             void deallocate(void* p, size_type n)
             {
-                //assert(memory_manager && mem_pool);
+                //assert(memory_manager);
                 if (p)
                 {
-                    if (n == 1)
-                    {
-                        memory_manager->free_with_pool_ptr(mem_pool, p);
-                    } else {
-                        memory_pool* lMem_pool = memory_manager->get_memory_pool(n*sizeof(value_type));
-                        //assert(lMem_pool);
-                        memory_manager->free_with_pool_ptr(lMem_pool, p);
-                    }
+                    memory_pool* lMem_pool = memory_manager->get_memory_pool(n*sizeof(value_type));
+                    //assert(lMem_pool);
+                    memory_manager->free_with_pool_ptr(lMem_pool, p);
                 }
             }
 
@@ -260,7 +241,6 @@ namespace soar_module
         private:
             //            agent* thisAgent;
             Memory_Manager* memory_manager;
-            memory_pool* mem_pool;
 
     };
     template<class T> bool operator==(const soar_memory_pool_allocator_n<T>&, const soar_memory_pool_allocator_n<T>&) { return true; }
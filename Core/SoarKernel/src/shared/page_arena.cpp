@@ -0,0 +1,216 @@
+/*************************************************************************
+ * PLEASE SEE THE FILE "license.txt" (INCLUDED WITH THIS SOFTWARE PACKAGE)
+ * FOR LICENSE AND COPYRIGHT INFORMATION.
+ *************************************************************************/
+
+/*************************************************************************
+ *
+ *  file:  page_arena.cpp
+ *
+ * =======================================================================
+ *  Huge-page regions backing memory pool blocks.  See page_arena.h.
+ * =======================================================================
+ */
+
+#include "page_arena.h"
+
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#ifdef __linux__
+#include <sys/syscall.h>
+#include <fstream>
+#include <string>
+#include <stdio.h>
+#endif
+
+#if defined(__linux__) && defined(SYS_getcpu) && defined(SYS_mbind)
+#define PAGE_ARENA_MBIND
+#define PAGE_ARENA_MPOL_PREFERRED   1
+#define PAGE_ARENA_MAX_NODES        256
+#endif
+
+Page_Arena::Page_Arena()
+{
+    mapped_bytes = 0;
+    used_bytes = 0;
+}
+
+Page_Arena::~Page_Arena()
+{
+#ifndef _WIN32
+    for (size_t i = 0; i < regions.size(); i++)
+    {
+        munmap(regions[i].base, PAGE_ARENA_REGION_SIZE);
+    }
+#endif
+}
+
+void* Page_Arena::allocate_chunk(Huge_page_modes pMode)
+{
+    void* chunk;
+
+    if (!free_chunks.empty())
+    {
+        chunk = free_chunks.back();
+        free_chunks.pop_back();
+        used_bytes += PAGE_ARENA_CHUNK_SIZE;
+        return chunk;
+    }
+    if ((regions.empty() || (regions.back().used == PAGE_ARENA_REGION_SIZE)) && !map_region(pMode))
+    {
+        return NIL;
+    }
+    chunk = regions.back().base + regions.back().used;
+    regions.back().used += PAGE_ARENA_CHUNK_SIZE;
+    used_bytes += PAGE_ARENA_CHUNK_SIZE;
+    return chunk;
+}
+
+bool Page_Arena::owns(void* pBlock)
+{
+    char* block = static_cast<char*>(pBlock);
+
+    for (size_t i = 0; i < regions.size(); i++)
+    {
+        if ((block >= regions[i].base) && (block < regions[i].base + PAGE_ARENA_REGION_SIZE))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+/* --- asks the kernel to place a region on the NUMA node of the calling
+   thread; only a preference, and failures (no NUMA support) are harmless --- */
+static void bind_to_local_node(char* pBase, size_t pSize)
+{
+#ifdef PAGE_ARENA_MBIND
+    unsigned int cpu, node;
+    unsigned long mask[PAGE_ARENA_MAX_NODES / (8 * sizeof(unsigned long))] = { 0 };
+
+    if ((syscall(SYS_getcpu, &cpu, &node, NIL) != 0) || (node >= PAGE_ARENA_MAX_NODES))
+    {
+        return;
+    }
+    mask[node / (8 * sizeof(unsigned long))] |= 1UL << (node % (8 * sizeof(unsigned long)));
+    syscall(SYS_mbind, pBase, pSize, PAGE_ARENA_MPOL_PREFERRED, mask, PAGE_ARENA_MAX_NODES + 1, 0);
+#endif
+}
+
+bool Page_Arena::map_region(Huge_page_modes pMode)
+{
+#ifdef _WIN32
+    return false;
+#else
+    region new_region;
+    char* base = NIL;
+
+    new_region.used = 0;
+    new_region.explicit_huge_pages = false;
+
+#ifdef MAP_HUGETLB
+    if (pMode == HUGE_PAGES_EXPLICIT)
+    {
+        /* --- fails unless huge pages have been reserved (vm.nr_hugepages);
+           we then fall back to transparent ones --- */
+        void* p = mmap(NIL, PAGE_ARENA_REGION_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (p != MAP_FAILED)
+        {
+            base = static_cast<char*>(p);
+            new_region.explicit_huge_pages = true;
+        }
+    }
+#endif
+
+    if (!base)
+    {
+        /* --- over-map by a huge page, then trim both ends so the region
+           starts on a huge page boundary --- */
+        size_t size = PAGE_ARENA_REGION_SIZE + PAGE_ARENA_HUGE_PAGE;
+        void* p = mmap(NIL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (p == MAP_FAILED)
+        {
+            return false;
+        }
+        char* start = static_cast<char*>(p);
+        base = reinterpret_cast<char*>((reinterpret_cast<uintptr_t>(start) + PAGE_ARENA_HUGE_PAGE - 1) & ~static_cast<uintptr_t>(PAGE_ARENA_HUGE_PAGE - 1));
+        if (base > start)
+        {
+            munmap(start, base - start);
+        }
+        if (start + size > base + PAGE_ARENA_REGION_SIZE)
+        {
+            munmap(base + PAGE_ARENA_REGION_SIZE, (start + size) - (base + PAGE_ARENA_REGION_SIZE));
+        }
+#ifdef MADV_HUGEPAGE
+        madvise(base, PAGE_ARENA_REGION_SIZE, MADV_HUGEPAGE);
+#endif
+    }
+
+    bind_to_local_node(base, PAGE_ARENA_REGION_SIZE);
+
+    new_region.base = base;
+    regions.push_back(new_region);
+    mapped_bytes += PAGE_ARENA_REGION_SIZE;
+    return true;
+#endif
+}
+
+/* ----------------------------------------------------------------------
+   How much of the arena is actually on huge pages right now.  Explicit
+   regions are by construction; for transparent ones we add up the
+   AnonHugePages the kernel reports for the mappings in our regions.
+---------------------------------------------------------------------- */
+
+size_t Page_Arena::get_huge_page_bytes()
+{
+    size_t total = 0;
+
+    for (size_t i = 0; i < regions.size(); i++)
+    {
+        if (regions[i].explicit_huge_pages)
+        {
+            total += PAGE_ARENA_REGION_SIZE;
+        }
+    }
+
+#ifdef __linux__
+    std::ifstream smaps("/proc/self/smaps");
+    std::string line;
+    bool in_region = false;
+
+    while (std::getline(smaps, line))
+    {
+        unsigned long start, end, kb;
+        std::string first_field = line.substr(0, line.find(' '));
+
+        if ((first_field.find('-') != std::string::npos) && (first_field.find(':') == std::string::npos))
+        {
+            /* --- a mapping header, "start-end perms ..." --- */
+            in_region = false;
+            if (sscanf(first_field.c_str(), "%lx-%lx", &start, &end) == 2)
+            {
+                for (size_t i = 0; i < regions.size(); i++)
+                {
+                    char* region_base = regions[i].base;
+                    if (!regions[i].explicit_huge_pages && (reinterpret_cast<char*>(start) >= region_base) &&
+                            (reinterpret_cast<char*>(start) < region_base + PAGE_ARENA_REGION_SIZE))
+                    {
+                        in_region = true;
+                        break;
+                    }
+                }
+            }
+        }
+        else if (in_region && (first_field == "AnonHugePages:") && (sscanf(line.c_str(), "%*s %lu", &kb) == 1))
+        {
+            total += static_cast<size_t>(kb) * 1024;
+        }
+    }
+#endif
+
+    return total;
+}
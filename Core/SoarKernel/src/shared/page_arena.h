@@ -0,0 +1,73 @@
+/*************************************************************************
+ * PLEASE SEE THE FILE "license.txt" (INCLUDED WITH THIS SOFTWARE PACKAGE)
+ * FOR LICENSE AND COPYRIGHT INFORMATION.
+ *************************************************************************/
+
+/* =======================================================================
+                             page_arena.h
+
+   Backing store for memory pool blocks, carved out of large mmap'd
+   regions instead of malloc'd one block at a time.  The regions are
+   2 MB aligned and either advised for transparent huge pages or mapped
+   from the explicit huge page pool (MAP_HUGETLB), which cuts the TLB
+   misses of agents whose pools run to gigabytes.  "soar huge-pages"
+   picks the mode.
+
+   Each agent's Memory_Manager owns its arena, and regions are mapped
+   lazily, by the thread running the agent, so the kernel's first-touch
+   placement already puts them on that thread's NUMA node.  Linux
+   regions are also bound to that node with mbind(MPOL_PREFERRED)
+   before they are touched.
+
+   Every chunk is PAGE_ARENA_CHUNK_SIZE bytes, enough for any pool
+   block.  A chunk given back is kept for reuse rather than returned to
+   the system, since releasing part of a huge page would split it.
+
+   Where mmap is not available the arena hands out nothing, and the
+   Memory_Manager keeps using malloc.
+======================================================================= */
+
+#ifndef PAGE_ARENA_H
+#define PAGE_ARENA_H
+
+#include "kernel.h"
+
+#include <vector>
+
+#define PAGE_ARENA_CHUNK_SIZE   0x8000              /* 32 KB */
+#define PAGE_ARENA_HUGE_PAGE    (2 * 1024 * 1024)
+#define PAGE_ARENA_REGION_SIZE  (16 * PAGE_ARENA_HUGE_PAGE)
+
+class Page_Arena
+{
+    public:
+
+        Page_Arena();
+        ~Page_Arena();
+
+        void*   allocate_chunk(Huge_page_modes pMode);     /* NIL if no region can be mapped */
+        void    free_chunk(void* pChunk)                    { free_chunks.push_back(pChunk); used_bytes -= PAGE_ARENA_CHUNK_SIZE; }
+        bool    owns(void* pBlock);
+
+        size_t  get_mapped_bytes()                          { return mapped_bytes; }
+        size_t  get_used_bytes()                            { return used_bytes; }
+        size_t  get_huge_page_bytes();
+
+    private:
+
+        typedef struct region_struct
+        {
+            char*   base;
+            size_t  used;
+            bool    explicit_huge_pages;
+        } region;
+
+        std::vector<region>     regions;
+        std::vector<void*>      free_chunks;
+        size_t                  mapped_bytes;
+        size_t                  used_bytes;         /* in chunks handed out */
+
+        bool    map_region(Huge_page_modes pMode);
+};
+
+#endif /* PAGE_ARENA_H */
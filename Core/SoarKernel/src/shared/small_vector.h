@@ -0,0 +1,99 @@
+/*************************************************************************
+ * PLEASE SEE THE FILE "license.txt" (INCLUDED WITH THIS SOFTWARE PACKAGE)
+ * FOR LICENSE AND COPYRIGHT INFORMATION.
+ *************************************************************************/
+
+/* =======================================================================
+                             small_vector.h
+
+   A vector for the short-lived lists the kernel builds and throws away
+   while it works on a production (variables bound so far, variables a
+   condition needs, and so on).  The first N items live in the object
+   itself, so a typical list costs no allocation at all; a longer one
+   moves to a block from the memory pools, doubling as it grows.  This
+   replaces building such lists out of cons cells, one pool allocation
+   and one pointer chase per item.
+
+   Items are copied with memcpy, so T must be a plain type such as a
+   pointer.  The spill blocks come from the calling thread's dynamic
+   pools in the MPM, the same pools the STL allocators in
+   mempool_allocator.h use.
+======================================================================= */
+
+#ifndef SMALL_VECTOR_H
+#define SMALL_VECTOR_H
+
+#include "kernel.h"
+#include "memory_manager.h"
+
+#include <string.h>
+
+template <typename T, size_t N>
+class small_vector
+{
+    public:
+
+        small_vector() : items(inline_items), count(0), capacity(N) {}
+        ~small_vector()                             { if (items != inline_items) free_items(items, capacity); }
+
+        size_t  size() const                        { return count; }
+        bool    empty() const                       { return (count == 0); }
+        T&      operator[](size_t i)                { return items[i]; }
+        T&      back()                              { return items[count - 1]; }
+        T*      begin()                             { return items; }
+        T*      end()                               { return items + count; }
+
+        void    push_back(const T& item)            { if (count == capacity) grow(); items[count++] = item; }
+        void    pop_back()                          { count--; }
+        void    clear()                             { count = 0; }
+
+        bool contains(const T& item) const
+        {
+            for (size_t i = 0; i < count; i++)
+            {
+                if (items[i] == item)
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+    private:
+
+        T       inline_items[N];
+        T*      items;
+        size_t  count;
+        size_t  capacity;
+
+        /* --- declared but not implemented to avoid copies --- */
+        small_vector(const small_vector&);
+        small_vector& operator=(const small_vector&);
+
+        void grow()
+        {
+            Memory_Manager& mpm = Memory_Manager::Get_MPM();
+            size_t new_capacity = capacity * 2;
+            T* new_items;
+
+            mpm.allocate_with_pool_ptr(mpm.get_memory_pool(new_capacity * sizeof(T)), &new_items);
+            memcpy(new_items, items, count * sizeof(T));
+            if (items != inline_items)
+            {
+                free_items(items, capacity);
+            }
+            items = new_items;
+            capacity = new_capacity;
+        }
+
+        static void free_items(T* pItems, size_t pCapacity)
+        {
+            Memory_Manager& mpm = Memory_Manager::Get_MPM();
+            mpm.free_with_pool_ptr(mpm.get_memory_pool(pCapacity * sizeof(T)), pItems);
+        }
+};
+
+/* --- the lists of variables the reorderer and the rete build --- */
+typedef small_vector<Symbol*, 16> var_vector;
+
+#endif /* SMALL_VECTOR_H */
@@ -46,6 +46,8 @@
 #include "production_record.h"
 #include "instantiation.h"
 #include "reinforcement_learning.h"
+#include "rete_profiler.h"
+#include "rete_worker_pool.h"
 #include "rete.h"
 #include "rhs.h"
 #include "rhs_functions.h"
@@ -204,6 +206,24 @@ agent* create_soar_agent(char* agent_name)
     thisAgent->stop_soar                                = true;
     thisAgent->system_halted                            = false;
     thisAgent->token_additions                          = 0;
+    thisAgent->num_parallel_match_batches               = 0;
+    thisAgent->num_parallel_match_wmes                  = 0;
+    thisAgent->num_grouped_match_batches                = 0;
+    thisAgent->num_grouped_match_wmes                   = 0;
+    thisAgent->num_const_filter_programs                = 0;
+    thisAgent->num_const_filter_rebuilds                = 0;
+    thisAgent->num_const_filter_skipped_activations     = 0;
+    thisAgent->num_double_unlinks                       = 0;
+    thisAgent->num_null_activations_avoided_by_double_unlinking = 0;
+    thisAgent->num_bulk_nodes_added                     = 0;
+    thisAgent->num_bulk_nodes_shared                    = 0;
+    thisAgent->num_bulk_subtrees_matched                = 0;
+    thisAgent->bulk_match_usec                          = 0;
+    thisAgent->rete_deferred_nodes                      = NIL;
+    thisAgent->rete_deferred_node_seq                   = 0;
+    thisAgent->rete_bulk_node_count_at_start            = 0;
+    thisAgent->reteWorkerPool                           = NIL;
+    thisAgent->reteProfiler                             = NIL;
     thisAgent->top_goal                                 = NIL;
     thisAgent->top_state                                = NIL;
     thisAgent->wmes_to_add                              = NIL;
@@ -256,7 +276,7 @@ agent* create_soar_agent(char* agent_name)
     soar_init_callbacks(thisAgent);
 
     //
-    thisAgent->memoryManager = &Memory_Manager::Get_MPM();
+    thisAgent->memoryManager = new Memory_Manager();
     init_memory_utilities(thisAgent);
 
     //
@@ -280,6 +300,8 @@ agent* create_soar_agent(char* agent_name)
     // dynamic counters
     thisAgent->dyn_counters = new std::unordered_map< std::string, uint64_t >();
 
+    thisAgent->input_wmes_by_timetag = new std::unordered_map< uint64_t, wme* >();
+
     thisAgent->outputManager = &Output_Manager::Get_OM();
     thisAgent->command_params = new cli_command_params(thisAgent);
     thisAgent->EpMem = new EpMem_Manager(thisAgent);
@@ -359,6 +381,15 @@ void destroy_soar_agent(agent* delete_agent)
 
     soar_remove_all_monitorable_callbacks(delete_agent);
 
+    delete delete_agent->reteWorkerPool;
+    delete_agent->reteWorkerPool = NULL;
+    delete delete_agent->reteProfiler;
+    delete_agent->reteProfiler = NULL;
+    delete delete_agent->rete_deferred_nodes;
+    delete_agent->rete_deferred_nodes = NULL;
+
+    free_rete_hash_table(delete_agent, delete_agent->left_ht);
+    free_rete_hash_table(delete_agent, delete_agent->right_ht);
     delete_agent->memoryManager->free_memory(delete_agent->left_ht, HASH_TABLE_MEM_USAGE);
     delete_agent->memoryManager->free_memory(delete_agent->right_ht, HASH_TABLE_MEM_USAGE);
     delete_agent->memoryManager->free_memory(delete_agent->rhs_variable_bindings, MISCELLANEOUS_MEM_USAGE);
@@ -397,10 +428,15 @@ void destroy_soar_agent(agent* delete_agent)
 
 
     delete delete_agent->dyn_counters;
+    delete delete_agent->input_wmes_by_timetag;
 
     /* Release data used by XML generation */
     xml_destroy(delete_agent);
 
+    /* Release the agent's memory pools along with anything still in them */
+    delete delete_agent->memoryManager;
+    delete_agent->memoryManager = NULL;
+
     /* Release agent data structure */
     delete delete_agent;
 }
@@ -450,6 +486,9 @@ void reinitialize_agent(agent* thisAgent)
     /* Reset basic Soar counters and pending XML trace/commands */
     reset_statistics(thisAgent);
     xml_reset(thisAgent);
+
+    /* Give back the pool blocks the run no longer needs */
+    thisAgent->memoryManager->trim_memory_pools();
 }
 
 cli_command_params::cli_command_params(agent* thisAgent)
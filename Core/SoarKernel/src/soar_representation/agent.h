@@ -75,8 +75,8 @@ typedef struct EXPORT agent_struct
     /////////////////////////////////////////////////////////////////////////////
 
     /* Hash tables for alpha memories, and for entries in left & right memories */
-    void*               left_ht;
-    void*               right_ht;
+    rete_hash_table*    left_ht;
+    rete_hash_table*    right_ht;
     hash_table*        (alpha_hash_tables[16]);
 
     /* Number of WMEs, and list of WMEs, the Rete has been told about */
@@ -96,7 +96,35 @@ typedef struct EXPORT agent_struct
     uint64_t       num_left_activations;
     uint64_t       num_null_right_activations;
     uint64_t       num_null_left_activations;
-
+    uint64_t       num_parallel_match_batches;
+    uint64_t       num_parallel_match_wmes;
+    uint64_t       num_grouped_match_batches;
+    uint64_t       num_grouped_match_wmes;
+    uint64_t       num_const_filter_programs;
+    uint64_t       num_const_filter_rebuilds;
+    uint64_t       num_const_filter_skipped_activations;
+    uint64_t       num_double_unlinks;
+    uint64_t       num_null_activations_avoided_by_double_unlinking;
+    uint64_t       num_bulk_nodes_added;
+    uint64_t       num_bulk_nodes_shared;
+    uint64_t       num_bulk_subtrees_matched;
+    uint64_t       bulk_match_usec;
+
+    /* Nodes built during a bulk load ("source --bulk") that still need
+       their match-from-above, mapped to the order they were built in;
+       NIL unless a bulk load is in progress */
+    std::unordered_map<struct rete_node_struct*, uint64_t>* rete_deferred_nodes;
+    uint64_t       rete_deferred_node_seq;
+    uint64_t       rete_bulk_node_count_at_start;
+
+
+    /* Worker threads for parallel alpha memory lookups ("soar match-threads");
+       NIL unless match-threads is above 1 */
+    Rete_Worker_Pool*   reteWorkerPool;
+
+    /* Per-node activation counts and timings ("production matches --profile");
+       NIL unless profiling is on */
+    Rete_Profiler*      reteProfiler;
 
     /* Miscellaneous other stuff */
     uint32_t       alpha_mem_id_counter; /* node id's for hashing */
@@ -409,8 +437,9 @@ typedef struct EXPORT agent_struct
     io_wme*             collected_io_wmes;
     struct output_link_struct* existing_output_links;
 
-    struct output_link_struct* output_link_for_tc;
-    tc_number           output_link_tc_num;
+    /* every input wme in WM, by timetag; kept by add_input_wme(),
+       remove_input_wme() and the garbage collection of input wmes */
+    std::unordered_map< uint64_t, wme* >* input_wmes_by_timetag;
 
     bool               output_link_changed;
 
@@ -2,6 +2,7 @@
 #define CONDITION_H
 
 #include "kernel.h"
+#include "small_vector.h"
 #include "stl_typedefs.h"
 
 /* -------------------------------------------------------------------
@@ -100,7 +101,9 @@ void        deallocate_condition(agent* thisAgent, condition*& cond);
 void        deallocate_condition_list(agent* thisAgent, condition*& cond_list);
 
 void        add_bound_variables_in_condition(agent* thisAgent, condition* c, tc_number tc, cons** var_list);
+void        add_bound_variables_in_condition(agent* thisAgent, condition* c, tc_number tc, var_vector* var_list);
 void        unmark_variables_and_free_list(agent* thisAgent, cons* var_list);
+void        unmark_variables(var_vector& var_list);
 
 int         condition_count(condition* pCond);
 bool        conditions_are_equal(condition* c1, condition* c2);
@@ -779,12 +779,13 @@ void finalize_instantiation(agent* thisAgent, instantiation* inst, bool need_to_
                 }
             }
             /* Check for local singletons */
-            if (cond->bt.wme_->local_singleton_value_identity_set && lDoIdentities && (cond->bt.wme_->id == inst->match_goal))
+            const wme_cold* bt_cold = wme_cold_fields(cond->bt.wme_);
+            if (bt_cold->local_singleton_value_identity_set && lDoIdentities && (cond->bt.wme_->id == inst->match_goal))
             {
-                thisAgent->explanationBasedChunker->force_id_to_identity_mapping(cond->data.tests.id_test->eq_test->inst_identity, cond->bt.wme_->local_singleton_id_identity_set);
-                thisAgent->explanationBasedChunker->force_id_to_identity_mapping(cond->data.tests.value_test->eq_test->inst_identity, cond->bt.wme_->local_singleton_value_identity_set);
-                set_test_identity(thisAgent, cond->data.tests.id_test->eq_test, cond->bt.wme_->local_singleton_id_identity_set);
-                set_test_identity(thisAgent, cond->data.tests.value_test->eq_test, cond->bt.wme_->local_singleton_value_identity_set);
+                thisAgent->explanationBasedChunker->force_id_to_identity_mapping(cond->data.tests.id_test->eq_test->inst_identity, bt_cold->local_singleton_id_identity_set);
+                thisAgent->explanationBasedChunker->force_id_to_identity_mapping(cond->data.tests.value_test->eq_test->inst_identity, bt_cold->local_singleton_value_identity_set);
+                set_test_identity(thisAgent, cond->data.tests.id_test->eq_test, bt_cold->local_singleton_id_identity_set);
+                set_test_identity(thisAgent, cond->data.tests.value_test->eq_test, bt_cold->local_singleton_value_identity_set);
                 thisAgent->explanationMemory->increment_stat_identity_propagations();
             }
             if (lDoIdentities)
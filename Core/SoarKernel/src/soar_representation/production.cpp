@@ -128,6 +128,15 @@ void unmark_variables_and_free_list(agent* thisAgent, cons* var_list)
     }
 }
 
+void unmark_variables(var_vector& var_list)
+{
+    for (Symbol** it = var_list.begin(); it != var_list.end(); ++it)
+    {
+        (*it)->tc_num = 0;
+    }
+    var_list.clear();
+}
+
 /* =====================================================================
 
    Finding the variables bound in tests, conditions, and condition lists
@@ -151,6 +160,14 @@ void add_bound_variables_in_condition(agent* thisAgent, condition* c, tc_number
     add_bound_variables_in_test(thisAgent, c->data.tests.value_test, tc, var_list);
 }
 
+void add_bound_variables_in_condition(agent* thisAgent, condition* c, tc_number tc, var_vector* var_list)
+{
+    if (c->type != POSITIVE_CONDITION)  return;
+    add_bound_variables_in_test(thisAgent, c->data.tests.id_test, tc, var_list);
+    add_bound_variables_in_test(thisAgent, c->data.tests.attr_test, tc, var_list);
+    add_bound_variables_in_test(thisAgent, c->data.tests.value_test, tc, var_list);
+}
+
 void add_bound_variables_in_condition_list(agent* thisAgent, condition* cond_list, tc_number tc, cons** var_list)
 {
     condition* c;
@@ -564,9 +564,8 @@ void restore_and_deallocate_saved_tests(agent* thisAgent,
                                         saved_test* tests_to_restore)
 {
     condition* cond;
-    cons* new_vars;
+    var_vector new_vars;
 
-        new_vars = NIL;
     for (cond = conds_list; cond != NIL; cond = cond->next)
     {
         #ifdef CONSIDER_NEGATIVE
@@ -610,7 +609,7 @@ void restore_and_deallocate_saved_tests(agent* thisAgent,
             tests_to_restore = next_st;
         }
     }
-    unmark_variables_and_free_list(thisAgent, new_vars);
+    unmark_variables(new_vars);
 }
 
 /* =====================================================================
@@ -702,11 +701,10 @@ cons* collect_vars_tested_by_cond_that_are_bound(agent* thisAgent,
 
 void fill_in_vars_requiring_bindings(agent* thisAgent, condition* cond_list, tc_number tc)
 {
-    cons* new_bound_vars;
+    var_vector new_bound_vars;
     condition* c;
 
     /* --- add anything bound in a positive condition at this level --- */
-    new_bound_vars = NIL;
     for (c = cond_list; c != NIL; c = c->next)
         if (c->type == POSITIVE_CONDITION)
         {
@@ -726,7 +724,7 @@ void fill_in_vars_requiring_bindings(agent* thisAgent, condition* cond_list, tc_
         }
     }
 
-    unmark_variables_and_free_list(thisAgent, new_bound_vars);
+    unmark_variables(new_bound_vars);
 }
 
 void remove_vars_requiring_bindings(agent* thisAgent,
@@ -1022,9 +1020,8 @@ int64_t find_lowest_cost_lookahead(agent* thisAgent,
 {
     condition* c;
     int64_t min_cost, cost;
-    cons* new_vars;
+    var_vector new_vars;
 
-    new_vars = NIL;
     add_bound_variables_in_condition(thisAgent, chosen, tc, &new_vars);
     min_cost = MAX_COST + 1;
     for (c = candidates; c != NIL; c = c->next)
@@ -1043,7 +1040,7 @@ int64_t find_lowest_cost_lookahead(agent* thisAgent,
             }
         }
     }
-    unmark_variables_and_free_list(thisAgent, new_vars);
+    unmark_variables(new_vars);
     return min_cost;
 }
 
@@ -1075,12 +1072,11 @@ void reorder_simplified_conditions(agent* thisAgent,
     condition* min_cost_conds, *chosen;
     int64_t cost = 0;
     int64_t min_cost = 0;
-    cons* new_vars;
+    var_vector new_vars;
 
     remaining_conds = *top_of_conds;
     first_cond = NIL;
     last_cond = NIL;
-    new_vars = NIL;
 
     /* repeat:  scan through remaining_conds
                 rate each one
@@ -1231,7 +1227,7 @@ void reorder_simplified_conditions(agent* thisAgent,
 
     } /* end of while (remaining_conds) */
 
-    unmark_variables_and_free_list(thisAgent, new_vars);
+    unmark_variables(new_vars);
     *top_of_conds = first_cond;
 }
 
@@ -1377,7 +1373,7 @@ bool check_unbound_negative_relational_test_referents(agent* thisAgent, test t,
 
 bool check_negative_relational_test_bindings(agent* thisAgent, condition* cond_list, tc_number tc)
 {
-    cons* bound_vars = NIL;   // this list necessary pop variables bound inside ncc's out of scope on return
+    var_vector bound_vars;    // this list necessary pop variables bound inside ncc's out of scope on return
     condition* c;
     bool ret = true;
 
@@ -1407,7 +1403,7 @@ bool check_negative_relational_test_bindings(agent* thisAgent, condition* cond_l
     }
 
     // unmark anything bound on this level
-    unmark_variables_and_free_list(thisAgent, bound_vars);
+    unmark_variables(bound_vars);
     return ret;
 }
 
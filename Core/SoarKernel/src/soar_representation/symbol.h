@@ -50,30 +50,20 @@ struct strSymbol;
  * to see the type-specific variables in a debugger.  It can also help find some
  * bugs where some part of the kernel may be treating a symbol as the wrong type.
  *
- * WARNING: next_in_hash_table MUST be the first field.  This field is used
- *          by the resizable hash table routines.
- *
  * Explanations of all the fields are at the end of the file.
  *
  * -- */
 
 typedef struct EXPORT symbol_struct
 {
-    struct symbol_struct* next_in_hash_table;
     uint64_t reference_count;
     byte symbol_type;
     byte decider_flag;
     struct wme_struct* decider_wme;
-    uint64_t retesave_symindex;
     uint32_t hash_id;
+    uint32_t handle;
     tc_number tc_num;
 
-    epmem_hash_id epmem_hash;
-    uint64_t epmem_valid;
-
-    smem_hash_id smem_hash;
-    uint64_t smem_valid;
-
     union
     {
         floatSymbol* fc;
@@ -186,6 +176,7 @@ struct idSymbol    : public Symbol
 
     struct epmem_data_struct*   epmem_info;
     epmem_node_id               epmem_id;
+    uint64_t                    epmem_valid;
 
     struct smem_data_struct*    smem_info;
     uint64_t                    LTI_ID;
@@ -289,9 +280,9 @@ double get_number_from_symbol(Symbol* sym);
  * =====================
  * symbol_type                 Indicates which of the five kinds of symbols
  * reference_count             Current reference count for this symbol
- * next_in_hash_table          Next item in hash bucket
  * hash_id                     Used for hashing in the rete (and elsewhere)
- * retesave_symindex           Used for rete fastsave/fastload
+ * handle                      Dense 32-bit index of the symbol within its type;
+ *                             see "Symbol Handles" in symbol_manager.h
  * tc_num                      Used for transitive closure/marking
  * =====================
  * Floating-point constants
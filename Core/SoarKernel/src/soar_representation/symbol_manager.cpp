@@ -32,132 +32,130 @@ Symbol_Manager::Symbol_Manager(agent* pAgent)
 
 Symbol_Manager::~Symbol_Manager()
 {
-    free_hash_table(thisAgent, variable_hash_table);
-    free_hash_table(thisAgent, identifier_hash_table);
-    free_hash_table(thisAgent, str_constant_hash_table);
-    free_hash_table(thisAgent, int_constant_hash_table);
-    free_hash_table(thisAgent, float_constant_hash_table);
+    free_open_hash_table(thisAgent, variable_hash_table);
+    free_open_hash_table(thisAgent, identifier_hash_table);
+    free_open_hash_table(thisAgent, str_constant_hash_table);
+    free_open_hash_table(thisAgent, int_constant_hash_table);
+    free_open_hash_table(thisAgent, float_constant_hash_table);
 }
 
 /* -------------------------------------------------------------------
                            Hash Functions
 
-   Compress() takes a 32-bit hash value and compresses it down to a few
-   bits, xor-ing pieces of the 32-bit value to avoid throwing away bits
-   that might be important for the hash function to be effective.
+   The symbol tables are open-addressing tables indexed by the low bits
+   of the hash, so every bit of a symbol's basic info has to reach them.
 
-   Hash_string() produces a hash value for a string of characters.
+   Hash_uint64() is the 64-bit finalizer from MurmurHash3, folded to 32
+   bits.  Ints and identifiers are hashed on all 64 bits of their value
+   or number, and floats on the bits of the double (with -0.0 made 0.0,
+   since the two compare equal).  Hash_string() reads a string eight
+   bytes at a time, multiplying each word into the state, and finishes
+   with hash_uint64().
 
    Hash_xxx_raw_info() are the hash functions for the five kinds of
    symbols.  These functions operate on the basic info about the symbol
    (i.e., the name, value, etc.).  Hash_xxx(), on the other hand,
    operate on the symbol table entries for the five kinds of symbols--
    these routines are the callback hashing functions used by the
-   resizable hash table routines.
+   open-addressing hash table routines.
 ------------------------------------------------------------------- */
 
-uint32_t compress(uint32_t h, short num_bits)
+inline uint32_t hash_uint64(uint64_t x)
 {
-    uint32_t result;
+    x ^= x >> 33;
+    x *= 0xFF51AFD7ED558CCDULL;
+    x ^= x >> 33;
+    x *= 0xC4CEB9FE1A85EC53ULL;
+    x ^= x >> 33;
+    return static_cast<uint32_t>(x) ^ static_cast<uint32_t>(x >> 32);
+}
 
-    if (num_bits < 16)
-    {
-        h = (h & 0xFFFF) ^ (h >> 16);
-    }
-    if (num_bits < 8)
-    {
-        h = (h & 0xFF) ^ (h >> 8);
-    }
-    result = 0;
-    while (h)
+uint32_t hash_string(const char* s)
+{
+    size_t len = strlen(s);
+    uint64_t h = 0x9E3779B97F4A7C15ULL ^ len;
+    uint64_t word;
+
+    for (; len >= 8; s += 8, len -= 8)
     {
-        result ^= (h & masks_for_n_low_order_bits[num_bits]);
-        h = h >> num_bits;
+        memcpy(&word, s, 8);
+        h = (h ^ word) * 0xBF58476D1CE4E5B9ULL;
+        h ^= h >> 31;
     }
-    return result;
+    word = 0;
+    memcpy(&word, s, len);
+    return hash_uint64(h ^ word);
 }
 
-uint32_t hash_string(const char* s)      /* AGR 600 */
+inline uint32_t hash_double(double value)
 {
-    uint32_t h;
+    uint64_t bits;
 
-    h = 0;
-    while (*s != 0)
+    if (value == 0.0)
     {
-        h = ((h << 8) | (h >> 24)) ^ (*s);
-        s++;
+        value = 0.0;
     }
-    return h;
+    memcpy(&bits, &value, sizeof(bits));
+    return hash_uint64(bits);
 }
 
 /* -----------------------------------------
    Hashing symbols using their basic info
 ----------------------------------------- */
 
-uint32_t hash_variable_raw_info(const char* name, short num_bits)
+inline uint32_t hash_variable_raw_info(const char* name)
 {
-    return compress(hash_string(name), num_bits);
+    return hash_string(name);
 }
 
-uint32_t hash_identifier_raw_info(char name_letter,
-                                  uint64_t name_number,
-                                  short num_bits)
+inline uint32_t hash_identifier_raw_info(char name_letter, uint64_t name_number)
 {
-    return compress(static_cast<uint32_t>(name_number) ^ (static_cast<uint32_t>(name_letter) << 24), num_bits);  // FIXME: cast from 64 to 32 bits
+    return hash_uint64(name_number ^ (static_cast<uint64_t>(static_cast<unsigned char>(name_letter)) << 56));
 }
 
-uint32_t hash_str_constant_raw_info(const char* name, short num_bits)
+inline uint32_t hash_str_constant_raw_info(const char* name)
 {
-    return compress(hash_string(name), num_bits);
+    return hash_string(name);
 }
 
-uint32_t hash_int_constant_raw_info(int64_t value, short num_bits)
+inline uint32_t hash_int_constant_raw_info(int64_t value)
 {
-    return compress(static_cast<uint32_t>(value), num_bits);
+    return hash_uint64(static_cast<uint64_t>(value));
 }
 
-uint32_t hash_float_constant_raw_info(double value, short num_bits)
+inline uint32_t hash_float_constant_raw_info(double value)
 {
-    return compress(static_cast<uint32_t>(value), num_bits);
+    return hash_double(value);
 }
 
 /* ---------------------------------------------------
    Hashing symbols using their symbol table entries
 --------------------------------------------------- */
 
-uint32_t hash_variable(void* item, short num_bits)
+uint32_t hash_variable(void* item)
 {
-    varSymbol* var;
-    var = static_cast<varSymbol*>(item);
-    return compress(hash_string(var->name), num_bits);
+    return hash_variable_raw_info(static_cast<varSymbol*>(item)->name);
 }
 
-uint32_t hash_identifier(void* item, short num_bits)
+uint32_t hash_identifier(void* item)
 {
-    idSymbol* id;
-    id = static_cast<idSymbol*>(item);
-    return compress(static_cast<uint32_t>(id->name_number) ^ (static_cast<uint32_t>(id->name_letter) << 24), num_bits);  // FIXME: cast from 64 to 32 bits
+    idSymbol* id = static_cast<idSymbol*>(item);
+    return hash_identifier_raw_info(id->name_letter, id->name_number);
 }
 
-uint32_t hash_str_constant(void* item, short num_bits)
+uint32_t hash_str_constant(void* item)
 {
-    strSymbol* sc;
-    sc = static_cast<strSymbol*>(item);
-    return compress(hash_string(sc->name), num_bits);
+    return hash_str_constant_raw_info(static_cast<strSymbol*>(item)->name);
 }
 
-uint32_t hash_int_constant(void* item, short num_bits)
+uint32_t hash_int_constant(void* item)
 {
-    intSymbol* ic;
-    ic = static_cast<intSymbol*>(item);
-    return compress(static_cast<uint32_t>(ic->value), num_bits);
+    return hash_int_constant_raw_info(static_cast<intSymbol*>(item)->value);
 }
 
-uint32_t hash_float_constant(void* item, short num_bits)
+uint32_t hash_float_constant(void* item)
 {
-    floatSymbol* fc;
-    fc = static_cast<floatSymbol*>(item);
-    return compress(static_cast<uint32_t>(fc->value), num_bits);
+    return hash_float_constant_raw_info(static_cast<floatSymbol*>(item)->value);
 }
 
 /* -----------------------------------------------------------------
@@ -215,11 +213,11 @@ uint32_t hash_float_constant(void* item, short num_bits)
 
 void Symbol_Manager::init_symbol_tables()
 {
-    variable_hash_table = make_hash_table(thisAgent, 0, hash_variable);
-    identifier_hash_table = make_hash_table(thisAgent, 0, hash_identifier);
-    str_constant_hash_table = make_hash_table(thisAgent, 0, hash_str_constant);
-    int_constant_hash_table = make_hash_table(thisAgent, 0, hash_int_constant);
-    float_constant_hash_table = make_hash_table(thisAgent, 0, hash_float_constant);
+    variable_hash_table = make_open_hash_table(thisAgent, 4, hash_variable);
+    identifier_hash_table = make_open_hash_table(thisAgent, 4, hash_identifier);
+    str_constant_hash_table = make_open_hash_table(thisAgent, 4, hash_str_constant);
+    int_constant_hash_table = make_open_hash_table(thisAgent, 4, hash_int_constant);
+    float_constant_hash_table = make_open_hash_table(thisAgent, 4, hash_float_constant);
 
     thisAgent->memoryManager->init_memory_pool(MP_variable, sizeof(varSymbol), "variable");
     thisAgent->memoryManager->init_memory_pool(MP_identifier, sizeof(idSymbol), "identifier");
@@ -237,7 +235,7 @@ bool retesave_symbol_and_assign_index(agent* thisAgent, void* item, void* userda
 
     sym = static_cast<symbol_struct*>(item);
     thisAgent->current_retesave_symindex++;
-    sym->retesave_symindex = thisAgent->current_retesave_symindex;
+    thisAgent->symbolManager->side_data(sym).retesave_symindex = thisAgent->current_retesave_symindex;
     retesave_string(sym->to_string(), f);
     return false;
 }
@@ -252,23 +250,22 @@ void Symbol_Manager::retesave(FILE* f)
     retesave_eight_bytes(int_constant_hash_table->count, f);
     retesave_eight_bytes(float_constant_hash_table->count, f);
 
-    do_for_all_items_in_hash_table(thisAgent, str_constant_hash_table, retesave_symbol_and_assign_index, f);
-    do_for_all_items_in_hash_table(thisAgent, variable_hash_table, retesave_symbol_and_assign_index, f);
-    do_for_all_items_in_hash_table(thisAgent, int_constant_hash_table, retesave_symbol_and_assign_index, f);
-    do_for_all_items_in_hash_table(thisAgent, float_constant_hash_table, retesave_symbol_and_assign_index, f);
+    do_for_all_items_in_open_hash_table(thisAgent, str_constant_hash_table, retesave_symbol_and_assign_index, f);
+    do_for_all_items_in_open_hash_table(thisAgent, variable_hash_table, retesave_symbol_and_assign_index, f);
+    do_for_all_items_in_open_hash_table(thisAgent, int_constant_hash_table, retesave_symbol_and_assign_index, f);
+    do_for_all_items_in_open_hash_table(thisAgent, float_constant_hash_table, retesave_symbol_and_assign_index, f);
 }
 Symbol* Symbol_Manager::find_variable(const char* name)
 {
-    uint32_t hash_value;
-    varSymbol* sym;
+    uint32_t hash_value, i;
+    open_hash_slot* slots = variable_hash_table->slots;
 
-    hash_value = hash_variable_raw_info(name, variable_hash_table->log2size);
-    sym = reinterpret_cast<varSymbol*>(*(variable_hash_table->buckets + hash_value));
-    for (; sym != NIL; sym = static_cast<varSymbol*>(sym->next_in_hash_table))
+    hash_value = hash_variable_raw_info(name);
+    for (i = hash_value & variable_hash_table->mask; slots[i].item; i = (i + 1) & variable_hash_table->mask)
     {
-        if (!strcmp(sym->name, name))
+        if ((slots[i].hash == hash_value) && !strcmp(static_cast<varSymbol*>(slots[i].item)->name, name))
         {
-            return sym;
+            return static_cast<varSymbol*>(slots[i].item);
         }
     }
     return NIL;
@@ -276,14 +273,14 @@ Symbol* Symbol_Manager::find_variable(const char* name)
 
 Symbol* Symbol_Manager::find_identifier(char name_letter, uint64_t name_number)
 {
-    uint32_t hash_value;
+    uint32_t hash_value, i;
+    open_hash_slot* slots = identifier_hash_table->slots;
     idSymbol* sym;
 
-    hash_value = hash_identifier_raw_info(name_letter, name_number,
-                                          identifier_hash_table->log2size);
-    sym = reinterpret_cast<idSymbol*>(*(identifier_hash_table->buckets + hash_value));
-    for (; sym != NIL; sym = static_cast<idSymbol*>(sym->next_in_hash_table))
+    hash_value = hash_identifier_raw_info(name_letter, name_number);
+    for (i = hash_value & identifier_hash_table->mask; slots[i].item; i = (i + 1) & identifier_hash_table->mask)
     {
+        sym = static_cast<idSymbol*>(slots[i].item);
         if ((name_letter == sym->name_letter) &&
                 (name_number == sym->name_number))
         {
@@ -295,17 +292,15 @@ Symbol* Symbol_Manager::find_identifier(char name_letter, uint64_t name_number)
 
 Symbol* Symbol_Manager::find_str_constant(const char* name)
 {
-    uint32_t hash_value;
-    strSymbol* sym;
+    uint32_t hash_value, i;
+    open_hash_slot* slots = str_constant_hash_table->slots;
 
-    hash_value = hash_str_constant_raw_info(name,
-                                            str_constant_hash_table->log2size);
-    sym = reinterpret_cast<strSymbol*>(*(str_constant_hash_table->buckets + hash_value));
-    for (; sym != NIL; sym = static_cast<strSymbol*>(sym->next_in_hash_table))
+    hash_value = hash_str_constant_raw_info(name);
+    for (i = hash_value & str_constant_hash_table->mask; slots[i].item; i = (i + 1) & str_constant_hash_table->mask)
     {
-        if (!strcmp(sym->name, name))
+        if ((slots[i].hash == hash_value) && !strcmp(static_cast<strSymbol*>(slots[i].item)->name, name))
         {
-            return sym;
+            return static_cast<strSymbol*>(slots[i].item);
         }
     }
     return NIL;
@@ -313,14 +308,14 @@ Symbol* Symbol_Manager::find_str_constant(const char* name)
 
 Symbol* Symbol_Manager::find_int_constant(int64_t value)
 {
-    uint32_t hash_value;
+    uint32_t hash_value, i;
+    open_hash_slot* slots = int_constant_hash_table->slots;
     intSymbol* sym;
 
-    hash_value = hash_int_constant_raw_info(value,
-                                            int_constant_hash_table->log2size);
-    sym = reinterpret_cast<intSymbol*>(*(int_constant_hash_table->buckets + hash_value));
-    for (; sym != NIL; sym = static_cast<intSymbol*>(sym->next_in_hash_table))
+    hash_value = hash_int_constant_raw_info(value);
+    for (i = hash_value & int_constant_hash_table->mask; slots[i].item; i = (i + 1) & int_constant_hash_table->mask)
     {
+        sym = static_cast<intSymbol*>(slots[i].item);
         if (value == sym->value)
         {
             return sym;
@@ -331,14 +326,14 @@ Symbol* Symbol_Manager::find_int_constant(int64_t value)
 
 Symbol* Symbol_Manager::find_float_constant(double value)
 {
-    uint32_t hash_value;
+    uint32_t hash_value, i;
+    open_hash_slot* slots = float_constant_hash_table->slots;
     floatSymbol* sym;
 
-    hash_value = hash_float_constant_raw_info(value,
-                 float_constant_hash_table->log2size);
-    sym = reinterpret_cast<floatSymbol*>(*(float_constant_hash_table->buckets + hash_value));
-    for (; sym != NIL; sym = static_cast<floatSymbol*>(sym->next_in_hash_table))
+    hash_value = hash_float_constant_raw_info(value);
+    for (i = hash_value & float_constant_hash_table->mask; slots[i].item; i = (i + 1) & float_constant_hash_table->mask)
     {
+        sym = static_cast<floatSymbol*>(slots[i].item);
         if (value == sym->value)
         {
             return sym;
@@ -363,6 +358,7 @@ Symbol* Symbol_Manager::make_variable(const char* name)
     sym->symbol_type = VARIABLE_SYMBOL_TYPE;
     sym->reference_count = 0;
     sym->hash_id = get_next_symbol_hash_id(thisAgent);
+    assign_handle(sym);
     sym->tc_num = 0;
     sym->name = make_memory_block_for_string(thisAgent, name);
     sym->gensym_number = 0;
@@ -376,7 +372,7 @@ Symbol* Symbol_Manager::make_variable(const char* name)
     sym->id = NULL;
     sym->var = sym;
     symbol_add_ref(sym);
-    add_to_hash_table(thisAgent, variable_hash_table, sym);
+    add_to_open_hash_table(thisAgent, variable_hash_table, sym);
 
     return sym;
 }
@@ -404,6 +400,7 @@ Symbol* Symbol_Manager::make_new_identifier(char name_letter, goal_stack_level l
     sym->symbol_type = IDENTIFIER_SYMBOL_TYPE;
     sym->reference_count = 0;
     sym->hash_id = get_next_symbol_hash_id(thisAgent);
+    assign_handle(sym);
     sym->tc_num = 0;
     sym->thisAgent = thisAgent;
     sym->cached_print_str = NULL;
@@ -455,7 +452,6 @@ Symbol* Symbol_Manager::make_new_identifier(char name_letter, goal_stack_level l
     sym->smem_info = NULL;
     sym->LTI_ID = NIL;
     sym->LTI_epmem_valid = NIL;
-    sym->smem_valid = NIL;
 
     sym->rl_trace = NULL;
 
@@ -465,7 +461,7 @@ Symbol* Symbol_Manager::make_new_identifier(char name_letter, goal_stack_level l
     sym->var = NULL;
     sym->id = sym;
     symbol_add_ref(sym);
-    add_to_hash_table(thisAgent, identifier_hash_table, sym);
+    add_to_open_hash_table(thisAgent, identifier_hash_table, sym);
 
     return sym;
 }
@@ -481,12 +477,9 @@ Symbol* Symbol_Manager::make_str_constant_no_find(char const* name)
     sym->symbol_type = STR_CONSTANT_SYMBOL_TYPE;
     sym->reference_count = 0;
     sym->hash_id = get_next_symbol_hash_id(thisAgent);
+    assign_handle(sym);
     sym->tc_num = 0;
     sym->singleton.possible = false;
-    sym->epmem_hash = 0;
-    sym->epmem_valid = 0;
-    sym->smem_hash = 0;
-    sym->smem_valid = 0;
     sym->name = make_memory_block_for_string(thisAgent, name);
     sym->thisAgent = thisAgent;
     sym->cached_rereadable_print_str = NULL;
@@ -497,7 +490,7 @@ Symbol* Symbol_Manager::make_str_constant_no_find(char const* name)
     sym->var = NULL;
     sym->sc = sym;
     symbol_add_ref(sym);
-    add_to_hash_table(thisAgent, str_constant_hash_table, sym);
+    add_to_open_hash_table(thisAgent, str_constant_hash_table, sym);
 
     return sym;
 }
@@ -529,11 +522,8 @@ Symbol* Symbol_Manager::make_int_constant(int64_t value)
         sym->symbol_type = INT_CONSTANT_SYMBOL_TYPE;
         sym->reference_count = 0;
         sym->hash_id = get_next_symbol_hash_id(thisAgent);
+        assign_handle(sym);
         sym->tc_num = 0;
-        sym->epmem_hash = 0;
-        sym->epmem_valid = 0;
-        sym->smem_hash = 0;
-        sym->smem_valid = 0;
         sym->value = value;
         sym->thisAgent = thisAgent;
         sym->cached_print_str = NULL;
@@ -543,7 +533,7 @@ Symbol* Symbol_Manager::make_int_constant(int64_t value)
         sym->var = NULL;
         sym->ic = sym;
         symbol_add_ref(sym);
-        add_to_hash_table(thisAgent, int_constant_hash_table, sym);
+        add_to_open_hash_table(thisAgent, int_constant_hash_table, sym);
     }
     return sym;
 }
@@ -563,11 +553,8 @@ Symbol* Symbol_Manager::make_float_constant(double value)
         sym->symbol_type = FLOAT_CONSTANT_SYMBOL_TYPE;
         sym->reference_count = 0;
         sym->hash_id = get_next_symbol_hash_id(thisAgent);
+        assign_handle(sym);
         sym->tc_num = 0;
-        sym->epmem_hash = 0;
-        sym->epmem_valid = 0;
-        sym->smem_hash = 0;
-        sym->smem_valid = 0;
         sym->value = value;
         sym->thisAgent = thisAgent;
         sym->cached_print_str = NULL;
@@ -577,7 +564,7 @@ Symbol* Symbol_Manager::make_float_constant(double value)
         sym->var = NULL;
         sym->fc = sym;
         symbol_add_ref(sym);
-        add_to_hash_table(thisAgent, float_constant_hash_table, sym);
+        add_to_open_hash_table(thisAgent, float_constant_hash_table, sym);
     }
     return sym;
 }
@@ -900,36 +887,77 @@ void Symbol_Manager::release_predefined_symbols()
 
 ------------------------------------------------------------------- */
 
+void Symbol_Manager::assign_handle(Symbol* sym)
+{
+    std::vector<Symbol*>& symbols = handle_symbols[sym->symbol_type];
+    std::vector<symbol_side_data>& side = handle_side_data[sym->symbol_type];
+    std::vector<uint32_t>& free_list = free_handles[sym->symbol_type];
+    uint32_t index;
+
+    if (!free_list.empty())
+    {
+        index = free_list.back();
+        free_list.pop_back();
+        symbols[index] = sym;
+        side[index] = symbol_side_data();
+    }
+    else
+    {
+        index = static_cast<uint32_t>(symbols.size());
+        assert(index <= SYMBOL_HANDLE_INDEX_MASK);
+        symbols.push_back(sym);
+        side.push_back(symbol_side_data());
+    }
+    sym->handle = (static_cast<uint32_t>(sym->symbol_type) << SYMBOL_HANDLE_TYPE_SHIFT) | index;
+}
+
+void Symbol_Manager::release_handle(Symbol* sym)
+{
+    uint32_t index = symbol_handle_index(sym->handle);
+
+    handle_symbols[sym->symbol_type][index] = NIL;
+    free_handles[sym->symbol_type].push_back(index);
+}
+
+/* --- used when a whole symbol table is thrown away at once --- */
+void Symbol_Manager::release_all_handles(byte symbol_type)
+{
+    handle_symbols[symbol_type].clear();
+    handle_side_data[symbol_type].clear();
+    free_handles[symbol_type].clear();
+}
+
 void Symbol_Manager::deallocate_symbol(Symbol*& sym)
 {
+    release_handle(sym);
     switch (sym->symbol_type)
     {
         case VARIABLE_SYMBOL_TYPE:
-            remove_from_hash_table(thisAgent, variable_hash_table, sym);
+            remove_from_open_hash_table(thisAgent, variable_hash_table, sym);
             free_memory_block_for_string(thisAgent, sym->var->name);
             thisAgent->memoryManager->free_with_pool(MP_variable, sym);
             break;
         case IDENTIFIER_SYMBOL_TYPE:
             if (sym->id->cached_print_str) free_memory_block_for_string(thisAgent, sym->id->cached_print_str);
             if (sym->id->cached_lti_str) free_memory_block_for_string(thisAgent, sym->id->cached_lti_str);
-            remove_from_hash_table(thisAgent, identifier_hash_table, sym);
+            remove_from_open_hash_table(thisAgent, identifier_hash_table, sym);
             thisAgent->memoryManager->free_with_pool(MP_identifier, sym);
             break;
         case STR_CONSTANT_SYMBOL_TYPE:
             if (sym->sc->cached_rereadable_print_str && (sym->sc->cached_rereadable_print_str != sym->sc->name))
                 free_memory_block_for_string(thisAgent, sym->sc->cached_rereadable_print_str);
-            remove_from_hash_table(thisAgent, str_constant_hash_table, sym);
+            remove_from_open_hash_table(thisAgent, str_constant_hash_table, sym);
             free_memory_block_for_string(thisAgent, sym->sc->name);
             thisAgent->memoryManager->free_with_pool(MP_str_constant, sym);
             break;
         case INT_CONSTANT_SYMBOL_TYPE:
             if (sym->ic->cached_print_str) free_memory_block_for_string(thisAgent, sym->ic->cached_print_str);
-            remove_from_hash_table(thisAgent, int_constant_hash_table, sym);
+            remove_from_open_hash_table(thisAgent, int_constant_hash_table, sym);
             thisAgent->memoryManager->free_with_pool(MP_int_constant, sym);
             break;
         case FLOAT_CONSTANT_SYMBOL_TYPE:
             if (sym->fc->cached_print_str) free_memory_block_for_string(thisAgent, sym->fc->cached_print_str);
-            remove_from_hash_table(thisAgent, float_constant_hash_table, sym);
+            remove_from_open_hash_table(thisAgent, float_constant_hash_table, sym);
             thisAgent->memoryManager->free_with_pool(MP_float_constant, sym);
             break;
         default:
@@ -1020,21 +1048,21 @@ bool print_sym(agent* thisAgent, void* item, void*)
 
 void Symbol_Manager::clear_variable_gensym_numbers()
 {
-    do_for_all_items_in_hash_table(thisAgent, variable_hash_table, clear_gensym_number, 0);
+    do_for_all_items_in_open_hash_table(thisAgent, variable_hash_table, clear_gensym_number, 0);
 }
 
 void Symbol_Manager::print_internal_symbols()
 {
     thisAgent->outputManager->printa_sf(thisAgent,  "\n--- Symbolic Constants: ---\n");
-    do_for_all_items_in_hash_table(thisAgent, str_constant_hash_table, print_sym, 0);
+    do_for_all_items_in_open_hash_table(thisAgent, str_constant_hash_table, print_sym, 0);
     thisAgent->outputManager->printa_sf(thisAgent,  "\n--- Integer Constants: ---\n");
-    do_for_all_items_in_hash_table(thisAgent, int_constant_hash_table, print_sym, 0);
+    do_for_all_items_in_open_hash_table(thisAgent, int_constant_hash_table, print_sym, 0);
     thisAgent->outputManager->printa_sf(thisAgent,  "\n--- Floating-Point Constants: ---\n");
-    do_for_all_items_in_hash_table(thisAgent, float_constant_hash_table, print_sym, 0);
+    do_for_all_items_in_open_hash_table(thisAgent, float_constant_hash_table, print_sym, 0);
     thisAgent->outputManager->printa_sf(thisAgent,  "\n--- Identifiers: ---\n");
-    do_for_all_items_in_hash_table(thisAgent, identifier_hash_table, print_sym, 0);
+    do_for_all_items_in_open_hash_table(thisAgent, identifier_hash_table, print_sym, 0);
     thisAgent->outputManager->printa_sf(thisAgent,  "\n--- Variables: ---\n");
-    do_for_all_items_in_hash_table(thisAgent, variable_hash_table, print_sym, 0);
+    do_for_all_items_in_open_hash_table(thisAgent, variable_hash_table, print_sym, 0);
 }
 
 void Symbol_Manager::reset_hash_table(MemoryPoolType lHashTable)
@@ -1049,7 +1077,7 @@ void Symbol_Manager::reset_hash_table(MemoryPoolType lHashTable)
                  * detect refcount leaks in unit tests and print out a message accordingly */
                 #ifndef SOAR_RELEASE_VERSION
                     if (identifier_hash_table->count < 23)
-                        do_for_all_items_in_hash_table(thisAgent, identifier_hash_table, print_sym, 0);
+                        do_for_all_items_in_open_hash_table(thisAgent, identifier_hash_table, print_sym, 0);
                     else
                         std::cout << "Refcount leak of " << identifier_hash_table->count << " identifiers detected. ";
                 #else
@@ -1065,12 +1093,13 @@ void Symbol_Manager::reset_hash_table(MemoryPoolType lHashTable)
                 /* Note:  The do_for_all_items_in_hash_table printing could cause a crash if there's
                  *        memory corruption, but usually prints out and is good for debugging. */
                 #ifndef SOAR_RELEASE_VERSION
-                do_for_all_items_in_hash_table(thisAgent, identifier_hash_table, print_sym, 0);
+                do_for_all_items_in_open_hash_table(thisAgent, identifier_hash_table, print_sym, 0);
                 #endif
             }
-            free_hash_table(thisAgent, identifier_hash_table);
+            free_open_hash_table(thisAgent, identifier_hash_table);
             thisAgent->memoryManager->free_memory_pool(MP_identifier);
-            identifier_hash_table = make_hash_table(thisAgent, 0, hash_identifier);
+            release_all_handles(IDENTIFIER_SYMBOL_TYPE);
+            identifier_hash_table = make_open_hash_table(thisAgent, 4, hash_identifier);
         }
     }
 }
@@ -1091,8 +1120,8 @@ bool reset_tc_num(agent* /*thisAgent*/, void* item, void*)
 
 void Symbol_Manager::reset_id_and_variable_tc_numbers()
 {
-    do_for_all_items_in_hash_table(thisAgent, identifier_hash_table, reset_tc_num, 0);
-    do_for_all_items_in_hash_table(thisAgent, variable_hash_table, reset_tc_num, 0);
+    do_for_all_items_in_open_hash_table(thisAgent, identifier_hash_table, reset_tc_num, 0);
+    do_for_all_items_in_open_hash_table(thisAgent, variable_hash_table, reset_tc_num, 0);
 }
 
 Symbol* Symbol_Manager::generate_new_str_constant(const char* prefix, uint64_t* counter)
@@ -15,8 +15,39 @@
 
 #include <iostream>
 #include <string>
+#include <vector>
 bool is_DT_mode_enabled(TraceMode mode);
 
+/* --------------------------------------------------------------------
+                             Symbol Handles
+
+   Every symbol gets a dense 32-bit handle when it is made:  the top
+   three bits are its symbol type and the rest its index in that type's
+   handle array.  Indices of deallocated symbols are reused, so a handle
+   is only meaningful while the symbol exists.
+
+   Fields that only one module uses (the epmem and smem temporal hash
+   caches and the rete fastsave index) live in a side table indexed by
+   handle instead of in every symbol.  The entry is cleared whenever a
+   handle is handed out.
+-------------------------------------------------------------------- */
+
+#define SYMBOL_HANDLE_TYPE_SHIFT    29
+#define SYMBOL_HANDLE_INDEX_MASK    ((static_cast<uint32_t>(1) << SYMBOL_HANDLE_TYPE_SHIFT) - 1)
+#define NUM_SYMBOL_HANDLE_TYPES     (FLOAT_CONSTANT_SYMBOL_TYPE + 1)
+
+inline byte     symbol_handle_type(uint32_t handle)     { return static_cast<byte>(handle >> SYMBOL_HANDLE_TYPE_SHIFT); }
+inline uint32_t symbol_handle_index(uint32_t handle)    { return handle & SYMBOL_HANDLE_INDEX_MASK; }
+
+typedef struct symbol_side_data_struct
+{
+    epmem_hash_id   epmem_hash;
+    uint64_t        epmem_valid;
+    smem_hash_id    smem_hash;
+    uint64_t        smem_valid;
+    uint64_t        retesave_symindex;
+} symbol_side_data;
+
 class EXPORT Symbol_Manager {
 
         friend Output_Manager;
@@ -62,6 +93,11 @@ class EXPORT Symbol_Manager {
 
         uint64_t* get_id_counter(uint64_t name_letter ) { return &id_counter[name_letter]; }
 
+        Symbol*             symbol_from_handle(uint32_t handle)
+                            { return handle_symbols[symbol_handle_type(handle)][symbol_handle_index(handle)]; }
+        symbol_side_data&   side_data(Symbol* sym)
+                            { return handle_side_data[sym->symbol_type][symbol_handle_index(sym->handle)]; }
+
         /* --------------------------------------------------------------------
                                  Variable Generator
 
@@ -109,15 +145,22 @@ class EXPORT Symbol_Manager {
         uint64_t    current_variable_gensym_number;
         uint64_t    gensymed_variable_count[26];
 
-        struct hash_table_struct* float_constant_hash_table;
-        struct hash_table_struct* identifier_hash_table;
-        struct hash_table_struct* int_constant_hash_table;
-        struct hash_table_struct* str_constant_hash_table;
-        struct hash_table_struct* variable_hash_table;
+        struct open_hash_table_struct* float_constant_hash_table;
+        struct open_hash_table_struct* identifier_hash_table;
+        struct open_hash_table_struct* int_constant_hash_table;
+        struct open_hash_table_struct* str_constant_hash_table;
+        struct open_hash_table_struct* variable_hash_table;
 
         void clear_variable_gensym_numbers();
 
+        std::vector<Symbol*>            handle_symbols[NUM_SYMBOL_HANDLE_TYPES];
+        std::vector<symbol_side_data>   handle_side_data[NUM_SYMBOL_HANDLE_TYPES];
+        std::vector<uint32_t>           free_handles[NUM_SYMBOL_HANDLE_TYPES];
+
         void deallocate_symbol(Symbol*& sym);
+        void assign_handle(Symbol* sym);
+        void release_handle(Symbol* sym);
+        void release_all_handles(byte symbol_type);
 
         uint32_t get_next_symbol_hash_id(agent* thisAgent) { return (current_symbol_hash_id += 137); }
 
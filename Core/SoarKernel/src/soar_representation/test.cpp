@@ -686,7 +686,25 @@ void add_all_variables_in_test(agent* thisAgent, test t,
  * it also consider whether the LTIs level can be determined by being linked
  * to a LHS element or a RHS action that has already been executed */
 
-void add_bound_variables_in_test(agent* thisAgent, test t, tc_number tc, cons** var_list)
+static inline void mark_bound_variable(agent* thisAgent, Symbol* sym, tc_number tc, cons** var_list)
+{
+    sym->mark_if_unmarked(thisAgent, tc, var_list);
+}
+
+static inline void mark_bound_variable(agent* thisAgent, Symbol* sym, tc_number tc, var_vector* var_list)
+{
+    if (sym->tc_num != tc)
+    {
+        sym->tc_num = tc;
+        if (var_list)
+        {
+            var_list->push_back(sym);
+        }
+    }
+}
+
+template <typename ListType>
+static void add_bound_variables_in_test_to_list(agent* thisAgent, test t, tc_number tc, ListType* var_list)
 {
     cons* c;
     Symbol* referent = NULL;
@@ -704,7 +722,7 @@ void add_bound_variables_in_test(agent* thisAgent, test t, tc_number tc, cons**
         case CONJUNCTIVE_TEST:
             for (c = t->data.conjunct_list; c != NIL; c = c->rest)
             {
-                add_bound_variables_in_test(thisAgent, static_cast<test>(c->first), tc, var_list);
+                add_bound_variables_in_test_to_list(thisAgent, static_cast<test>(c->first), tc, var_list);
             }
             break;
             /* If you re-enable the next section, variables bound to lti-id's will be legal on the rhs.
@@ -721,11 +739,21 @@ void add_bound_variables_in_test(agent* thisAgent, test t, tc_number tc, cons**
 
     if (referent && referent->is_variable())
     {
-        referent->mark_if_unmarked(thisAgent, tc, var_list);
+        mark_bound_variable(thisAgent, referent, tc, var_list);
     }
     return;
 }
 
+void add_bound_variables_in_test(agent* thisAgent, test t, tc_number tc, cons** var_list)
+{
+    add_bound_variables_in_test_to_list(thisAgent, t, tc, var_list);
+}
+
+void add_bound_variables_in_test(agent* thisAgent, test t, tc_number tc, var_vector* var_list)
+{
+    add_bound_variables_in_test_to_list(thisAgent, t, tc, var_list);
+}
+
 void add_bound_variable_with_identity(agent* thisAgent, Symbol* pSym, Symbol* pMatchedSym, uint64_t pInstIdentity,  tc_number tc, matched_symbol_list* var_list)
 {
     Symbol* referent;
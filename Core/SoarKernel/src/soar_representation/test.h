@@ -17,6 +17,7 @@
 #define TEST_H_
 
 #include "kernel.h"
+#include "small_vector.h"
 #include "stl_typedefs.h"
 
 template <typename T> inline void allocate_cons(agent* thisAgent, T* dest_cons_pointer);
@@ -83,6 +84,7 @@ void add_rete_test_list_to_tests(agent* thisAgent, condition* cond, rete_test* r
 void add_gensymmed_equality_test(agent* thisAgent, test* t, char first_letter);
 void add_all_variables_in_test(agent* thisAgent, test t, tc_number tc, cons** var_list);
 void add_bound_variables_in_test(agent* thisAgent, test t, tc_number tc, cons** var_list);
+void add_bound_variables_in_test(agent* thisAgent, test t, tc_number tc, var_vector* var_list);
 void add_bound_variable_with_identity(agent* thisAgent, Symbol* pSym, Symbol* pMatchedSym, uint64_t pInstIdentity, tc_number tc, matched_symbol_list* var_list);
 void copy_non_identical_tests(agent* thisAgent, test* t, test add_me, bool considerIdentity = false);
 
@@ -108,29 +108,39 @@ wme* make_wme(agent* thisAgent, Symbol* id, Symbol* attr, Symbol* value, bool ac
     w->timetag = thisAgent->current_wme_timetag++;
     w->reference_count = 0;
     w->preference = NIL;
-    w->output_link = NIL;
     w->tc = 0;
-    w->chunker_bt_last_ground_cond = NULL;
-    w->is_singleton = false;
-    w->singleton_status_checked = false;
-    w->local_singleton_id_identity_set = NULL_IDENTITY_SET;
-    w->local_singleton_value_identity_set = NULL_IDENTITY_SET;
+    w->cold = NIL;
     w->next = NIL;
     w->prev = NIL;
     w->rete_next = NIL;
     w->rete_prev = NIL;
 
-    w->gds = NIL;
-    w->gds_prev = NIL;
-    w->gds_next = NIL;
-
-    w->wma_decay_el = NIL;
-    w->wma_tc_value = 0;
+    return w;
+}
 
-    w->epmem_id = EPMEM_NODEID_BAD;
-    w->epmem_valid = NIL;
+const wme_cold default_wme_cold =
+{
+    NIL,                    /* output_link */
+    NIL,                    /* chunker_bt_last_ground_cond */
+    false,                  /* is_singleton */
+    false,                  /* singleton_status_checked */
+    NULL_IDENTITY_SET,      /* local_singleton_id_identity_set */
+    NULL_IDENTITY_SET,      /* local_singleton_value_identity_set */
+    NIL, NIL, NIL,          /* gds, gds_next, gds_prev */
+    EPMEM_NODEID_BAD,       /* epmem_id */
+    0,                      /* epmem_valid */
+    NIL,                    /* wma_decay_el */
+    0                       /* wma_tc_value */
+};
 
-    return w;
+wme_cold* writable_wme_cold_fields(agent* thisAgent, wme* w)
+{
+    if (!w->cold)
+    {
+        thisAgent->memoryManager->allocate_with_pool(MP_wme_cold, &(w->cold));
+        *(w->cold) = default_wme_cold;
+    }
+    return w->cold;
 }
 
 /* --- lists of buffered WM changes --- */
@@ -165,15 +175,9 @@ void remove_wme_from_wm(agent* thisAgent, wme* w)
     /* When we remove a WME, we always have to determine if it's on a GDS, and, if
     so, after removing the WME, if there are no longer any WMEs on the GDS,
     then we can free the GDS memory */
-    if (w->gds)
+    if (wme_cold_fields(w)->gds)
     {
-        fast_remove_from_dll(w->gds->wmes_in_gds, w, wme, gds_next, gds_prev);
-
-        if (!w->gds->wmes_in_gds)
-        {
-            if (w->gds->goal) w->gds->goal->id->gds = NIL;
-            thisAgent->memoryManager->free_with_pool(MP_gds, w->gds);
-        }
+        remove_wme_from_gds(thisAgent, w);
     }
 }
 
@@ -187,6 +191,7 @@ void remove_wme_list_from_wm(agent* thisAgent, wme* w, bool updateWmeMap)
 
         if (updateWmeMap)
         {
+            thisAgent->input_wmes_by_timetag->erase(w->timetag);
             soar_invoke_callbacks(thisAgent, INPUT_WME_GARBAGE_COLLECTED_CALLBACK, static_cast< soar_call_data >(w));
         }
         remove_wme_from_wm(thisAgent, w);
@@ -245,8 +250,8 @@ void do_buffered_wm_changes(agent* thisAgent)
             }
         }
         #endif
-        add_wme_to_rete(thisAgent, static_cast<wme_struct*>(c->first));
     }
+    add_wmes_to_rete(thisAgent, thisAgent->wmes_to_add);
     for (c = thisAgent->wmes_to_remove; c != NIL; c = c->rest)
     {
         w = (wme_struct*)(c->first);
@@ -340,10 +345,14 @@ void deallocate_wme(agent* thisAgent, wme* w)
 {
     if (wma_enabled(thisAgent)) wma_remove_decay_element(thisAgent, w);
 
-    if (w->local_singleton_value_identity_set)
+    if (w->cold)
     {
-        IdentitySet_remove_ref(thisAgent, w->local_singleton_id_identity_set);
-        IdentitySet_remove_ref(thisAgent, w->local_singleton_value_identity_set);
+        if (w->cold->local_singleton_value_identity_set)
+        {
+            IdentitySet_remove_ref(thisAgent, w->cold->local_singleton_id_identity_set);
+            IdentitySet_remove_ref(thisAgent, w->cold->local_singleton_value_identity_set);
+        }
+        thisAgent->memoryManager->free_with_pool(MP_wme_cold, w->cold);
     }
     thisAgent->symbolManager->symbol_remove_ref(&w->id);
     thisAgent->symbolManager->symbol_remove_ref(&w->attr);
@@ -80,13 +80,43 @@ class WM_Manager
 
 };
 
+/* ------------------------------------------------------------------------
+   The fields of a wme that matching and the decision cycle never touch:
+   the output link record, chunker backtracing marks, GDS links and the
+   epmem and WMA bookkeeping.  Most wmes never have any of them set, so
+   they live in a side record allocated the first time one is, keeping
+   the wme itself to the fields the rete and the slots use.
+
+   Read them with wme_cold_fields(), which returns the defaults for a wme
+   without a record, and write them with writable_wme_cold_fields().
+------------------------------------------------------------------------ */
+
+typedef struct wme_cold_struct
+{
+    struct output_link_struct*  output_link;            /* for top-state output commands */
+
+    struct condition_struct*    chunker_bt_last_ground_cond;
+    bool                        is_singleton;
+    bool                        singleton_status_checked;
+    Identity*                   local_singleton_id_identity_set;
+    Identity*                   local_singleton_value_identity_set;
+
+    struct gds_struct*          gds;
+    struct wme_struct*          gds_next, *gds_prev;   /* wmes in gds */
+
+    epmem_node_id               epmem_id;
+    uint64_t                    epmem_valid;
+
+    wma_decay_element*          wma_decay_el;
+    tc_number                   wma_tc_value;
+} wme_cold;
+
 typedef struct wme_struct
 {
     /* WARNING:  The next three fields (id,attr,value) MUST be consecutive.  The rete code relies on this! */
     Symbol*                     id;
     Symbol*                     attr;
     Symbol*                     value;
-    bool                        acceptable;
     uint64_t                    timetag;
     uint64_t                    reference_count;
 
@@ -96,24 +126,19 @@ typedef struct wme_struct
     struct wme_struct           *next, *prev;
 
     struct preference_struct*   preference;             /* pref. supporting it, or NIL */
-    struct output_link_struct*  output_link;            /* for top-state output commands */
-
     tc_number                   tc;
-    struct condition_struct*    chunker_bt_last_ground_cond;
-    bool                        is_singleton;
-    bool                        singleton_status_checked;
-    Identity*                   local_singleton_id_identity_set;
-    Identity*                   local_singleton_value_identity_set;
+    wme_cold*                   cold;                   /* NIL until a cold field is set */
+    bool                        acceptable;
+} wme;
 
-    struct gds_struct*          gds;
-    struct wme_struct*          gds_next, *gds_prev;   /* wmes in gds */
+extern const wme_cold default_wme_cold;
 
-    epmem_node_id               epmem_id;
-    uint64_t                    epmem_valid;
+inline const wme_cold* wme_cold_fields(wme* w)
+{
+    return w->cold ? w->cold : &default_wme_cold;
+}
 
-    wma_decay_element*          wma_decay_el;
-    tc_number                   wma_tc_value;
-} wme;
+wme_cold* writable_wme_cold_fields(agent* thisAgent, wme* w);
 
 inline void wme_add_ref(wme* w, bool always_add = false)
 {
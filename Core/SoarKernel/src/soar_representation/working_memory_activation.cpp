@@ -429,14 +429,14 @@ inline wma_reference wma_calculate_initial_boost(agent* thisAgent, wme* w)
         {
             for (cond = pref->inst->top_of_instantiated_conditions; cond != NIL; cond = cond->next)
             {
-                if ((cond->type == POSITIVE_CONDITION) && (cond->bt.wme_->wma_tc_value != tc))
+                if ((cond->type == POSITIVE_CONDITION) && (wme_cold_fields(cond->bt.wme_)->wma_tc_value != tc))
                 {
                     cond_wme = cond->bt.wme_;
-                    cond_wme->wma_tc_value = tc;
+                    writable_wme_cold_fields(thisAgent, cond_wme)->wma_tc_value = tc;
 
-                    if (cond_wme->wma_decay_el)
+                    if (wme_cold_fields(cond_wme)->wma_decay_el)
                     {
-                        if (!cond_wme->wma_decay_el->just_created)
+                        if (!wme_cold_fields(cond_wme)->wma_decay_el->just_created)
                         {
                             num_cond_wmes++;
                             combined_time_sum += wma_get_wme_activation(thisAgent, cond_wme, false);
@@ -448,12 +448,12 @@ inline wma_reference wma_calculate_initial_boost(agent* thisAgent, wme* w)
                         {
                             for (wme_p = cond_wme->preference->wma_o_set->begin(); wme_p != cond_wme->preference->wma_o_set->end(); wme_p++)
                             {
-                                if (((*wme_p)->wma_tc_value != tc) && (!(*wme_p)->wma_decay_el || !(*wme_p)->wma_decay_el->just_created))
+                                if ((wme_cold_fields(*wme_p)->wma_tc_value != tc) && (!wme_cold_fields(*wme_p)->wma_decay_el || !wme_cold_fields(*wme_p)->wma_decay_el->just_created))
                                 {
                                     num_cond_wmes++;
                                     combined_time_sum += wma_get_wme_activation(thisAgent, (*wme_p), false);
 
-                                    (*wme_p)->wma_tc_value = tc;
+                                    writable_wme_cold_fields(thisAgent, *wme_p)->wma_tc_value = tc;
                                 }
                             }
                         }
@@ -481,7 +481,7 @@ void wma_activate_wme(agent* thisAgent, wme* w, wma_reference num_references, wm
     // o-supported, non-architectural WME
     if (wma_should_have_decay_element(w))
     {
-        wma_decay_element* temp_el = w->wma_decay_el;
+        wma_decay_element* temp_el = wme_cold_fields(w)->wma_decay_el;
 
         // if decay structure doesn't exist, create it
         if (!temp_el)
@@ -510,7 +510,7 @@ void wma_activate_wme(agent* thisAgent, wme* w, wma_reference num_references, wm
             // prevents confusion with delayed forgetting
             temp_el->forget_cycle = static_cast< wma_d_cycle >(-1);
 
-            w->wma_decay_el = temp_el;
+            writable_wme_cold_fields(thisAgent, w)->wma_decay_el = temp_el;
             if (w->id->symbol_type == IDENTIFIER_SYMBOL_TYPE && w->id->id->LTI_ID)
             {
                 thisAgent->SMem->smem_wmas->emplace(w->id->id->LTI_ID,temp_el);
@@ -663,9 +663,9 @@ void wma_activate_wme(agent* thisAgent, wme* w, wma_reference num_references, wm
             // the wme preference)
             else
             {
-                if ((*wme_p)->wma_decay_el)
+                if (wme_cold_fields(*wme_p)->wma_decay_el)
                 {
-                    (*wme_p)->wma_decay_el->num_references += num_references;
+                    wme_cold_fields(*wme_p)->wma_decay_el->num_references += num_references;
                     thisAgent->WM->wma_touched_elements->insert((*wme_p));
                 }
             }
@@ -685,7 +685,7 @@ void wma_activate_wme(agent* thisAgent, wme* w, wma_reference num_references, wm
 inline void wma_forgetting_remove_from_p_queue(agent* thisAgent, wma_decay_element* decay_el);
 void wma_deactivate_element(agent* thisAgent, wme* w)
 {
-    wma_decay_element* temp_el = w->wma_decay_el;
+    wma_decay_element* temp_el = wme_cold_fields(w)->wma_decay_el;
 
     if (temp_el)
     {
@@ -705,7 +705,7 @@ void wma_deactivate_element(agent* thisAgent, wme* w)
                 auto wmas = thisAgent->SMem->smem_wmas->equal_range(w->id->id->LTI_ID);
                 for (auto wma = wmas.first; wma != wmas.second; ++wma)
                 {
-                    if (wma->second == w->wma_decay_el)
+                    if (wma->second == wme_cold_fields(w)->wma_decay_el)
                     {
                         thisAgent->SMem->smem_wmas->erase(wma);
                         break;
@@ -719,7 +719,7 @@ void wma_deactivate_element(agent* thisAgent, wme* w)
 
 void wma_remove_decay_element(agent* thisAgent, wme* w)
 {
-    wma_decay_element* temp_el = w->wma_decay_el;
+    wma_decay_element* temp_el = wme_cold_fields(w)->wma_decay_el;
 
     if (temp_el)
     {
@@ -751,7 +751,7 @@ void wma_remove_decay_element(agent* thisAgent, wme* w)
         }
 
         thisAgent->memoryManager->free_with_pool(MP_wma_decay_element, temp_el);
-        w->wma_decay_el = NULL;
+        writable_wme_cold_fields(thisAgent, w)->wma_decay_el = NULL;
     }
 }
 
@@ -1008,7 +1008,7 @@ inline bool wma_forgetting_update_p_queue(agent* thisAgent)
                             {
                                 for (w = s->wmes; (w && do_forget); w = w->next)
                                 {
-                                    if (w->preference->o_supported && (!w->wma_decay_el || (w->wma_decay_el->forget_cycle != WMA_FORGOTTEN_CYCLE)))
+                                    if (w->preference->o_supported && (!wme_cold_fields(w)->wma_decay_el || (wme_cold_fields(w)->wma_decay_el->forget_cycle != WMA_FORGOTTEN_CYCLE)))
                                     {
                                         do_forget = false;
                                     }
@@ -1081,15 +1081,17 @@ inline bool wma_forgetting_naive_sweep(agent* thisAgent)
 
     for (wme* w = thisAgent->all_wmes_in_rete; w; w = w->rete_next)
     {
-        if (w->wma_decay_el && (!forget_only_lti || (w->id->id->LTI_ID != NIL)))
+        wma_decay_element* decay_el = wme_cold_fields(w)->wma_decay_el;
+
+        if (decay_el && (!forget_only_lti || (w->id->id->LTI_ID != NIL)))
         {
             // to be forgotten, wme must...
             // - have been accessed (can't imagine why not, but just in case)
             // - not have been accessed this cycle (i.e. no decay)
             // - have activation less than threshold
-            if ((w->wma_decay_el->touches.total_references > 0) &&
-                    (w->wma_decay_el->touches.access_history[ wma_history_prev(w->wma_decay_el->touches.next_p) ].d_cycle < current_cycle) &&
-                    (wma_calculate_decay_activation(thisAgent, w->wma_decay_el, current_cycle, false) < decay_thresh))
+            if ((decay_el->touches.total_references > 0) &&
+                    (decay_el->touches.access_history[ wma_history_prev(decay_el->touches.next_p) ].d_cycle < current_cycle) &&
+                    (wma_calculate_decay_activation(thisAgent, decay_el, current_cycle, false) < decay_thresh))
             {
                 if (wma_forgetting_forget_wme(thisAgent, w))
                 {
@@ -1182,7 +1184,7 @@ inline void wma_update_decay_histories(agent* thisAgent)
     // add to history for changed elements
     for (wme_p = thisAgent->WM->wma_touched_elements->begin(); wme_p != thisAgent->WM->wma_touched_elements->end(); wme_p++)
     {
-        temp_el = (*wme_p)->wma_decay_el;
+        temp_el = wme_cold_fields(*wme_p)->wma_decay_el;
 
         // update number of references in the current history
         // (has to come before history overwrite)
@@ -1266,9 +1268,9 @@ double wma_get_wme_activation(agent* thisAgent, wme* w, bool log_result)
 {
     double return_val = static_cast<double>((log_result) ? (WMA_ACTIVATION_NONE) : (WMA_TIME_SUM_NONE));
 
-    if (w->wma_decay_el)
+    if (wme_cold_fields(w)->wma_decay_el)
     {
-        return_val = wma_calculate_decay_activation(thisAgent, w->wma_decay_el, thisAgent->WM->wma_d_cycle_count, log_result);
+        return_val = wma_calculate_decay_activation(thisAgent, wme_cold_fields(w)->wma_decay_el, thisAgent->WM->wma_d_cycle_count, log_result);
     }
 
     return return_val;
@@ -1297,9 +1299,9 @@ inline void _wma_ref_to_str(wma_cycle_reference& ref, wma_d_cycle current_cycle,
 
 void wma_get_wme_history(agent* thisAgent, wme* w, std::string& buffer)
 {
-    if (w->wma_decay_el)
+    if (wme_cold_fields(w)->wma_decay_el)
     {
-        wma_history* history = &(w->wma_decay_el->touches);
+        wma_history* history = &(wme_cold_fields(w)->wma_decay_el->touches);
         unsigned int p = history->next_p;
         unsigned int counter = history->history_ct;
         wma_d_cycle current_cycle = thisAgent->WM->wma_d_cycle_count;
@@ -1348,7 +1350,7 @@ void wma_get_wme_history(agent* thisAgent, wme* w, std::string& buffer)
             buffer.append("considering WME for decay @ d");
 
             std::string temp;
-            to_string(w->wma_decay_el->forget_cycle, temp);
+            to_string(wme_cold_fields(w)->wma_decay_el->forget_cycle, temp);
             buffer.append(temp);
         }
     }
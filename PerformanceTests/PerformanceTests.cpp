@@ -4,6 +4,8 @@
 #include "sml_Client.h"
 #include "sml_Connection.h"
 
+#include <chrono>
+
 using namespace std;
 using namespace sml;
 
@@ -67,6 +69,66 @@ void Run_PerformanceTest(int numTrials, int numDecisions, StatsTracker* pSt, con
     cout.flush();
 }
 
+/* Not an agent file: the client keeps a wide, flat input-link and updates
+   every wme on it each decision, the way a sensor-heavy environment does.
+   This is what stresses the kernel's input wme bookkeeping. */
+#define WIDE_INPUT_LINK_TEST "wide-input-link"
+#define WIDE_INPUT_LINK_WMES 10000
+#define WIDE_INPUT_LINK_DCS 20
+
+void Run_WideInputLinkTest(int numTrials, int numDecisions, StatsTracker* pSt)
+{
+    for (int i = 0; i < numTrials; i++)
+    {
+        Kernel* kernel = Kernel::CreateKernelInNewThread();
+        Agent* agent = kernel->CreateAgent("Soar1");
+        cout << (i+1) << " ";
+        cout.flush();
+
+        agent->SetOutputLinkChangeTracking(false);
+        agent->ExecuteCommandLine("pushd SoarPerformanceTests");
+        agent->ExecuteCommandLine("source wait.soar");
+        agent->ExecuteCommandLine("output enable off");
+
+        Identifier* pInputLink = agent->GetInputLink();
+        vector<IntElement*> sensors;
+        for (int j = 0; j < WIDE_INPUT_LINK_WMES; ++j)
+        {
+            sensors.push_back(agent->CreateIntWME(pInputLink, "sensor", j));
+        }
+        agent->RunSelf(1);
+
+        ClientAnalyzedXML response;
+        agent->ExecuteCommandLineXML("stats", &response);
+        double startKernel = response.GetArgFloat(sml_Names::kParamStatsKernelCPUTime, 0.0);
+        double startTotal = response.GetArgFloat(sml_Names::kParamStatsTotalCPUTime, 0.0);
+        chrono::steady_clock::time_point startReal = chrono::steady_clock::now();
+
+        for (int dc = 1; dc <= numDecisions; ++dc)
+        {
+            for (int j = 0; j < WIDE_INPUT_LINK_WMES; ++j)
+            {
+                agent->Update(sensors[j], static_cast<long long>(j + dc));
+            }
+            agent->RunSelf(1);
+        }
+
+        pSt->realtimes.push_back(chrono::duration<double>(chrono::steady_clock::now() - startReal).count());
+        agent->ExecuteCommandLineXML("stats", &response);
+        pSt->kerneltimes.push_back(response.GetArgFloat(sml_Names::kParamStatsKernelCPUTime, 0.0) - startKernel);
+        pSt->totaltimes.push_back(response.GetArgFloat(sml_Names::kParamStatsTotalCPUTime, 0.0) - startTotal);
+
+        kernel->Shutdown();
+        delete kernel;
+
+        cout << "✅  ";
+        cout.flush();
+    }
+
+    cout << endl;
+    cout.flush();
+}
+
 int main(int argc, char* argv[])
 {
     set_working_directory_to_executable_path();
@@ -119,6 +181,15 @@ int main(int argc, char* argv[])
     if (numInits > 0) cout << ", " << numInits << " extra init-soar/runs\n"; else cout << endl;
     cout.flush();
 
+    if (!strcmp(agentname, WIDE_INPUT_LINK_TEST))
+    {
+        StatsTracker l_testStats;
+
+        Run_WideInputLinkTest(numTrials, (numDCs > 0) ? numDCs : WIDE_INPUT_LINK_DCS, &l_testStats);
+        l_testStats.PrintResults(agentname);
+        return 0;
+    }
+
     {
         StatsTracker l_testStats;
         vector<string> commands, init_commands;
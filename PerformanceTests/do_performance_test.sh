@@ -10,7 +10,7 @@ do
       s)  lTestSuite="$OPTARG";;
       \?)		# unknown flag
       	  echo >&2 \
-	  "usage: $0 [-v [9.4 | 9.6]] [-s [full | fast]] "
+	  "usage: $0 [-v [9.4 | 9.6]] [-s [full | fast | tokens | input]] "
 	  exit 1;;
     esac
 done
@@ -87,6 +87,16 @@ elif [ $lTestSuite == "fast" ] ; then
     nice -n -10 ./PerformanceTests water-jug-lookahead94 3 10000
     nice -n -10 ./PerformanceTests water-jug-lookahead94_learning 2 102 100
   fi
+elif [ $lTestSuite == "tokens" ] ; then
+  # Token-heavy agents, for comparing the rete's token storage.  Run once in
+  # a default build and once in a build made with
+  # --cflags=-DRETE_TOKEN_BLOCKS (see kernel.h).
+  nice -n -10 ./PerformanceTests FactorizationStressTest 5
+  nice -n -10 ./PerformanceTests FactorizationStressTest_learning 5
+elif [ $lTestSuite == "input" ] ; then
+  # A client updating a 10,000 wme input-link every decision (see
+  # Run_WideInputLinkTest in PerformanceTests.cpp).
+  nice -n -10 ./PerformanceTests wide-input-link 3
 fi
 
 if [ $lUnitTests != off ] ; then
@@ -1061,6 +1061,93 @@ void FullTests_Parent::test64BitReteNet()
     SoarHelper::init_check_to_find_refcount_leaks(agent);
 }
 
+void FullTests_Parent::testReteNetSaveLoad()
+{
+    std::string savedNet("test-save.soarx");
+
+    agent->ExecuteCommandLine(("rete-net -l \"" + SoarHelper::GetResource("test64.soarx") + "\"").c_str());
+    no_agent_assertTrue(agent->GetLastCommandLineResult());
+    std::string before = agent->ExecuteCommandLine("print --all --full");
+
+    // Saving always writes the current (sectioned, checksummed) format
+    agent->ExecuteCommandLine(("rete-net -s " + savedNet).c_str());
+    no_agent_assertTrue(agent->GetLastCommandLineResult());
+    agent->ExecuteCommandLine(("rete-net -l " + savedNet).c_str());
+    no_agent_assertTrue(agent->GetLastCommandLineResult());
+    std::string after = agent->ExecuteCommandLine("print --all --full");
+    no_agent_assertTrue(before == after);
+
+    // A damaged file must be rejected without clearing the agent's rules
+    FILE* f = fopen(savedNet.c_str(), "r+b");
+    no_agent_assertTrue(f != NULL);
+    fseek(f, -8, SEEK_END);
+    int c = fgetc(f);
+    fseek(f, -8, SEEK_END);
+    fputc(c ^ 0xff, f);
+    fclose(f);
+    agent->ExecuteCommandLine(("rete-net -l " + savedNet).c_str());
+    no_agent_assertTrue(!agent->GetLastCommandLineResult());
+    no_agent_assertTrue(agent->ExecuteCommandLine("print --all --full") == after);
+
+    remove(savedNet.c_str());
+    SoarHelper::init_check_to_find_refcount_leaks(agent);
+}
+
+void FullTests_Parent::testReteProfile()
+{
+    loadProductions(SoarHelper::GetResource("testLearn.soar"));
+
+    // There is nothing to report until profiling is turned on
+    agent->ExecuteCommandLine("production matches --profile");
+    no_agent_assertTrue(!agent->GetLastCommandLineResult());
+
+    // Learning adds chunks, whose p-nodes don't keep variable names
+    agent->ExecuteCommandLine("chunk always");
+    agent->ExecuteCommandLine("production matches --profile on");
+    no_agent_assertTrue(agent->GetLastCommandLineResult());
+    m_pKernel->RunAllAgentsForever();
+    std::string report = agent->ExecuteCommandLine("production matches --profile 10");
+    no_agent_assertTrue(agent->GetLastCommandLineResult());
+    no_agent_assertTrue(report.find("propose*foo") != std::string::npos);
+
+    // Excising rules while profiling drops their nodes from the profile
+    agent->ExecuteCommandLine("production excise --all");
+    agent->ExecuteCommandLine("production matches --profile reset");
+    no_agent_assertTrue(agent->GetLastCommandLineResult());
+    agent->ExecuteCommandLine("production matches --profile off");
+    no_agent_assertTrue(agent->GetLastCommandLineResult());
+    agent->ExecuteCommandLine("production matches --profile");
+    no_agent_assertTrue(!agent->GetLastCommandLineResult());
+
+    SoarHelper::init_check_to_find_refcount_leaks(agent);
+}
+
+void FullTests_Parent::testSharedReteNet()
+{
+    agent->ExecuteCommandLine(("rete-net -l \"" + SoarHelper::GetResource("test64.soarx") + "\"").c_str());
+    no_agent_assertTrue(agent->GetLastCommandLineResult());
+    std::string rules = agent->ExecuteCommandLine("print --all --full");
+
+    agent->ExecuteCommandLine("save rete-network --share fleet");
+    no_agent_assertTrue(agent->GetLastCommandLineResult());
+
+    sml::Agent* member = m_pKernel->CreateAgent("fleet-member");
+    no_agent_assertTrue(member != NULL);
+    member->ExecuteCommandLine("load rete-network --attach fleet");
+    no_agent_assertTrue(member->GetLastCommandLineResult());
+    no_agent_assertTrue(member->ExecuteCommandLine("print --all --full") == rules);
+
+    // Once unshared, the name is gone but attached agents keep their rules
+    agent->ExecuteCommandLine("save rete-network --unshare fleet");
+    no_agent_assertTrue(agent->GetLastCommandLineResult());
+    member->ExecuteCommandLine("load rete-network --attach fleet");
+    no_agent_assertTrue(!member->GetLastCommandLineResult());
+    no_agent_assertTrue(member->ExecuteCommandLine("print --all --full") == rules);
+
+    no_agent_assertTrue(m_pKernel->DestroyAgent(member));
+    SoarHelper::init_check_to_find_refcount_leaks(agent);
+}
+
 void FullTests_Parent::testOSupportCopyDestroy()
 {
     loadProductions(SoarHelper::GetResource("testOSupportCopyDestroy.soar"));
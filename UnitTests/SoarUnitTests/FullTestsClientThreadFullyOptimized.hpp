@@ -41,6 +41,13 @@ public:
 	TEST(test64BitReteNet, -1);
 	void test64BitReteNet() { this->FullTests_Parent::test64BitReteNet(); }
 	
+	TEST(testReteNetSaveLoad, -1);
+	void testReteNetSaveLoad() { this->FullTests_Parent::testReteNetSaveLoad(); }
+	TEST(testSharedReteNet, -1);
+	void testSharedReteNet() { this->FullTests_Parent::testSharedReteNet(); }
+	TEST(testReteProfile, -1);
+	void testReteProfile() { this->FullTests_Parent::testReteProfile(); }
+	
 	TEST(testOSupportCopyDestroy, -1);
 	void testOSupportCopyDestroy() { this->FullTests_Parent::testOSupportCopyDestroy(); }
 	
@@ -12,12 +12,21 @@
 #include "Export.h"
 
 #include "soar_rand.h"
+#include "symbol_manager.h"
+#include "small_vector.h"
+#include "agent.h"
+#include "io_link.h"
+#include "working_memory.h"
 #include "sml_Utils.h"
+#include "sml_AgentSML.h"
 #include "sml_Client.h"
 #include "sml_Names.h"
 
+#include <chrono>
 #include <string>
 #include <iostream>
+#include <thread>
+#include <vector>
 
 #include "SoarHelper.hpp"
 #include "handlers.hpp"
@@ -342,6 +351,304 @@ void MiscTests::testSoarRand()
 	assertTrue(off < 0.001);
 }
 
+/* Makes and finds millions of symbols of the kinds that used to hash
+   badly (floats in [0,1), ints differing only in their high bits, short
+   strings) and prints how long each pass took. */
+void MiscTests::testSymbolTableStress()
+{
+	Symbol_Manager* symbols = internal_agent->symbolManager;
+	const int count = 1000000;
+	std::vector<Symbol*> made;
+	char name[32];
+
+	made.reserve(count * 3);
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	for (int i = 0; i < count; ++i)
+	{
+		made.push_back(symbols->make_float_constant(static_cast<double>(i) / count));
+		made.push_back(symbols->make_int_constant(static_cast<int64_t>(i) << 32));
+		snprintf(name, sizeof(name), "s%d", i);
+		made.push_back(symbols->make_str_constant(name));
+	}
+	std::chrono::steady_clock::time_point made_all = std::chrono::steady_clock::now();
+	for (int i = 0; i < count; ++i)
+	{
+		assertTrue(symbols->find_float_constant(static_cast<double>(i) / count) == made[i * 3]);
+		assertTrue(symbols->find_int_constant(static_cast<int64_t>(i) << 32) == made[i * 3 + 1]);
+		snprintf(name, sizeof(name), "s%d", i);
+		assertTrue(symbols->find_str_constant(name) == made[i * 3 + 2]);
+	}
+	std::chrono::steady_clock::time_point found_all = std::chrono::steady_clock::now();
+	assertTrue(symbols->find_float_constant(-0.0) == symbols->find_float_constant(0.0));
+	for (size_t i = 0; i < made.size(); ++i)
+	{
+		symbols->symbol_remove_ref(&made[i]);
+	}
+	std::chrono::steady_clock::time_point freed_all = std::chrono::steady_clock::now();
+
+	std::cout << " make " << std::chrono::duration_cast<std::chrono::milliseconds>(made_all - start).count()
+			  << " ms, find " << std::chrono::duration_cast<std::chrono::milliseconds>(found_all - made_all).count()
+			  << " ms, free " << std::chrono::duration_cast<std::chrono::milliseconds>(freed_all - found_all).count()
+			  << " ms for " << (count * 3) << " symbols ";
+}
+
+/* --- churns an agent's own pool and the calling thread's dynamic pools,
+   checking that no item is handed out twice --- */
+static bool churn_memory_pools(::agent* thisAgent)
+{
+	const int count = 1000;
+	std::vector<cons*> cells(count);
+	bool ok = true;
+
+	for (int round = 0; round < 200; ++round)
+	{
+		symbol_list symbols;
+		for (int i = 0; i < count; ++i)
+		{
+			allocate_cons(thisAgent, &cells[i]);
+			cells[i]->first = &cells[i];
+			symbols.push_back(reinterpret_cast<Symbol*>(&cells[i]));
+		}
+		int i = 0;
+		for (symbol_list::iterator it = symbols.begin(); it != symbols.end(); ++it, ++i)
+		{
+			ok = ok && (cells[i]->first == &cells[i]) && (*it == reinterpret_cast<Symbol*>(&cells[i]));
+			free_cons(thisAgent, cells[i]);
+		}
+	}
+	return ok;
+}
+
+void MiscTests::testPerAgentMemoryPools()
+{
+	sml::Agent* agent2 = kernel->CreateAgent("soar2");
+	assertTrue(agent2 != NULL);
+	::agent* internal_agent2 = internal_kernel->GetAgentSML("soar2")->GetSoarAgent();
+	assertTrue(internal_agent->memoryManager != internal_agent2->memoryManager);
+
+	bool ok1 = false, ok2 = false;
+	std::thread thread1([&]() { ok1 = churn_memory_pools(internal_agent); });
+	std::thread thread2([&]() { ok2 = churn_memory_pools(internal_agent2); });
+	thread1.join();
+	thread2.join();
+	assertTrue(ok1 && ok2);
+
+	std::string result = agent->ExecuteCommandLine("stats --memory --process");
+	assertTrue(agent->GetLastCommandLineResult());
+	assertTrue(result.find("all agents") != std::string::npos);
+
+	kernel->DestroyAgent(agent2);
+}
+
+void MiscTests::testMemoryPoolTrimAndLimit()
+{
+	Memory_Manager* memory = internal_agent->memoryManager;
+	const int count = 100000;
+	std::vector<cons*> cells(count);
+
+	/* --- a spike of cons cells, of which every 10000th stays in use --- */
+	size_t before = memory->get_total_memory();
+	for (int i = 0; i < count; ++i)
+	{
+		allocate_cons(internal_agent, &cells[i]);
+		cells[i]->first = &cells[i];
+	}
+	assertTrue(memory->get_total_memory() > before);
+	for (int i = 0; i < count; ++i)
+	{
+		if (i % 10000)
+		{
+			free_cons(internal_agent, cells[i]);
+		}
+	}
+	size_t released = memory->trim_memory_pools();
+	assertTrue(released > 0);
+	assertTrue(memory->get_total_memory() <= before + (count / 10000) * 0x8000);
+	for (int i = 0; i < count; i += 10000)
+	{
+		assertTrue(cells[i]->first == &cells[i]);
+		free_cons(internal_agent, cells[i]);
+	}
+	for (int i = 0; i < count; ++i)
+	{
+		allocate_cons(internal_agent, &cells[i]);
+	}
+	for (int i = 0; i < count; ++i)
+	{
+		free_cons(internal_agent, cells[i]);
+	}
+
+	/* --- a pool growing past the limit halts the agent --- */
+	agent->ExecuteCommandLine("soar max-memory-usage 1");
+	assertTrue(agent->GetLastCommandLineResult());
+	agent->ExecuteCommandLine("debug allocate token 1");
+	assertTrue(agent->GetLastCommandLineResult());
+	agent->RunSelf(5);
+	assertTrue(internal_agent->system_halted);
+
+	agent->ExecuteCommandLine("soar max-memory-usage 0");
+	assertTrue(agent->GetLastCommandLineResult());
+	agent->ExecuteCommandLine("soar init");
+	agent->RunSelf(5);
+	assertTrue(!internal_agent->system_halted);
+}
+
+void MiscTests::testHugePagePools()
+{
+	Memory_Manager* memory = internal_agent->memoryManager;
+	const int count = 100000;
+	std::vector<cons*> cells(count);
+	size_t arena_bytes, huge_page_bytes;
+
+	agent->ExecuteCommandLine("soar huge-pages transparent");
+	assertTrue(agent->GetLastCommandLineResult());
+	for (int i = 0; i < count; ++i)
+	{
+		allocate_cons(internal_agent, &cells[i]);
+		cells[i]->first = &cells[i];
+	}
+	memory->get_huge_page_coverage(arena_bytes, huge_page_bytes);
+#ifndef _WIN32
+	assertTrue(arena_bytes > 0);
+#endif
+	std::string stats = agent->ExecuteCommandLine("stats --memory");
+	assertTrue(stats.find("huge-page regions") != std::string::npos);
+
+	/* --- trimmed blocks go back to the arena and are reused from there --- */
+	for (int i = 0; i < count; ++i)
+	{
+		assertTrue(cells[i]->first == &cells[i]);
+		free_cons(internal_agent, cells[i]);
+	}
+	memory->trim_memory_pools();
+	size_t trimmed_arena_bytes;
+	memory->get_huge_page_coverage(trimmed_arena_bytes, huge_page_bytes);
+	assertTrue(trimmed_arena_bytes <= arena_bytes);
+	for (int i = 0; i < count; ++i)
+	{
+		allocate_cons(internal_agent, &cells[i]);
+	}
+	for (int i = 0; i < count; ++i)
+	{
+		free_cons(internal_agent, cells[i]);
+	}
+
+	agent->ExecuteCommandLine("soar huge-pages off");
+	assertTrue(agent->GetLastCommandLineResult());
+	agent->RunSelf(5);
+	assertTrue(!internal_agent->system_halted);
+}
+
+void MiscTests::testSymbolHandles()
+{
+	Symbol_Manager* symbols = internal_agent->symbolManager;
+	Symbol* str = symbols->make_str_constant("handle-test");
+	Symbol* num = symbols->make_int_constant(123456789);
+	Symbol* id = symbols->make_new_identifier('H', 1);
+
+	assertTrue(symbol_handle_type(str->handle) == STR_CONSTANT_SYMBOL_TYPE);
+	assertTrue(symbol_handle_type(num->handle) == INT_CONSTANT_SYMBOL_TYPE);
+	assertTrue(symbol_handle_type(id->handle) == IDENTIFIER_SYMBOL_TYPE);
+	assertTrue(symbols->symbol_from_handle(str->handle) == str);
+	assertTrue(symbols->symbol_from_handle(num->handle) == num);
+	assertTrue(symbols->symbol_from_handle(id->handle) == id);
+
+	/* --- a freed handle is reused, with its side data cleared --- */
+	symbols->side_data(num).epmem_hash = 42;
+	uint32_t old_handle = num->handle;
+	symbols->symbol_remove_ref(&num);
+	Symbol* other = symbols->make_int_constant(987654321);
+	assertTrue(other->handle == old_handle);
+	assertTrue(symbols->side_data(other).epmem_hash == 0);
+
+	symbols->symbol_remove_ref(&other);
+	symbols->symbol_remove_ref(&str);
+	symbols->symbol_remove_ref(&id);
+}
+
+void MiscTests::testSmallVector()
+{
+	small_vector<int, 4> v;
+	for (int i = 0; i < 4; i++)
+	{
+		v.push_back(i);
+	}
+	int* inline_items = v.begin();
+
+	/* --- growing past the inline items spills to a pool block and keeps the contents --- */
+	for (int i = 4; i < 100; i++)
+	{
+		v.push_back(i);
+	}
+	assertTrue(v.begin() != inline_items);
+	assertTrue(v.size() == 100);
+	for (int i = 0; i < 100; i++)
+	{
+		assertTrue(v[i] == i);
+	}
+	assertTrue(v.contains(57));
+	assertTrue(!v.contains(100));
+
+	v.pop_back();
+	assertTrue(v.back() == 98);
+	v.clear();
+	assertTrue(v.empty());
+}
+
+static int count_ids_in_output_link_tc(::agent* thisAgent)
+{
+	int count = 0;
+	for (cons* c = thisAgent->existing_output_links->ids_in_tc; c != NIL; c = c->rest)
+	{
+		count++;
+	}
+	return count;
+}
+
+void MiscTests::testOutputLinkTC()
+{
+	agent->ExecuteCommandLine("sp {propose*add (state <s> ^superstate nil -^phase) --> (<s> ^operator <o> +) (<o> ^name add)}");
+	agent->ExecuteCommandLine("sp {apply*add (state <s> ^operator.name add) --> (<s> ^phase 1)}");
+	agent->ExecuteCommandLine("sp {propose*clear (state <s> ^phase 1) --> (<s> ^operator <o> +) (<o> ^name clear)}");
+	agent->ExecuteCommandLine("sp {apply*clear (state <s> ^operator.name clear) --> (<s> ^phase 1 -) (<s> ^phase 2)}");
+	agent->ExecuteCommandLine("sp {elaborate*cmd (state <s> ^phase 1 ^io.output-link <ol>) --> (<ol> ^cmd <c>) (<c> ^arg <a>) (<a> ^value 1)}");
+
+	assertTrue(internal_agent->existing_output_links != NIL);
+	assertTrue(count_ids_in_output_link_tc(internal_agent) == 1);
+
+	/* --- the command's ids join the TC as they are added... --- */
+	agent->ExecuteCommandLine("run 2");
+	assertTrue(count_ids_in_output_link_tc(internal_agent) == 3);
+
+	/* --- ...and leave it once they are unlinked --- */
+	agent->ExecuteCommandLine("run 1");
+	assertTrue(count_ids_in_output_link_tc(internal_agent) == 1);
+}
+
+void MiscTests::testInputWmeTimetagIndex()
+{
+	std::unordered_map< uint64_t, wme* >* index = internal_agent->input_wmes_by_timetag;
+	size_t initial_size = index->size();
+
+	sml::Identifier* block = agent->CreateIdWME(agent->GetInputLink(), "block");
+	agent->CreateIntWME(block, "size", 3);
+	agent->RunSelf(1);
+	assertTrue(index->size() == initial_size + 2);
+	for (std::unordered_map< uint64_t, wme* >::iterator it = index->begin(); it != index->end(); ++it)
+	{
+		assertTrue(find_input_wme_by_timetag(internal_agent, it->first) == it->second);
+		assertTrue(it->second->timetag == it->first);
+	}
+
+	/* --- the block's own wme is garbage collected rather than removed --- */
+	agent->DestroyWME(block);
+	agent->RunSelf(1);
+	assertTrue(index->size() == initial_size);
+
+	agent->ExecuteCommandLine("init-soar");
+	assertTrue(index->size() == initial_size);
+}
+
 void MiscTests::testPreferenceDeallocation()
 {
 	source("testPreferenceDeallocation.soar");
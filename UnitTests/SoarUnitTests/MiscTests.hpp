@@ -45,6 +45,22 @@ public:
 	
 	TEST(testSoarRand, -1)
 	void testSoarRand();
+	TEST(testSymbolTableStress, -1)
+	void testSymbolTableStress();
+	TEST(testPerAgentMemoryPools, -1)
+	void testPerAgentMemoryPools();
+	TEST(testMemoryPoolTrimAndLimit, -1)
+	void testMemoryPoolTrimAndLimit();
+	TEST(testHugePagePools, -1)
+	void testHugePagePools();
+	TEST(testSymbolHandles, -1)
+	void testSymbolHandles();
+	TEST(testSmallVector, -1)
+	void testSmallVector();
+	TEST(testOutputLinkTC, -1)
+	void testOutputLinkTC();
+	TEST(testInputWmeTimetagIndex, -1)
+	void testInputWmeTimetagIndex();
 	TEST(testPreferenceDeallocation, -1)
 	void testPreferenceDeallocation();
 	